@@ -0,0 +1,111 @@
+#include "alloc_counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef MIRAGE_BUILD_MSVC
+#include <malloc.h>
+#endif
+
+using namespace mirage::bench;
+
+namespace {
+
+std::atomic<size_t> g_alloc_cnt{0};
+
+void* CountedAlloc(const size_t size) {
+  g_alloc_cnt.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* CountedAlignedAlloc(const size_t size, const std::align_val_t align) {
+  g_alloc_cnt.fetch_add(1, std::memory_order_relaxed);
+  const auto alignment = static_cast<size_t>(align);
+#ifdef MIRAGE_BUILD_MSVC
+  void* ptr = _aligned_malloc(size == 0 ? 1 : size, alignment);
+#else
+  // aligned_alloc wants the size to be a multiple of the alignment.
+  const size_t rounded = (size + alignment - 1) / alignment * alignment;
+  void* ptr = std::aligned_alloc(alignment, rounded == 0 ? alignment : rounded);
+#endif
+  if (ptr) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void AlignedFree(void* ptr) {
+#ifdef MIRAGE_BUILD_MSVC
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+}  // namespace
+
+void* operator new(const size_t size) { return CountedAlloc(size); }
+
+void* operator new[](const size_t size) { return CountedAlloc(size); }
+
+void* operator new(const size_t size, const std::align_val_t align) {
+  return CountedAlignedAlloc(size, align);
+}
+
+void* operator new[](const size_t size, const std::align_val_t align) {
+  return CountedAlignedAlloc(size, align);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { AlignedFree(ptr); }
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+  AlignedFree(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+  AlignedFree(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept {
+  AlignedFree(ptr);
+}
+
+size_t mirage::bench::alloc_cnt() {
+  return g_alloc_cnt.load(std::memory_order_relaxed);
+}
+
+OpCounter::OpCounter(benchmark::State& state)
+    : state_(state), alloc_begin_(alloc_cnt()) {}
+
+void OpCounter::Pause() {
+  state_.PauseTiming();
+  pause_begin_ = alloc_cnt();
+}
+
+void OpCounter::Resume() {
+  paused_alloc_cnt_ += alloc_cnt() - pause_begin_;
+  state_.ResumeTiming();
+}
+
+void OpCounter::Report(const int64_t op_cnt) {
+  const auto total_op_cnt = state_.iterations() * op_cnt;
+  const auto timed_alloc_cnt = alloc_cnt() - alloc_begin_ - paused_alloc_cnt_;
+  state_.SetItemsProcessed(total_op_cnt);
+  state_.counters["allocs/op"] = static_cast<double>(timed_alloc_cnt) /
+                                 static_cast<double>(total_op_cnt);
+  state_.counters["time/op"] = benchmark::Counter(
+      static_cast<double>(total_op_cnt),
+      benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
@@ -0,0 +1,35 @@
+#ifndef MIRAGE_BENCHMARKS_ALLOC_COUNTER
+#define MIRAGE_BENCHMARKS_ALLOC_COUNTER
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mirage::bench {
+
+// Number of calls to the global operator new made by this process so far.
+size_t alloc_cnt();
+
+// Adds "allocs/op" and "time/op" counters to a benchmark doing `op_cnt`
+// operations per iteration. Construct it right before the timed loop and
+// pause through it, so that setup allocations are not reported.
+class OpCounter {
+ public:
+  explicit OpCounter(benchmark::State& state);
+
+  void Pause();
+  void Resume();
+
+  void Report(int64_t op_cnt);
+
+ private:
+  benchmark::State& state_;
+  size_t alloc_begin_;
+  size_t pause_begin_{0};
+  size_t paused_alloc_cnt_{0};
+};
+
+}  // namespace mirage::bench
+
+#endif  // MIRAGE_BENCHMARKS_ALLOC_COUNTER
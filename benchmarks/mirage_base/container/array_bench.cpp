@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "alloc_counter.hpp"
+#include "mirage_base/container/array.hpp"
+
+using namespace mirage;
+using namespace mirage::bench;
+
+namespace {
+
+struct BaseArray {
+  base::Array<size_t> array;
+
+  void Push(const size_t val) { array.Push(val); }
+  void RemoveHead() { array.Remove(0); }
+  [[nodiscard]] size_t Sum() const {
+    size_t sum = 0;
+    for (const auto val : array) {
+      sum += val;
+    }
+    return sum;
+  }
+};
+
+struct StdVector {
+  std::vector<size_t> array;
+
+  void Push(const size_t val) { array.push_back(val); }
+  void RemoveHead() { array.erase(array.begin()); }
+  [[nodiscard]] size_t Sum() const {
+    size_t sum = 0;
+    for (const auto val : array) {
+      sum += val;
+    }
+    return sum;
+  }
+};
+
+void Sizes(benchmark::internal::Benchmark* bench) {
+  bench->Arg(1 << 4)->Arg(1 << 10)->Arg(1 << 16);
+}
+
+template <typename Container>
+void BM_ArrayPush(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  OpCounter counter(state);
+  for (auto _ : state) {
+    Container container;
+    for (size_t i = 0; i < size; ++i) {
+      container.Push(i);
+    }
+    benchmark::DoNotOptimize(container.array.data());
+  }
+  counter.Report(state.range(0));
+}
+
+template <typename Container>
+void BM_ArrayIterate(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  Container container;
+  for (size_t i = 0; i < size; ++i) {
+    container.Push(i);
+  }
+
+  OpCounter counter(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(container.Sum());
+  }
+  counter.Report(state.range(0));
+}
+
+// Removing from the head shifts every remaining element.
+template <typename Container>
+void BM_ArrayRemoveHead(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  OpCounter counter(state);
+  for (auto _ : state) {
+    counter.Pause();
+    Container container;
+    for (size_t i = 0; i < size; ++i) {
+      container.Push(i);
+    }
+    counter.Resume();
+
+    for (size_t i = 0; i < size; ++i) {
+      container.RemoveHead();
+    }
+    benchmark::DoNotOptimize(container.array.data());
+  }
+  counter.Report(state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_ArrayPush, BaseArray)->Apply(Sizes);
+BENCHMARK_TEMPLATE(BM_ArrayPush, StdVector)->Apply(Sizes);
+BENCHMARK_TEMPLATE(BM_ArrayIterate, BaseArray)->Apply(Sizes);
+BENCHMARK_TEMPLATE(BM_ArrayIterate, StdVector)->Apply(Sizes);
+BENCHMARK_TEMPLATE(BM_ArrayRemoveHead, BaseArray)->Arg(1 << 4)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(BM_ArrayRemoveHead, StdVector)->Arg(1 << 4)->Arg(1 << 10);
@@ -0,0 +1,70 @@
+#ifndef MIRAGE_BENCHMARKS_HASH_KEYS
+#define MIRAGE_BENCHMARKS_HASH_KEYS
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+#include "mirage_base/util/hash.hpp"
+#include "mirage_base/util/type_id.hpp"
+
+namespace mirage::bench {
+
+// Hashes std containers with the same function as base ones, so that the
+// comparison measures the containers rather than the hashers.
+template <typename T>
+struct StdHash {
+  size_t operator()(const T& val) const { return base::Hash<T>()(val); }
+};
+
+template <typename Key>
+struct KeyTraits;
+
+// Keys are scattered with splitmix64. The ith miss key is the key of
+// `i + size`, which never collides with the first `size` hit keys.
+template <>
+struct KeyTraits<size_t> {
+  static void Sizes(benchmark::internal::Benchmark* bench) {
+    bench->Arg(1 << 4)->Arg(1 << 10)->Arg(1 << 16);
+  }
+
+  static size_t Make(size_t index) {
+    index += 0x9e3779b97f4a7c15ULL;
+    index = (index ^ (index >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    index = (index ^ (index >> 27)) * 0x94d049bb133111ebULL;
+    return index ^ (index >> 31);
+  }
+};
+
+// Type ids are the typical key of the ecs lookup tables. There are only as
+// many of them as types, so the sizes stay small.
+template <>
+struct KeyTraits<base::TypeId> {
+  template <size_t I>
+  struct Marker {};
+
+  constexpr static size_t kTypeCnt = 512;
+
+  static void Sizes(benchmark::internal::Benchmark* bench) {
+    bench->Arg(1 << 4)->Arg(1 << 8);
+  }
+
+  static base::TypeId Make(const size_t index) {
+    static const auto type_id_array =
+        MakeTypeIdArray(std::make_index_sequence<kTypeCnt>());
+    return type_id_array[index % kTypeCnt];
+  }
+
+ private:
+  template <size_t... Is>
+  static std::array<base::TypeId, sizeof...(Is)> MakeTypeIdArray(
+      std::index_sequence<Is...>) {
+    return {base::TypeId::Of<Marker<Is>>()...};
+  }
+};
+
+}  // namespace mirage::bench
+
+#endif  // MIRAGE_BENCHMARKS_HASH_KEYS
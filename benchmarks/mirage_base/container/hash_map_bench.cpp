@@ -0,0 +1,166 @@
+#include <benchmark/benchmark.h>
+
+#include <unordered_map>
+
+#include "alloc_counter.hpp"
+#include "hash_keys.hpp"
+#include "mirage_base/container/hash_map.hpp"
+
+using namespace mirage;
+using namespace mirage::bench;
+
+namespace {
+
+template <typename K>
+struct BaseHashMap {
+  using Key = K;
+
+  base::HashMap<Key, size_t> map;
+
+  void Insert(const Key& key, const size_t val) { map.Insert(key, val); }
+  void Remove(const Key& key) { map.Remove(key); }
+  [[nodiscard]] bool Contains(const Key& key) const {
+    return static_cast<bool>(map.TryFind(key));
+  }
+  [[nodiscard]] size_t Sum() const {
+    size_t sum = 0;
+    for (const auto& kv : map) {
+      sum += kv.val();
+    }
+    return sum;
+  }
+};
+
+template <typename K>
+struct StdUnorderedMap {
+  using Key = K;
+
+  std::unordered_map<Key, size_t, StdHash<Key>> map;
+
+  void Insert(const Key& key, const size_t val) { map.emplace(key, val); }
+  void Remove(const Key& key) { map.erase(key); }
+  [[nodiscard]] bool Contains(const Key& key) const {
+    return map.contains(key);
+  }
+  [[nodiscard]] size_t Sum() const {
+    size_t sum = 0;
+    for (const auto& kv : map) {
+      sum += kv.second;
+    }
+    return sum;
+  }
+};
+
+template <typename Map>
+using Keys = KeyTraits<typename Map::Key>;
+
+template <typename Map>
+void Fill(Map& map, const size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    map.Insert(Keys<Map>::Make(i), i);
+  }
+}
+
+template <typename Map>
+void BM_HashMapInsert(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  OpCounter counter(state);
+  for (auto _ : state) {
+    Map map;
+    Fill(map, size);
+    benchmark::DoNotOptimize(&map);
+  }
+  counter.Report(state.range(0));
+}
+
+template <typename Map>
+void BM_HashMapFindHit(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  Map map;
+  Fill(map, size);
+
+  OpCounter counter(state);
+  for (auto _ : state) {
+    size_t found = 0;
+    for (size_t i = 0; i < size; ++i) {
+      found += map.Contains(Keys<Map>::Make(i));
+    }
+    benchmark::DoNotOptimize(found);
+    if (found != size) {
+      state.SkipWithError("inserted key not found");
+      break;
+    }
+  }
+  counter.Report(state.range(0));
+}
+
+template <typename Map>
+void BM_HashMapFindMiss(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  Map map;
+  Fill(map, size);
+
+  OpCounter counter(state);
+  for (auto _ : state) {
+    size_t found = 0;
+    for (size_t i = size; i < size * 2; ++i) {
+      found += map.Contains(Keys<Map>::Make(i));
+    }
+    benchmark::DoNotOptimize(found);
+    if (found != 0) {
+      state.SkipWithError("missing key found");
+      break;
+    }
+  }
+  counter.Report(state.range(0));
+}
+
+template <typename Map>
+void BM_HashMapRemove(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  OpCounter counter(state);
+  for (auto _ : state) {
+    counter.Pause();
+    Map map;
+    Fill(map, size);
+    counter.Resume();
+
+    for (size_t i = 0; i < size; ++i) {
+      map.Remove(Keys<Map>::Make(i));
+    }
+    benchmark::DoNotOptimize(&map);
+  }
+  counter.Report(state.range(0));
+}
+
+template <typename Map>
+void BM_HashMapIterate(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  Map map;
+  Fill(map, size);
+
+  OpCounter counter(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.Sum());
+  }
+  counter.Report(state.range(0));
+}
+
+}  // namespace
+
+#define MIRAGE_HASH_MAP_BENCHMARK(func, map)                    \
+  BENCHMARK_TEMPLATE(func, map<size_t>)                         \
+      ->Apply(KeyTraits<size_t>::Sizes);                        \
+  BENCHMARK_TEMPLATE(func, map<base::TypeId>)                   \
+      ->Apply(KeyTraits<base::TypeId>::Sizes)
+
+MIRAGE_HASH_MAP_BENCHMARK(BM_HashMapInsert, BaseHashMap);
+MIRAGE_HASH_MAP_BENCHMARK(BM_HashMapInsert, StdUnorderedMap);
+MIRAGE_HASH_MAP_BENCHMARK(BM_HashMapFindHit, BaseHashMap);
+MIRAGE_HASH_MAP_BENCHMARK(BM_HashMapFindHit, StdUnorderedMap);
+MIRAGE_HASH_MAP_BENCHMARK(BM_HashMapFindMiss, BaseHashMap);
+MIRAGE_HASH_MAP_BENCHMARK(BM_HashMapFindMiss, StdUnorderedMap);
+MIRAGE_HASH_MAP_BENCHMARK(BM_HashMapRemove, BaseHashMap);
+MIRAGE_HASH_MAP_BENCHMARK(BM_HashMapRemove, StdUnorderedMap);
+MIRAGE_HASH_MAP_BENCHMARK(BM_HashMapIterate, BaseHashMap);
+MIRAGE_HASH_MAP_BENCHMARK(BM_HashMapIterate, StdUnorderedMap);
@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include <unordered_set>
+
+#include "alloc_counter.hpp"
+#include "hash_keys.hpp"
+#include "mirage_base/container/hash_set.hpp"
+
+using namespace mirage;
+using namespace mirage::bench;
+
+namespace {
+
+template <typename K>
+struct BaseHashSet {
+  using Key = K;
+
+  base::HashSet<Key> set;
+
+  void Insert(const Key& key) { set.Insert(key); }
+  // Halving the load factor doubles the buckets and rehashes every entry.
+  void Rehash() { set.SetMaxLoadFactor(set.GetMaxLoadFactor() / 2); }
+};
+
+template <typename K>
+struct StdUnorderedSet {
+  using Key = K;
+
+  std::unordered_set<Key, StdHash<Key>> set;
+
+  void Insert(const Key& key) { set.insert(key); }
+  void Rehash() { set.rehash(set.bucket_count() * 2); }
+};
+
+template <typename Set>
+using Keys = KeyTraits<typename Set::Key>;
+
+template <typename Set>
+void BM_HashSetInsert(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  OpCounter counter(state);
+  for (auto _ : state) {
+    Set set;
+    for (size_t i = 0; i < size; ++i) {
+      set.Insert(Keys<Set>::Make(i));
+    }
+    benchmark::DoNotOptimize(&set);
+  }
+  counter.Report(state.range(0));
+}
+
+// Reported per rehashed entry.
+template <typename Set>
+void BM_HashSetRehash(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  Set set;
+  OpCounter counter(state);
+  for (auto _ : state) {
+    // Dropping the previous set is not part of the measurement either.
+    counter.Pause();
+    set = Set();
+    for (size_t i = 0; i < size; ++i) {
+      set.Insert(Keys<Set>::Make(i));
+    }
+    counter.Resume();
+
+    set.Rehash();
+    benchmark::DoNotOptimize(&set);
+  }
+  counter.Report(state.range(0));
+}
+
+}  // namespace
+
+#define MIRAGE_HASH_SET_BENCHMARK(func, set)                    \
+  BENCHMARK_TEMPLATE(func, set<size_t>)                         \
+      ->Apply(KeyTraits<size_t>::Sizes);                        \
+  BENCHMARK_TEMPLATE(func, set<base::TypeId>)                   \
+      ->Apply(KeyTraits<base::TypeId>::Sizes)
+
+MIRAGE_HASH_SET_BENCHMARK(BM_HashSetInsert, BaseHashSet);
+MIRAGE_HASH_SET_BENCHMARK(BM_HashSetInsert, StdUnorderedSet);
+MIRAGE_HASH_SET_BENCHMARK(BM_HashSetRehash, BaseHashSet);
+MIRAGE_HASH_SET_BENCHMARK(BM_HashSetRehash, StdUnorderedSet);
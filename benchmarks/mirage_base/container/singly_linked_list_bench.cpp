@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include <forward_list>
+
+#include "alloc_counter.hpp"
+#include "mirage_base/container/singly_linked_list.hpp"
+
+using namespace mirage;
+using namespace mirage::bench;
+
+namespace {
+
+struct BaseList {
+  base::SinglyLinkedList<size_t> list;
+
+  void PushHead(const size_t val) { list.EmplaceHead(val); }
+  void RemoveHead() { list.RemoveHead(); }
+  [[nodiscard]] size_t Sum() const {
+    size_t sum = 0;
+    for (const auto val : list) {
+      sum += val;
+    }
+    return sum;
+  }
+};
+
+struct StdForwardList {
+  std::forward_list<size_t> list;
+
+  void PushHead(const size_t val) { list.emplace_front(val); }
+  void RemoveHead() { list.pop_front(); }
+  [[nodiscard]] size_t Sum() const {
+    size_t sum = 0;
+    for (const auto val : list) {
+      sum += val;
+    }
+    return sum;
+  }
+};
+
+void Sizes(benchmark::internal::Benchmark* bench) {
+  bench->Arg(1 << 4)->Arg(1 << 10)->Arg(1 << 16);
+}
+
+template <typename Container>
+void BM_ListPushHead(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  OpCounter counter(state);
+  for (auto _ : state) {
+    Container container;
+    for (size_t i = 0; i < size; ++i) {
+      container.PushHead(i);
+    }
+    benchmark::DoNotOptimize(&container);
+  }
+  counter.Report(state.range(0));
+}
+
+template <typename Container>
+void BM_ListIterate(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  Container container;
+  for (size_t i = 0; i < size; ++i) {
+    container.PushHead(i);
+  }
+
+  OpCounter counter(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(container.Sum());
+  }
+  counter.Report(state.range(0));
+}
+
+template <typename Container>
+void BM_ListRemoveHead(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  OpCounter counter(state);
+  for (auto _ : state) {
+    counter.Pause();
+    Container container;
+    for (size_t i = 0; i < size; ++i) {
+      container.PushHead(i);
+    }
+    counter.Resume();
+
+    for (size_t i = 0; i < size; ++i) {
+      container.RemoveHead();
+    }
+    benchmark::DoNotOptimize(&container);
+  }
+  counter.Report(state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_ListPushHead, BaseList)->Apply(Sizes);
+BENCHMARK_TEMPLATE(BM_ListPushHead, StdForwardList)->Apply(Sizes);
+BENCHMARK_TEMPLATE(BM_ListIterate, BaseList)->Apply(Sizes);
+BENCHMARK_TEMPLATE(BM_ListIterate, StdForwardList)->Apply(Sizes);
+BENCHMARK_TEMPLATE(BM_ListRemoveHead, BaseList)->Apply(Sizes);
+BENCHMARK_TEMPLATE(BM_ListRemoveHead, StdForwardList)->Apply(Sizes);
@@ -0,0 +1,143 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <utility>
+
+#include "mirage_ecs/component/component_bundle.hpp"
+#include "mirage_ecs/entity/archetype.hpp"
+#include "mirage_ecs/entity/generation_id.hpp"
+#include "mirage_ecs/util/marker.hpp"
+
+using namespace mirage::ecs;
+using namespace mirage::base;
+
+namespace {
+
+using SharedDescriptor = SharedLocal<ArchetypeDescriptor>;
+
+template <size_t N>
+struct Blob {
+  MIRAGE_COMPONENT;
+  std::array<uint8_t, N> bytes{};
+};
+
+struct Int32 {
+  MIRAGE_COMPONENT;
+  int32_t value{0};
+};
+
+void EntityCounts(benchmark::internal::Benchmark* bench) {
+  bench->Arg(1 << 10)->Arg(100'000)->Arg(1 << 20);
+  bench->Unit(benchmark::kMillisecond);
+}
+
+template <size_t N>
+SharedDescriptor MakeDescriptor() {
+  return SharedDescriptor::New(ArchetypeDescriptor::New<Blob<N>, Int32>({}));
+}
+
+template <size_t N>
+void Fill(Archetype& archetype, const size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    ComponentBundle bundle;
+    bundle.AddMany(Blob<N>{}, Int32{static_cast<int32_t>(i)});
+    archetype.Push(EntityId(i, 0), bundle);
+  }
+}
+
+template <size_t N>
+void BM_ArchetypePush(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  const auto desc = MakeDescriptor<N>();
+  for (auto _ : state) {
+    Archetype archetype(desc.Clone());
+    Fill<N>(archetype, count);
+    benchmark::DoNotOptimize(archetype.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <size_t N>
+void BM_ArchetypeRemove(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  const auto desc = MakeDescriptor<N>();
+  for (auto _ : state) {
+    state.PauseTiming();
+    Archetype archetype(desc.Clone());
+    Fill<N>(archetype, count);
+    state.ResumeTiming();
+
+    for (size_t i = 0; i < count; ++i) {
+      archetype.Remove(i);
+    }
+    benchmark::DoNotOptimize(archetype.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <size_t N>
+void BM_ArchetypeTakeMany(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  const auto desc = MakeDescriptor<N>();
+  for (auto _ : state) {
+    state.PauseTiming();
+    Archetype archetype(desc.Clone());
+    Fill<N>(archetype, count);
+    Archetype::IndexArray index_array;
+    index_array.Reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      index_array.Push(i);
+    }
+    state.ResumeTiming();
+
+    auto buffer_array = archetype.TakeMany(desc.Clone(),
+                                           std::move(index_array));
+    benchmark::DoNotOptimize(buffer_array.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <size_t N>
+void BM_ArchetypeDataBufferIterate(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  const auto desc = MakeDescriptor<N>();
+  Archetype archetype(desc.Clone());
+  Fill<N>(archetype, count);
+  Archetype::IndexArray index_array;
+  index_array.Reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    index_array.Push(i);
+  }
+  auto buffer_array = archetype.TakeMany(desc.Clone(), std::move(index_array));
+
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto& buffer : buffer_array) {
+      for (uint16_t i = 0; i < buffer.size(); ++i) {
+        auto view = buffer[i];
+        sum += view.template Get<Int32>().value +
+               view.template Get<Blob<N>>().bytes[0];
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_ArchetypePush, 4)->Apply(EntityCounts);
+BENCHMARK_TEMPLATE(BM_ArchetypePush, 64)->Apply(EntityCounts);
+BENCHMARK_TEMPLATE(BM_ArchetypePush, 256)->Apply(EntityCounts);
+
+BENCHMARK_TEMPLATE(BM_ArchetypeRemove, 4)->Apply(EntityCounts);
+BENCHMARK_TEMPLATE(BM_ArchetypeRemove, 64)->Apply(EntityCounts);
+BENCHMARK_TEMPLATE(BM_ArchetypeRemove, 256)->Apply(EntityCounts);
+
+BENCHMARK_TEMPLATE(BM_ArchetypeTakeMany, 4)->Apply(EntityCounts);
+BENCHMARK_TEMPLATE(BM_ArchetypeTakeMany, 64)->Apply(EntityCounts);
+BENCHMARK_TEMPLATE(BM_ArchetypeTakeMany, 256)->Apply(EntityCounts);
+
+BENCHMARK_TEMPLATE(BM_ArchetypeDataBufferIterate, 4)->Apply(EntityCounts);
+BENCHMARK_TEMPLATE(BM_ArchetypeDataBufferIterate, 64)->Apply(EntityCounts);
+BENCHMARK_TEMPLATE(BM_ArchetypeDataBufferIterate, 256)->Apply(EntityCounts);
@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <random>
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_ecs/component/component_bundle.hpp"
+#include "mirage_ecs/entity/entity_manager.hpp"
+
+using namespace mirage::ecs;
+using namespace mirage::base;
+
+namespace {
+
+template <size_t N>
+struct Blob {
+  MIRAGE_COMPONENT;
+  std::array<uint8_t, N> bytes{};
+};
+
+struct Int32 {
+  MIRAGE_COMPONENT;
+  int32_t value{0};
+};
+
+void EntityCounts(benchmark::internal::Benchmark* bench) {
+  bench->Arg(1 << 10)->Arg(100'000)->Arg(1 << 20);
+  bench->Unit(benchmark::kMillisecond);
+}
+
+template <size_t N>
+Array<EntityId> CreateMany(EntityManager& manager, const size_t count) {
+  Array<EntityId> entity_id_array;
+  entity_id_array.Reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    ComponentBundle bundle;
+    bundle.AddMany(Blob<N>{}, Int32{static_cast<int32_t>(i)});
+    entity_id_array.Push(manager.Create(bundle));
+  }
+  return entity_id_array;
+}
+
+template <size_t N>
+void BM_EntityManagerCreate(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  for (auto _ : state) {
+    EntityManager manager;
+    auto entity_id_array = CreateMany<N>(manager, count);
+    benchmark::DoNotOptimize(entity_id_array.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <size_t N>
+void BM_EntityManagerDestroy(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    EntityManager manager;
+    const auto entity_id_array = CreateMany<N>(manager, count);
+    state.ResumeTiming();
+
+    for (const auto& entity_id : entity_id_array) {
+      manager.Destroy(entity_id);
+    }
+    benchmark::DoNotOptimize(manager.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <size_t N>
+void BM_EntityManagerGet(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  EntityManager manager;
+  auto entity_id_array = CreateMany<N>(manager, count);
+  // Random order defeats the prefetcher, as lookups by id usually do.
+  std::ranges::shuffle(entity_id_array, std::mt19937_64(42));
+
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (const auto& entity_id : entity_id_array) {
+      sum += manager.Get(entity_id).template Get<Int32>().value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Rollback clones into the same destination every frame, so after the first
+// clone its chunks are only overwritten.
+template <size_t N>
+void BM_EntityManagerCloneInto(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  EntityManager manager;
+  CreateMany<N>(manager, count);
+  EntityManager dst;
+  manager.CloneInto(dst);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(manager.CloneInto(dst));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_EntityManagerCreate, 4)->Apply(EntityCounts);
+BENCHMARK_TEMPLATE(BM_EntityManagerCreate, 64)->Apply(EntityCounts);
+BENCHMARK_TEMPLATE(BM_EntityManagerCreate, 256)->Apply(EntityCounts);
+
+BENCHMARK_TEMPLATE(BM_EntityManagerDestroy, 4)->Apply(EntityCounts);
+BENCHMARK_TEMPLATE(BM_EntityManagerDestroy, 64)->Apply(EntityCounts);
+BENCHMARK_TEMPLATE(BM_EntityManagerDestroy, 256)->Apply(EntityCounts);
+
+BENCHMARK_TEMPLATE(BM_EntityManagerGet, 4)->Apply(EntityCounts);
+BENCHMARK_TEMPLATE(BM_EntityManagerGet, 64)->Apply(EntityCounts);
+BENCHMARK_TEMPLATE(BM_EntityManagerGet, 256)->Apply(EntityCounts);
+
+BENCHMARK_TEMPLATE(BM_EntityManagerCloneInto, 4)->Apply(EntityCounts);
+BENCHMARK_TEMPLATE(BM_EntityManagerCloneInto, 64)->Apply(EntityCounts);
+BENCHMARK_TEMPLATE(BM_EntityManagerCloneInto, 256)->Apply(EntityCounts);
@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+
+#include "mirage_ecs/framework/world.hpp"
+#include "mirage_ecs/system/resource.hpp"
+#include "mirage_ecs/system/system.hpp"
+
+using namespace mirage;
+using namespace mirage::ecs;
+
+namespace {
+
+struct Counter {
+  MIRAGE_RESOURCE;
+  int64_t value{0};
+};
+
+struct Config {
+  MIRAGE_RESOURCE;
+  int64_t step{1};
+};
+
+void EmptySystem() {}
+
+void ReadSystem(const Res<const Config> config) {
+  benchmark::DoNotOptimize(config->step);
+}
+
+void WriteSystem(const Res<Counter> counter, const Res<const Config> config) {
+  counter->value += config->step;
+}
+
+void RunCounts(benchmark::internal::Benchmark* bench) {
+  bench->Arg(1 << 10)->Arg(100'000)->Arg(1 << 20);
+  bench->Unit(benchmark::kMicrosecond);
+}
+
+template <auto Func>
+void BM_SystemRun(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  World world;
+  world.InitResource<Counter>();
+  world.InitResource<Config>();
+  auto system = System::From(Func);
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < count; ++i) {
+      system.Run(world);
+    }
+  }
+  benchmark::DoNotOptimize(world.GetResource<Counter>().value);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_SystemRun, EmptySystem)->Apply(RunCounts);
+BENCHMARK_TEMPLATE(BM_SystemRun, ReadSystem)->Apply(RunCounts);
+BENCHMARK_TEMPLATE(BM_SystemRun, WriteSystem)->Apply(RunCounts);
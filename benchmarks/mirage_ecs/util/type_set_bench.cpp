@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <utility>
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_base/util/type_id.hpp"
+#include "mirage_ecs/util/type_set.hpp"
+
+using namespace mirage;
+using namespace mirage::ecs;
+
+namespace {
+
+constexpr size_t kTypeCnt = 64;
+constexpr size_t kSetCnt = 256;
+
+template <size_t I>
+struct Marker {};
+
+template <size_t... Is>
+std::array<base::TypeId, sizeof...(Is)> MakeTypeIdArray(
+    std::index_sequence<Is...>) {
+  return {base::TypeId::Of<Marker<Is>>()...};
+}
+
+const std::array<base::TypeId, kTypeCnt>& type_id_array() {
+  static const auto type_id_array =
+      MakeTypeIdArray(std::make_index_sequence<kTypeCnt>());
+  return type_id_array;
+}
+
+void QueryCounts(benchmark::internal::Benchmark* bench) {
+  bench->Arg(1 << 10)->Arg(100'000)->Arg(1 << 20);
+}
+
+// A pool of archetype type sets with `Width` types each; 13 is coprime with
+// kTypeCnt, so no set holds a type twice.
+template <size_t Width>
+base::Array<TypeSet> MakeTypeSetArray() {
+  base::Array<TypeSet> type_set_array;
+  type_set_array.Reserve(kSetCnt);
+  for (size_t i = 0; i < kSetCnt; ++i) {
+    TypeSet type_set;
+    for (size_t j = 0; j < Width; ++j) {
+      type_set.AddTypeId(type_id_array()[(i * 7 + j * 13) % kTypeCnt]);
+    }
+    type_set_array.Emplace(std::move(type_set));
+  }
+  return type_set_array;
+}
+
+template <size_t Width>
+void BM_TypeSetWith(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  const auto type_set_array = MakeTypeSetArray<Width>();
+  TypeSet with;
+  with.AddTypeId(type_id_array()[0]);
+  with.AddTypeId(type_id_array()[13]);
+
+  for (auto _ : state) {
+    size_t matched = 0;
+    for (size_t i = 0; i < count; ++i) {
+      matched += type_set_array[i % kSetCnt].With(with);
+    }
+    benchmark::DoNotOptimize(matched);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <size_t Width>
+void BM_TypeSetWithout(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  const auto type_set_array = MakeTypeSetArray<Width>();
+  TypeSet without;
+  without.AddTypeId(type_id_array()[1]);
+  without.AddTypeId(type_id_array()[14]);
+
+  for (auto _ : state) {
+    size_t matched = 0;
+    for (size_t i = 0; i < count; ++i) {
+      matched += type_set_array[i % kSetCnt].Without(without);
+    }
+    benchmark::DoNotOptimize(matched);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_TypeSetWith, 2)->Apply(QueryCounts);
+BENCHMARK_TEMPLATE(BM_TypeSetWith, 8)->Apply(QueryCounts);
+BENCHMARK_TEMPLATE(BM_TypeSetWith, 32)->Apply(QueryCounts);
+
+BENCHMARK_TEMPLATE(BM_TypeSetWithout, 2)->Apply(QueryCounts);
+BENCHMARK_TEMPLATE(BM_TypeSetWithout, 8)->Apply(QueryCounts);
+BENCHMARK_TEMPLATE(BM_TypeSetWithout, 32)->Apply(QueryCounts);
@@ -0,0 +1,14 @@
+target("bench.mirage_ecs")
+  set_kind("binary")
+  set_group("benchmarks")
+
+  add_packages("benchmark")
+  add_links("benchmark_main")
+
+  if is_config("mirage_split", true) then
+    add_deps("mirage_ecs")
+  else
+    add_deps("mirage_engine")
+  end
+  add_files("**.cpp")
+target_end()
@@ -0,0 +1,4 @@
+add_requires("benchmark 1.9.1")
+
+includes("mirage_base")
+includes("mirage_ecs")
@@ -1,18 +1,103 @@
 #ifndef MIRAGE_BASE_AUTO_PTR_OBSERVED
 #define MIRAGE_BASE_AUTO_PTR_OBSERVED
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
 #include "mirage_base/auto_ptr/ref_count.hpp"
+#include "mirage_base/auto_ptr/shared_block.hpp"
 #include "mirage_base/define/check.hpp"
-#include "mirage_base/sync/rw_lock.hpp"
 #include "mirage_base/wrap/optional.hpp"
 
 namespace mirage::base {
 
+// An observed pointer is the only strong reference of a `SharedBlock` and its
+// observers are weak references, so `New` makes one allocation for the object
+// and all of its bookkeeping. Each handle also keeps the object pointer as its
+// own type, which a conversion may offset from where the block holds it.
+
+// Block of `ObservedAsync`, which also packs a readers-writer state into one
+// atomic word. Checking for null is a single load and a guard never allocates.
+class ObservedAsyncBlock : public SharedBlock<RefCountAsync> {
+ public:
+  ObservedAsyncBlock(void* object, const Handler handler)
+      : SharedBlock(object, handler) {}
+
+  bool LockRead() {
+    auto state = state_.load(std::memory_order_relaxed);
+    while (true) {
+      if (state & kDestroyed) {
+        return false;
+      }
+      if (state & kWriter) {
+        state_.wait(state, std::memory_order_relaxed);
+        state = state_.load(std::memory_order_relaxed);
+      } else if (state_.compare_exchange_weak(state, state + 1,
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+  }
+
+  void UnlockRead() {
+    const auto state = state_.fetch_sub(1, std::memory_order_release);
+    if ((state & kReaderMask) == 1) {
+      state_.notify_all();
+    }
+  }
+
+  bool LockWrite() {
+    auto state = state_.load(std::memory_order_relaxed);
+    while (true) {
+      if (state & kDestroyed) {
+        return false;
+      }
+      if (state != 0) {
+        state_.wait(state, std::memory_order_relaxed);
+        state = state_.load(std::memory_order_relaxed);
+      } else if (state_.compare_exchange_weak(state, kWriter,
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+  }
+
+  void UnlockWrite() {
+    state_.store(0, std::memory_order_release);
+    state_.notify_all();
+  }
+
+  // Wait for the guards in flight to finish and reject any later one.
+  void MarkDestroyed() {
+    [[maybe_unused]] const bool is_locked = LockWrite();
+    MIRAGE_DCHECK(is_locked);
+    state_.store(kDestroyed, std::memory_order_release);
+    state_.notify_all();
+  }
+
+  [[nodiscard]] bool is_destroyed() const {
+    return state_.load(std::memory_order_acquire) & kDestroyed;
+  }
+
+ private:
+  constexpr static uint32_t kDestroyed = 1u << 31;
+  constexpr static uint32_t kWriter = 1u << 30;
+  constexpr static uint32_t kReaderMask = kWriter - 1;
+
+  std::atomic<uint32_t> state_{0};
+};
+
 template <typename T>
 class LocalObserver;
 
 template <typename T>
 class ObservedLocal {
+  using Block = SharedBlock<RefCountLocal>;
+
  public:
   ObservedLocal() = default;
   ~ObservedLocal();
@@ -54,16 +139,16 @@ class ObservedLocal {
   [[nodiscard]] size_t observer_cnt() const;
 
  private:
-  ObservedLocal(T* raw_ptr, bool* is_null, RefCount* observer_cnt);
-  void ResetPtr();
+  ObservedLocal(Block* block, T* object);
 
-  T* raw_ptr_{nullptr};
-  bool* is_null_{nullptr};
-  RefCount* observer_cnt_{nullptr};
+  Block* block_{nullptr};
+  T* object_{nullptr};
 };
 
 template <typename T>
 class LocalObserver {
+  using Block = SharedBlock<RefCountLocal>;
+
  public:
   LocalObserver() = default;
   ~LocalObserver();
@@ -102,12 +187,10 @@ class LocalObserver {
  private:
   friend class ObservedLocal<T>;
 
-  LocalObserver(T* raw_ptr, bool* is_null, RefCount* observer_cnt);
-  void ResetPtr();
+  LocalObserver(Block* block, T* object);
 
-  T* raw_ptr_{nullptr};
-  bool* is_null_{nullptr};
-  RefCount* observer_cnt_{nullptr};
+  Block* block_{nullptr};
+  T* object_{nullptr};
 };
 
 template <typename T>
@@ -115,6 +198,8 @@ class AsyncObserver;
 
 template <typename T>
 class ObservedAsync {
+  using Block = ObservedAsyncBlock;
+
  public:
   class ReadGuard;
   class WriteGuard;
@@ -160,18 +245,16 @@ class ObservedAsync {
   [[nodiscard]] size_t observer_cnt() const;
 
  private:
-  ObservedAsync(T* raw_ptr, RWLock* rw_lock, bool* is_null,
-                RefCount* observer_cnt);
-  void ResetPtr();
-
-  T* raw_ptr_{nullptr};
-  RWLock* rw_lock_{nullptr};
-  bool* is_null_{nullptr};
-  RefCount* observer_cnt_{nullptr};
+  ObservedAsync(Block* block, T* object);
+
+  Block* block_{nullptr};
+  T* object_{nullptr};
 };
 
 template <typename T>
 class AsyncObserver {
+  using Block = ObservedAsyncBlock;
+
  public:
   using ReadGuard = typename ObservedAsync<T>::ReadGuard;
   using WriteGuard = typename ObservedAsync<T>::WriteGuard;
@@ -200,6 +283,7 @@ class AsyncObserver {
   template <typename T1>
   AsyncObserver<T1> Convert() &&;
 
+  // A guard must not outlive the observer it was taken from.
   Optional<ReadGuard> Read() const;
   Optional<WriteGuard> Write() const;
 
@@ -213,22 +297,20 @@ class AsyncObserver {
 
  private:
   friend class ObservedAsync<T>;
-  AsyncObserver(T* raw_ptr, RWLock* rw_lock, bool* is_null,
-                RefCount* observer_cnt);
-  void ResetPtr();
-
-  T* raw_ptr_{nullptr};
-  RWLock* rw_lock_{nullptr};
-  bool* is_null_{nullptr};
-  RefCount* observer_cnt_{nullptr};
+
+  AsyncObserver(Block* block, T* object);
+
+  Block* block_{nullptr};
+  T* object_{nullptr};
 };
 
 template <typename T>
 class ObservedAsync<T>::ReadGuard {
  public:
   ReadGuard() = delete;
-  ReadGuard(const T* raw_ptr, base::ReadGuard&& rw_lock);
-  ~ReadGuard() = default;
+  // Take over a read lock held on `block`.
+  ReadGuard(const T* raw_ptr, ObservedAsyncBlock* block);
+  ~ReadGuard();
 
   ReadGuard(const ReadGuard&) = delete;
   ReadGuard& operator=(const ReadGuard&) = delete;
@@ -241,15 +323,16 @@ class ObservedAsync<T>::ReadGuard {
 
  private:
   const T* raw_ptr_;
-  base::ReadGuard read_guard_;
+  ObservedAsyncBlock* block_;
 };
 
 template <typename T>
 class ObservedAsync<T>::WriteGuard {
  public:
   WriteGuard() = delete;
-  WriteGuard(T* raw_ptr, base::WriteGuard&& rw_lock);
-  ~WriteGuard() = default;
+  // Take over a write lock held on `block`.
+  WriteGuard(T* raw_ptr, ObservedAsyncBlock* block);
+  ~WriteGuard();
 
   WriteGuard(const WriteGuard&) = delete;
   WriteGuard& operator=(const WriteGuard&) = delete;
@@ -262,7 +345,7 @@ class ObservedAsync<T>::WriteGuard {
 
  private:
   T* raw_ptr_;
-  base::WriteGuard write_guard_;
+  ObservedAsyncBlock* block_;
 };
 
 template <typename T>
@@ -272,11 +355,8 @@ ObservedLocal<T>::~ObservedLocal() {
 
 template <typename T>
 ObservedLocal<T>::ObservedLocal(ObservedLocal&& other) noexcept
-    : raw_ptr_(other.raw_ptr_),
-      is_null_(other.is_null_),
-      observer_cnt_(other.observer_cnt_) {
-  other.ResetPtr();
-}
+    : block_(std::exchange(other.block_, nullptr)),
+      object_(std::exchange(other.object_, nullptr)) {}
 
 template <typename T>
 ObservedLocal<T>& ObservedLocal<T>::operator=(ObservedLocal&& other) noexcept {
@@ -290,9 +370,7 @@ ObservedLocal<T>& ObservedLocal<T>::operator=(ObservedLocal&& other) noexcept {
 
 template <typename T>
 ObservedLocal<T>::ObservedLocal(T* raw_ptr)
-    : raw_ptr_(raw_ptr),
-      is_null_(new bool(false)),
-      observer_cnt_(new RefCountLocal(0)) {
+    : block_(new SharedRawBlock<T, Block>(raw_ptr)), object_(raw_ptr) {
   MIRAGE_DCHECK(raw_ptr != nullptr);
 }
 
@@ -307,66 +385,62 @@ ObservedLocal<T>& ObservedLocal<T>::operator=(std::nullptr_t) {
 
 template <typename T>
 void ObservedLocal<T>::Reset() {
-  if (is_null()) {
-    return;
+  if (block_) {
+    block_->Release();
   }
-  if (is_null_) {
-    *is_null_ = true;
-  }
-  delete raw_ptr_;
-  if (observer_cnt_->cnt() == 0) {
-    delete is_null_;
-    delete observer_cnt_;
-  }
-  ResetPtr();
+  block_ = nullptr;
+  object_ = nullptr;
 }
 
 template <typename T>
 template <typename... Args>
 ObservedLocal<T> ObservedLocal<T>::New(Args&&... args) {
-  return ObservedLocal(new T(std::forward<Args>(args)...));
+  auto* block = new SharedInlineBlock<T, Block>(std::forward<Args>(args)...);
+  return ObservedLocal(block, static_cast<T*>(block->object()));
 }
 
 template <typename T>
 template <typename T1>
 ObservedLocal<T1> ObservedLocal<T>::TryConvert() {
-  T1* raw_ptr = dynamic_cast<T1*>(raw_ptr_);
+  T1* raw_ptr = dynamic_cast<T1*>(this->raw_ptr());
   if (raw_ptr == nullptr) {
     return nullptr;
   }
-  return std::move(*this).template Convert<T1>();
+  auto rv = ObservedLocal<T1>(block_, raw_ptr);
+  block_ = nullptr;
+  object_ = nullptr;
+  return rv;
 }
 
 template <typename T>
 template <typename T1>
 ObservedLocal<T1> ObservedLocal<T>::Convert() && {
-  auto rv =
-      ObservedLocal<T1>(static_cast<T1*>(raw_ptr_), is_null_, observer_cnt_);
-  ResetPtr();
+  auto rv = ObservedLocal<T1>(block_, static_cast<T1*>(object_));
+  block_ = nullptr;
+  object_ = nullptr;
   return rv;
 }
 
 template <typename T>
 LocalObserver<T> ObservedLocal<T>::NewObserver() const {
-  MIRAGE_DCHECK(raw_ptr_ != nullptr);
-  MIRAGE_DCHECK(observer_cnt_ != nullptr);
-  observer_cnt_->Increase();
-  return LocalObserver<T>(raw_ptr_, is_null_, observer_cnt_);
+  MIRAGE_DCHECK(block_ != nullptr);
+  block_->weak_ref_cnt().Increase();
+  return LocalObserver<T>(block_, object_);
 }
 
 template <typename T>
 T* ObservedLocal<T>::operator->() const {
-  return raw_ptr_;
+  return raw_ptr();
 }
 
 template <typename T>
 T& ObservedLocal<T>::operator*() const {
-  return *raw_ptr_;
+  return *raw_ptr();
 }
 
 template <typename T>
 T* ObservedLocal<T>::raw_ptr() const {
-  return raw_ptr_;
+  return object_;
 }
 
 template <typename T>
@@ -381,25 +455,18 @@ bool ObservedLocal<T>::operator==(std::nullptr_t) const {
 
 template <typename T>
 bool ObservedLocal<T>::is_null() const {
-  return is_null_ == nullptr || *is_null_;
+  return block_ == nullptr;
 }
 
 template <typename T>
 size_t ObservedLocal<T>::observer_cnt() const {
-  return observer_cnt_ ? observer_cnt_->cnt() : 0;
+  // Don't count the weak reference held by the observed pointer itself.
+  return block_ ? block_->weak_ref_cnt().cnt() - 1 : 0;
 }
 
 template <typename T>
-ObservedLocal<T>::ObservedLocal(T* raw_ptr, bool* is_null,
-                                RefCount* observer_cnt)
-    : raw_ptr_(raw_ptr), is_null_(is_null), observer_cnt_(observer_cnt) {}
-
-template <typename T>
-void ObservedLocal<T>::ResetPtr() {
-  raw_ptr_ = nullptr;
-  is_null_ = nullptr;
-  observer_cnt_ = nullptr;
-}
+ObservedLocal<T>::ObservedLocal(Block* block, T* object)
+    : block_(block), object_(object) {}
 
 template <typename T>
 LocalObserver<T>::~LocalObserver() {
@@ -408,11 +475,8 @@ LocalObserver<T>::~LocalObserver() {
 
 template <typename T>
 LocalObserver<T>::LocalObserver(LocalObserver&& other) noexcept
-    : raw_ptr_(other.raw_ptr_),
-      is_null_(other.is_null_),
-      observer_cnt_(other.observer_cnt_) {
-  other.ResetPtr();
-}
+    : block_(std::exchange(other.block_, nullptr)),
+      object_(std::exchange(other.object_, nullptr)) {}
 
 template <typename T>
 LocalObserver<T>& LocalObserver<T>::operator=(LocalObserver&& other) noexcept {
@@ -435,56 +499,60 @@ LocalObserver<T>& LocalObserver<T>::operator=(std::nullptr_t) {
 
 template <typename T>
 void LocalObserver<T>::Reset() {
-  if (!observer_cnt_) {
-    return;
+  if (block_) {
+    block_->ReleaseWeak();
   }
-  if (observer_cnt_->TryRelease() && is_null()) {
-    delete is_null_;
-    delete observer_cnt_;
-  }
-  ResetPtr();
+  block_ = nullptr;
+  object_ = nullptr;
 }
 
 template <typename T>
 LocalObserver<T> LocalObserver<T>::Clone() const {
-  if (observer_cnt_ != nullptr) {
-    observer_cnt_->TryIncrease();
+  if (block_ == nullptr) {
+    return nullptr;
   }
-  return LocalObserver(raw_ptr_, is_null_, observer_cnt_);
+  block_->weak_ref_cnt().Increase();
+  return LocalObserver(block_, object_);
 }
 
 template <typename T>
 template <typename T1>
 LocalObserver<T1> LocalObserver<T>::TryConvert() {
-  T1* raw_ptr = dynamic_cast<T1*>(raw_ptr_);
+  if (is_null()) {
+    return nullptr;
+  }
+  T1* raw_ptr = dynamic_cast<T1*>(this->raw_ptr());
   if (raw_ptr == nullptr) {
     return nullptr;
   }
-  return std::move(*this).template Convert<T1>();
+  auto rv = LocalObserver<T1>(block_, raw_ptr);
+  block_ = nullptr;
+  object_ = nullptr;
+  return rv;
 }
 
 template <typename T>
 template <typename T1>
 LocalObserver<T1> LocalObserver<T>::Convert() && {
-  auto rv =
-      LocalObserver<T1>(static_cast<T1*>(raw_ptr_), is_null_, observer_cnt_);
-  ResetPtr();
+  auto rv = LocalObserver<T1>(block_, static_cast<T1*>(object_));
+  block_ = nullptr;
+  object_ = nullptr;
   return rv;
 }
 
 template <typename T>
 T* LocalObserver<T>::operator->() const {
-  return raw_ptr_;
+  return raw_ptr();
 }
 
 template <typename T>
 T& LocalObserver<T>::operator*() const {
-  return *raw_ptr_;
+  return *raw_ptr();
 }
 
 template <typename T>
 T* LocalObserver<T>::raw_ptr() const {
-  return raw_ptr_;
+  return object_;
 }
 
 template <typename T>
@@ -499,25 +567,22 @@ bool LocalObserver<T>::operator==(std::nullptr_t) const {
 
 template <typename T>
 bool LocalObserver<T>::is_null() const {
-  return is_null_ == nullptr || *is_null_;
+  return block_ == nullptr || block_->ref_cnt().cnt() == 0;
 }
 
 template <typename T>
 size_t LocalObserver<T>::observer_cnt() const {
-  return observer_cnt_ ? observer_cnt_->cnt() : 0;
+  if (block_ == nullptr) {
+    return 0;
+  }
+  // Don't count the weak reference held by a live observed pointer.
+  const size_t weak_ref_cnt = block_->weak_ref_cnt().cnt();
+  return block_->ref_cnt().cnt() == 0 ? weak_ref_cnt : weak_ref_cnt - 1;
 }
 
 template <typename T>
-LocalObserver<T>::LocalObserver(T* raw_ptr, bool* is_null,
-                                RefCount* observer_cnt)
-    : raw_ptr_(raw_ptr), is_null_(is_null), observer_cnt_(observer_cnt) {}
-
-template <typename T>
-void LocalObserver<T>::ResetPtr() {
-  raw_ptr_ = nullptr;
-  is_null_ = nullptr;
-  observer_cnt_ = nullptr;
-}
+LocalObserver<T>::LocalObserver(Block* block, T* object)
+    : block_(block), object_(object) {}
 
 template <typename T>
 ObservedAsync<T>::~ObservedAsync() {
@@ -526,12 +591,8 @@ ObservedAsync<T>::~ObservedAsync() {
 
 template <typename T>
 ObservedAsync<T>::ObservedAsync(ObservedAsync&& other) noexcept
-    : raw_ptr_(other.raw_ptr_),
-      rw_lock_(other.rw_lock_),
-      is_null_(other.is_null_),
-      observer_cnt_(other.observer_cnt_) {
-  other.ResetPtr();
-}
+    : block_(std::exchange(other.block_, nullptr)),
+      object_(std::exchange(other.object_, nullptr)) {}
 
 template <typename T>
 ObservedAsync<T>& ObservedAsync<T>::operator=(ObservedAsync&& other) noexcept {
@@ -545,10 +606,7 @@ ObservedAsync<T>& ObservedAsync<T>::operator=(ObservedAsync&& other) noexcept {
 
 template <typename T>
 ObservedAsync<T>::ObservedAsync(T* raw_ptr)
-    : raw_ptr_(raw_ptr),
-      rw_lock_(new RWLock()),
-      is_null_(new bool(false)),
-      observer_cnt_(new RefCountAsync(0)) {
+    : block_(new SharedRawBlock<T, Block>(raw_ptr)), object_(raw_ptr) {
   MIRAGE_DCHECK(raw_ptr != nullptr);
 }
 
@@ -563,74 +621,70 @@ ObservedAsync<T>& ObservedAsync<T>::operator=(std::nullptr_t) {
 
 template <typename T>
 void ObservedAsync<T>::Reset() {
-  if (rw_lock_ == nullptr) {
+  if (block_ == nullptr) {
     return;
   }
-  {
-    auto guard = base::ScopedWriteGuard(*rw_lock_);
-    MIRAGE_DCHECK(is_null_ != nullptr);
-    if (*is_null_) {
-      return;
-    }
-    *is_null_ = true;
-    delete raw_ptr_;
-  }
-
-  if (observer_cnt_->cnt() == 0) {
-    delete rw_lock_;
-    delete is_null_;
-    delete observer_cnt_;
-  }
-  ResetPtr();
+  block_->MarkDestroyed();
+  block_->Release();
+  block_ = nullptr;
+  object_ = nullptr;
 }
 
 template <typename T>
 template <typename... Args>
 ObservedAsync<T> ObservedAsync<T>::New(Args&&... args) {
-  return ObservedAsync(new T(std::forward<Args>(args)...));
+  auto* block = new SharedInlineBlock<T, Block>(std::forward<Args>(args)...);
+  return ObservedAsync(block, static_cast<T*>(block->object()));
 }
 
 template <typename T>
 template <typename T1>
 ObservedAsync<T1> ObservedAsync<T>::TryConvert() {
-  T1* raw_ptr = dynamic_cast<T1*>(raw_ptr_);
+  T1* raw_ptr = dynamic_cast<T1*>(this->raw_ptr());
   if (raw_ptr == nullptr) {
     return nullptr;
   }
-  return std::move(*this).template Convert<T1>();
+  auto rv = ObservedAsync<T1>(block_, raw_ptr);
+  block_ = nullptr;
+  object_ = nullptr;
+  return rv;
 }
 
 template <typename T>
 template <typename T1>
 ObservedAsync<T1> ObservedAsync<T>::Convert() && {
-  auto rv = ObservedAsync<T1>(static_cast<T1*>(raw_ptr_), rw_lock_, is_null_,
-                              observer_cnt_);
-  ResetPtr();
+  auto rv = ObservedAsync<T1>(block_, static_cast<T1*>(object_));
+  block_ = nullptr;
+  object_ = nullptr;
   return rv;
 }
 
 template <typename T>
 AsyncObserver<T> ObservedAsync<T>::NewObserver() const {
-  MIRAGE_DCHECK(observer_cnt_ != nullptr);
-  observer_cnt_->Increase();
-  return AsyncObserver<T>(raw_ptr_, rw_lock_, is_null_, observer_cnt_);
+  MIRAGE_DCHECK(block_ != nullptr);
+  block_->weak_ref_cnt().Increase();
+  return AsyncObserver<T>(block_, object_);
 }
 
 template <typename T>
 typename ObservedAsync<T>::ReadGuard ObservedAsync<T>::Read() const {
-  MIRAGE_DCHECK(rw_lock_ != nullptr);
-  return ReadGuard(raw_ptr_, base::ReadGuard(*rw_lock_));
+  MIRAGE_DCHECK(block_ != nullptr);
+  [[maybe_unused]] const bool is_locked = block_->LockRead();
+  MIRAGE_DCHECK(is_locked);
+  return ReadGuard(raw_ptr(), block_);
 }
 
 template <typename T>
 typename ObservedAsync<T>::WriteGuard ObservedAsync<T>::Write() const {
-  MIRAGE_DCHECK(rw_lock_ != nullptr);
-  return WriteGuard(raw_ptr_, base::WriteGuard(*rw_lock_));
+  MIRAGE_DCHECK(block_ != nullptr);
+  [[maybe_unused]] const bool is_locked = block_->LockWrite();
+  MIRAGE_DCHECK(is_locked);
+  return WriteGuard(raw_ptr(), block_);
 }
 
 template <typename T>
 T* ObservedAsync<T>::raw_ptr() const {
-  return raw_ptr_;
+  return object_;
 }
 
 template <typename T>
@@ -645,34 +699,18 @@ bool ObservedAsync<T>::operator==(std::nullptr_t) const {
 
 template <typename T>
 bool ObservedAsync<T>::is_null() const {
-  if (rw_lock_ == nullptr) {
-    return true;
-  }
-  auto guard = base::ScopedReadGuard(*rw_lock_);
-  MIRAGE_DCHECK(is_null_ != nullptr);
-  return *is_null_;
+  return block_ == nullptr;
 }
 
 template <typename T>
 size_t ObservedAsync<T>::observer_cnt() const {
-  return observer_cnt_ ? observer_cnt_->cnt() : 0;
+  // Don't count the weak reference held by the observed pointer itself.
+  return block_ ? block_->weak_ref_cnt().cnt() - 1 : 0;
 }
 
 template <typename T>
-ObservedAsync<T>::ObservedAsync(T* raw_ptr, RWLock* rw_lock, bool* is_null,
-                                RefCount* observer_cnt)
-    : raw_ptr_(raw_ptr),
-      rw_lock_(rw_lock),
-      is_null_(is_null),
-      observer_cnt_(observer_cnt) {}
-
-template <typename T>
-void ObservedAsync<T>::ResetPtr() {
-  raw_ptr_ = nullptr;
-  rw_lock_ = nullptr;
-  is_null_ = nullptr;
-  observer_cnt_ = nullptr;
-}
+ObservedAsync<T>::ObservedAsync(Block* block, T* object)
+    : block_(block), object_(object) {}
 
 template <typename T>
 AsyncObserver<T>::~AsyncObserver() {
@@ -681,12 +719,8 @@ AsyncObserver<T>::~AsyncObserver() {
 
 template <typename T>
 AsyncObserver<T>::AsyncObserver(AsyncObserver&& other) noexcept
-    : raw_ptr_(other.raw_ptr_),
-      rw_lock_(other.rw_lock_),
-      is_null_(other.is_null_),
-      observer_cnt_(other.observer_cnt_) {
-  other.ResetPtr();
-}
+    : block_(std::exchange(other.block_, nullptr)),
+      object_(std::exchange(other.object_, nullptr)) {}
 
 template <typename T>
 AsyncObserver<T>& AsyncObserver<T>::operator=(AsyncObserver&& other) noexcept {
@@ -709,74 +743,67 @@ AsyncObserver<T>& AsyncObserver<T>::operator=(std::nullptr_t) {
 
 template <typename T>
 void AsyncObserver<T>::Reset() {
-  if (!observer_cnt_) {
-    return;
-  }
-  if (observer_cnt_->TryRelease() && is_null()) {
-    delete rw_lock_;
-    delete is_null_;
-    delete observer_cnt_;
+  if (block_) {
+    block_->ReleaseWeak();
   }
-  ResetPtr();
+  block_ = nullptr;
+  object_ = nullptr;
 }
 
 template <typename T>
 AsyncObserver<T> AsyncObserver<T>::Clone() const {
-  if (observer_cnt_ != nullptr) {
-    observer_cnt_->TryIncrease();
+  if (block_ == nullptr) {
+    return nullptr;
   }
-  return AsyncObserver(raw_ptr_, rw_lock_, is_null_, observer_cnt_);
+  block_->weak_ref_cnt().Increase();
+  return AsyncObserver(block_, object_);
 }
 
 template <typename T>
 template <typename T1>
 AsyncObserver<T1> AsyncObserver<T>::TryConvert() {
-  T1* raw_ptr = dynamic_cast<T1*>(raw_ptr_);
+  if (is_null()) {
+    return nullptr;
+  }
+  T1* raw_ptr = dynamic_cast<T1*>(this->raw_ptr());
   if (raw_ptr == nullptr) {
     return nullptr;
   }
-  return std::move(*this).template Convert<T1>();
+  auto rv = AsyncObserver<T1>(block_, raw_ptr);
+  block_ = nullptr;
+  object_ = nullptr;
+  return rv;
 }
 
 template <typename T>
 template <typename T1>
 AsyncObserver<T1> AsyncObserver<T>::Convert() && {
-  auto rv = AsyncObserver<T1>(static_cast<T1*>(raw_ptr_), rw_lock_, is_null_,
-                              observer_cnt_);
-  ResetPtr();
+  auto rv = AsyncObserver<T1>(block_, static_cast<T1*>(object_));
+  block_ = nullptr;
+  object_ = nullptr;
   return rv;
 }
 
 template <typename T>
 Optional<typename AsyncObserver<T>::ReadGuard> AsyncObserver<T>::Read() const {
-  if (rw_lock_ == nullptr) {
-    return Optional<ReadGuard>::None();
-  }
-  auto guard = base::ReadGuard(*rw_lock_);
-  if (is_null_ == nullptr || *is_null_) {
+  if (block_ == nullptr || !block_->LockRead()) {
     return Optional<ReadGuard>::None();
   }
-  MIRAGE_DCHECK(rw_lock_ != nullptr);
-  return Optional<ReadGuard>::New(raw_ptr_, std::move(guard));
+  return Optional<ReadGuard>::New(raw_ptr(), block_);
 }
 
 template <typename T>
 Optional<typename AsyncObserver<T>::WriteGuard> AsyncObserver<T>::Write()
     const {
-  if (rw_lock_ == nullptr) {
+  if (block_ == nullptr || !block_->LockWrite()) {
     return Optional<WriteGuard>::None();
   }
-  auto guard = base::WriteGuard(*rw_lock_);
-  if (is_null_ == nullptr || *is_null_) {
-    return Optional<WriteGuard>::None();
-  }
-  MIRAGE_DCHECK(rw_lock_ != nullptr);
-  return Optional<WriteGuard>::New(raw_ptr_, std::move(guard));
+  return Optional<WriteGuard>::New(raw_ptr(), block_);
 }
 
 template <typename T>
 T* AsyncObserver<T>::raw_ptr() const {
-  return raw_ptr_;
+  return object_;
 }
 
 template <typename T>
@@ -791,46 +818,42 @@ bool AsyncObserver<T>::operator==(std::nullptr_t) const {
 
 template <typename T>
 bool AsyncObserver<T>::is_null() const {
-  if (rw_lock_ == nullptr) {
-    return true;
-  }
-  auto guard = base::ScopedReadGuard(*rw_lock_);
-  MIRAGE_DCHECK(is_null_ != nullptr);
-  return *is_null_;
+  return block_ == nullptr || block_->is_destroyed();
 }
 
 template <typename T>
 size_t AsyncObserver<T>::observer_cnt() const {
-  return observer_cnt_ ? observer_cnt_->cnt() : 0;
+  if (block_ == nullptr) {
+    return 0;
+  }
+  // Don't count the weak reference held by a live observed pointer.
+  const size_t weak_ref_cnt = block_->weak_ref_cnt().cnt();
+  return block_->ref_cnt().cnt() == 0 ? weak_ref_cnt : weak_ref_cnt - 1;
 }
 
 template <typename T>
-AsyncObserver<T>::AsyncObserver(T* raw_ptr, RWLock* rw_lock, bool* is_null,
-                                RefCount* observer_cnt)
-    : raw_ptr_(raw_ptr),
-      rw_lock_(rw_lock),
-      is_null_(is_null),
-      observer_cnt_(observer_cnt) {}
+AsyncObserver<T>::AsyncObserver(Block* block, T* object)
+    : block_(block), object_(object) {}
 
 template <typename T>
-void AsyncObserver<T>::ResetPtr() {
-  raw_ptr_ = nullptr;
-  rw_lock_ = nullptr;
-  is_null_ = nullptr;
-  observer_cnt_ = nullptr;
+ObservedAsync<T>::ReadGuard::ReadGuard(const T* raw_ptr,
+                                       ObservedAsyncBlock* block)
+    : raw_ptr_(raw_ptr), block_(block) {
+  MIRAGE_DCHECK(raw_ptr_ != nullptr);
 }
 
 template <typename T>
-ObservedAsync<T>::ReadGuard::ReadGuard(const T* raw_ptr,
-                                       base::ReadGuard&& rw_lock)
-    : raw_ptr_(raw_ptr), read_guard_(std::move(rw_lock)) {
-  MIRAGE_DCHECK(raw_ptr_ != nullptr);
+ObservedAsync<T>::ReadGuard::~ReadGuard() {
+  if (block_) {
+    block_->UnlockRead();
+  }
 }
 
 template <typename T>
 ObservedAsync<T>::ReadGuard::ReadGuard(ReadGuard&& other) noexcept
-    : raw_ptr_(other.raw_ptr_), read_guard_(std::move(other.read_guard_)) {
+    : raw_ptr_(other.raw_ptr_), block_(other.block_) {
   other.raw_ptr_ = nullptr;
+  other.block_ = nullptr;
 }
 
 template <typename T>
@@ -855,15 +878,23 @@ const T& ObservedAsync<T>::ReadGuard::operator*() const {
 }
 
 template <typename T>
-ObservedAsync<T>::WriteGuard::WriteGuard(T* raw_ptr, base::WriteGuard&& rw_lock)
-    : raw_ptr_(raw_ptr), write_guard_(std::move(rw_lock)) {
+ObservedAsync<T>::WriteGuard::WriteGuard(T* raw_ptr, ObservedAsyncBlock* block)
+    : raw_ptr_(raw_ptr), block_(block) {
   MIRAGE_DCHECK(raw_ptr_ != nullptr);
 }
 
+template <typename T>
+ObservedAsync<T>::WriteGuard::~WriteGuard() {
+  if (block_) {
+    block_->UnlockWrite();
+  }
+}
+
 template <typename T>
 ObservedAsync<T>::WriteGuard::WriteGuard(WriteGuard&& other) noexcept
-    : raw_ptr_(other.raw_ptr_), write_guard_(std::move(other.write_guard_)) {
+    : raw_ptr_(other.raw_ptr_), block_(other.block_) {
   other.raw_ptr_ = nullptr;
+  other.block_ = nullptr;
 }
 
 template <typename T>
@@ -1,53 +1,124 @@
 ﻿#ifndef MIRAGE_BASE_AUTO_PTR_REF_COUNT
 #define MIRAGE_BASE_AUTO_PTR_REF_COUNT
 
+#include <atomic>
 #include <concepts>
-
-#include "mirage_base/define/export.hpp"
-#include "mirage_base/sync/lock.hpp"
+#include <cstddef>
 
 namespace mirage::base {
 
-class MIRAGE_BASE RefCount {
- public:
-  virtual ~RefCount() = default;
-  [[nodiscard]] virtual size_t cnt() const = 0;
-  virtual void Increase() = 0;
-  virtual bool TryIncrease() = 0;
-  virtual bool TryRelease() = 0;
-};
+// Reference counters are concrete, header-only classes so that the owning
+// smart pointers can inline every count operation.
 
-class MIRAGE_BASE RefCountLocal : public RefCount {
+class RefCountLocal {
  public:
-  explicit RefCountLocal(size_t cnt);
-  ~RefCountLocal() override = default;
-  [[nodiscard]] size_t cnt() const override;
-  void Increase() override;
-  bool TryIncrease() override;
-  bool TryRelease() override;
+  explicit RefCountLocal(const size_t cnt) : cnt_(cnt) {}
+
+  [[nodiscard]] size_t cnt() const { return cnt_; }
+
+  void Increase() { cnt_ += 1; }
+
+  bool TryIncrease() {
+    if (cnt_ == 0) {
+      return false;
+    }
+    cnt_ += 1;
+    return true;
+  }
+
+  bool TryRelease() {
+    if (cnt_ == 0) {
+      return true;
+    }
+    cnt_ -= 1;
+    return cnt_ == 0;
+  }
 
  private:
   size_t cnt_{0};
 };
 
-class MIRAGE_BASE RefCountAsync final : public RefCountLocal {
+class RefCountAsync {
  public:
-  explicit RefCountAsync(size_t cnt);
-  ~RefCountAsync() override = default;
-  [[nodiscard]] size_t cnt() const override;
-  void Increase() override;
-  bool TryIncrease() override;
-  bool TryRelease() override;
+  explicit RefCountAsync(const size_t cnt) : cnt_(cnt) {}
+
+  RefCountAsync(const RefCountAsync&) = delete;
+  RefCountAsync& operator=(const RefCountAsync&) = delete;
+
+  [[nodiscard]] size_t cnt() const {
+    return cnt_.load(std::memory_order_acquire);
+  }
+
+  // A new reference is always made from an existing one, which already keeps
+  // the object alive, so the increment needs no ordering.
+  void Increase() { cnt_.fetch_add(1, std::memory_order_relaxed); }
+
+  // Take a reference only while the count is not zero, e.g. to upgrade a
+  // weak pointer.
+  bool TryIncrease() {
+    auto cnt = cnt_.load(std::memory_order_relaxed);
+    do {
+      if (cnt == 0) {
+        return false;
+      }
+    } while (!cnt_.compare_exchange_weak(cnt, cnt + 1,
+                                         std::memory_order_acquire,
+                                         std::memory_order_relaxed));
+    return true;
+  }
+
+  // Writes made through a released reference must happen before the object
+  // is destroyed by whoever drops the last one. Releasing a count that is
+  // already zero is a no-op, which only the last owner may rely on.
+  bool TryRelease() {
+    if (cnt_.load(std::memory_order_relaxed) == 0) {
+      return true;
+    }
+    if (cnt_.fetch_sub(1, std::memory_order_release) != 1) {
+      return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return true;
+  }
 
  private:
-  mutable Lock lock_;
+  std::atomic<size_t> cnt_{0};
 };
 
 template <typename R>
-concept IsRefCount = std::derived_from<R, RefCount> && requires(R r) {
+concept IsRefCount = requires(R r, const R& cr) {
   { new R(0) } -> std::same_as<R*>;
+  { cr.cnt() } -> std::same_as<size_t>;
+  r.Increase();
+  { r.TryIncrease() } -> std::same_as<bool>;
+  { r.TryRelease() } -> std::same_as<bool>;
+};
+
+// Base of types that embed their own strong count. `Shared` points straight
+// at such objects and needs no control block, but they can't be observed by
+// `Weak`.
+template <IsRefCount R>
+class RefCounted {
+ public:
+  RefCounted() = default;
+  ~RefCounted() = default;
+
+  // The count belongs to the allocation, not to the value.
+  RefCounted(const RefCounted&) {}
+  RefCounted& operator=(const RefCounted&) { return *this; }
+
+  [[nodiscard]] size_t ref_cnt() const { return ref_cnt_.cnt(); }
+
+ private:
+  template <typename T, IsRefCount R1>
+  friend class Shared;
+
+  mutable R ref_cnt_{0};
 };
 
+template <typename T, typename R>
+concept IsIntrusive = std::derived_from<T, RefCounted<R>>;
+
 }  // namespace mirage::base
 
 #endif  // MIRAGE_BASE_AUTO_PTR_REF_COUNT
@@ -2,8 +2,11 @@
 #define MIRAGE_BASE_AUTO_PTR_SHARED
 
 #include <cstddef>
+#include <type_traits>
+#include <utility>
 
 #include "mirage_base/auto_ptr/ref_count.hpp"
+#include "mirage_base/auto_ptr/shared_block.hpp"
 #include "mirage_base/define/check.hpp"
 
 namespace mirage::base {
@@ -11,8 +14,29 @@ namespace mirage::base {
 template <typename T, IsRefCount R>
 class Weak;
 
+// The object a non-intrusive handle points to, kept next to its block since a
+// conversion may move it away from where the block holds the object, e.g. to
+// a base other than the first.
+template <typename T, bool kHasObject>
+class SharedObject {
+ protected:
+  T* object_{nullptr};
+};
+
+template <typename T>
+class SharedObject<T, false> {};
+
+// Reference counted pointer.
+//
+// `Shared` points to a `SharedBlock` holding both counts, which `New`
+// allocates together with the object, and to the object itself. Types deriving
+// from `RefCounted` carry the count themselves and are pointed to directly, so
+// their handles are one pointer in size.
 template <typename T, IsRefCount R>
-class Shared {
+class Shared : SharedObject<T, !IsIntrusive<T, R>> {
+  constexpr static bool kIsIntrusive = IsIntrusive<T, R>;
+  using Pointer = std::conditional_t<kIsIntrusive, T*, SharedBlock<R>*>;
+
  public:
   Shared() = default;
   ~Shared();
@@ -57,12 +81,14 @@ class Shared {
  private:
   friend class Weak<T, R>;
 
-  Shared(T* raw_ptr, RefCount* ref_cnt_ptr, RefCount* weak_ref_cnt_ptr);
-  void ResetPtr();
+  // Take over a reference that is already counted.
+  static Shared Adopt(SharedBlock<R>* block, T* object);
+  // Hand the reference over to a handle pointing to `object`.
+  template <typename T1>
+  Shared<T1, R> MoveTo(T1* object);
+  R& ref_cnt_ref() const;
 
-  T* raw_ptr_{nullptr};
-  RefCount* ref_cnt_ptr_{nullptr};
-  RefCount* weak_ref_cnt_ptr_{nullptr};
+  Pointer ptr_{nullptr};
 };
 
 template <typename T>
@@ -77,11 +103,11 @@ Shared<T, R>::~Shared() {
 }
 
 template <typename T, IsRefCount R>
-Shared<T, R>::Shared(Shared&& other) noexcept
-    : raw_ptr_(other.raw_ptr_),
-      ref_cnt_ptr_(other.ref_cnt_ptr_),
-      weak_ref_cnt_ptr_(other.weak_ref_cnt_ptr_) {
-  other.ResetPtr();
+Shared<T, R>::Shared(Shared&& other) noexcept : ptr_(other.ptr_) {
+  if constexpr (!kIsIntrusive) {
+    this->object_ = std::exchange(other.object_, nullptr);
+  }
+  other.ptr_ = nullptr;
 }
 
 template <typename T, IsRefCount R>
@@ -95,8 +121,15 @@ Shared<T, R>& Shared<T, R>::operator=(Shared&& other) noexcept {
 }
 
 template <typename T, IsRefCount R>
-Shared<T, R>::Shared(T* raw_ptr) : Shared(raw_ptr, new R(1), new R(0)) {
+Shared<T, R>::Shared(T* raw_ptr) {
   MIRAGE_DCHECK(raw_ptr != nullptr);
+  if constexpr (kIsIntrusive) {
+    ptr_ = raw_ptr;
+    ptr_->ref_cnt_.Increase();
+  } else {
+    ptr_ = new SharedRawBlock<T, SharedBlock<R>>(raw_ptr);
+    this->object_ = raw_ptr;
+  }
 }
 
 template <typename T, IsRefCount R>
@@ -104,14 +137,18 @@ Shared<T, R>::Shared(std::nullptr_t) {}
 
 template <typename T, IsRefCount R>
 void Shared<T, R>::Reset() {
-  if (ref_cnt_ptr_ && ref_cnt_ptr_->TryRelease()) {
-    delete raw_ptr_;
-    if (weak_ref_cnt_ptr_->cnt() == 0) {
-      delete ref_cnt_ptr_;
-      delete weak_ref_cnt_ptr_;
+  if (ptr_ == nullptr) {
+    return;
+  }
+  if constexpr (kIsIntrusive) {
+    if (ptr_->ref_cnt_.TryRelease()) {
+      delete ptr_;
     }
+  } else {
+    ptr_->Release();
+    this->object_ = nullptr;
   }
-  ResetPtr();
+  ptr_ = nullptr;
 }
 
 template <typename T, IsRefCount R>
@@ -123,88 +160,129 @@ Shared<T, R>& Shared<T, R>::operator=(std::nullptr_t) {
 template <typename T, IsRefCount R>
 template <typename... Args>
 Shared<T, R> Shared<T, R>::New(Args&&... args) {
-  return Shared(new T(std::forward<Args>(args)...));
+  if constexpr (kIsIntrusive) {
+    return Shared(new T(std::forward<Args>(args)...));
+  } else {
+    auto* block =
+        new SharedInlineBlock<T, SharedBlock<R>>(std::forward<Args>(args)...);
+    return Adopt(block, static_cast<T*>(block->object()));
+  }
 }
 
 template <typename T, IsRefCount R>
 Shared<T, R> Shared<T, R>::Clone() const {
-  if (ref_cnt_ptr_ && ref_cnt_ptr_->TryIncrease()) {
-    return Shared(raw_ptr_, ref_cnt_ptr_, weak_ref_cnt_ptr_);
+  if (ptr_ == nullptr) {
+    return nullptr;
+  }
+  if constexpr (kIsIntrusive) {
+    return Shared(ptr_);
+  } else {
+    ref_cnt_ref().Increase();
+    return Adopt(ptr_, this->object_);
   }
-  return nullptr;
 }
 
 template <typename T, IsRefCount R>
 template <typename T1>
 Shared<T1, R> Shared<T, R>::TryConvert() {
-  T1* raw_ptr = dynamic_cast<T1*>(raw_ptr_);
+  T1* raw_ptr = dynamic_cast<T1*>(this->raw_ptr());
   if (raw_ptr == nullptr) {
     return nullptr;
   }
-  return std::move(*this).template Convert<T1>();
+  return MoveTo(raw_ptr);
 }
 
 template <typename T, IsRefCount R>
 template <typename T1>
 Shared<T1, R> Shared<T, R>::Convert() && {
-  auto rv = Shared<T1, R>(static_cast<T1*>(raw_ptr_), ref_cnt_ptr_,
-                          weak_ref_cnt_ptr_);
-  ResetPtr();
-  return rv;
+  return MoveTo(static_cast<T1*>(raw_ptr()));
 }
 
 template <typename T, IsRefCount R>
 T* Shared<T, R>::operator->() const {
-  return raw_ptr_;
+  return raw_ptr();
 }
 
 template <typename T, IsRefCount R>
 T& Shared<T, R>::operator*() const {
-  return *raw_ptr_;
+  return *raw_ptr();
 }
 
 template <typename T, IsRefCount R>
 T* Shared<T, R>::raw_ptr() const {
-  return raw_ptr_;
+  if constexpr (kIsIntrusive) {
+    return ptr_;
+  } else {
+    return this->object_;
+  }
 }
 
 template <typename T, IsRefCount R>
 Shared<T, R>::operator bool() const {
-  return raw_ptr_ != nullptr;
+  return ptr_ != nullptr;
 }
 
 template <typename T, IsRefCount R>
 bool Shared<T, R>::operator==(std::nullptr_t) const {
-  return raw_ptr_ == nullptr;
+  return ptr_ == nullptr;
 }
 
 template <typename T, IsRefCount R>
 bool Shared<T, R>::is_null() const {
-  return raw_ptr_ == nullptr;
+  return ptr_ == nullptr;
 }
 
 template <typename T, IsRefCount R>
 size_t Shared<T, R>::ref_cnt() const {
-  return ref_cnt_ptr_->cnt();
+  return ref_cnt_ref().cnt();
 }
 
 template <typename T, IsRefCount R>
 size_t Shared<T, R>::weak_ref_cnt() const {
-  return weak_ref_cnt_ptr_->cnt();
+  if constexpr (kIsIntrusive) {
+    return 0;
+  } else {
+    // Don't count the weak reference held by the strong ones.
+    return ptr_->weak_ref_cnt().cnt() - 1;
+  }
 }
 
 template <typename T, IsRefCount R>
-Shared<T, R>::Shared(T* raw_ptr, RefCount* ref_cnt_ptr,
-                     RefCount* weak_ref_cnt_ptr)
-    : raw_ptr_(raw_ptr),
-      ref_cnt_ptr_(ref_cnt_ptr),
-      weak_ref_cnt_ptr_(weak_ref_cnt_ptr) {}
+Shared<T, R> Shared<T, R>::Adopt(SharedBlock<R>* block, T* object) {
+  static_assert(!kIsIntrusive);
+  Shared rv;
+  rv.ptr_ = block;
+  rv.object_ = object;
+  return rv;
+}
 
 template <typename T, IsRefCount R>
-void Shared<T, R>::ResetPtr() {
-  raw_ptr_ = nullptr;
-  ref_cnt_ptr_ = nullptr;
-  weak_ref_cnt_ptr_ = nullptr;
+template <typename T1>
+Shared<T1, R> Shared<T, R>::MoveTo(T1* object) {
+  static_assert(kIsIntrusive == Shared<T1, R>::kIsIntrusive);
+  if (ptr_ == nullptr) {
+    return nullptr;
+  }
+
+  Shared<T1, R> rv;
+  if constexpr (kIsIntrusive) {
+    rv.ptr_ = object;
+  } else {
+    rv.ptr_ = ptr_;
+    rv.object_ = object;
+    this->object_ = nullptr;
+  }
+  ptr_ = nullptr;
+  return rv;
+}
+
+template <typename T, IsRefCount R>
+R& Shared<T, R>::ref_cnt_ref() const {
+  if constexpr (kIsIntrusive) {
+    return ptr_->ref_cnt_;
+  } else {
+    return ptr_->ref_cnt();
+  }
 }
 
 }  // namespace mirage::base
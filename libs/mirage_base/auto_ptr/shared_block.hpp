@@ -0,0 +1,105 @@
+﻿#ifndef MIRAGE_BASE_AUTO_PTR_SHARED_BLOCK
+#define MIRAGE_BASE_AUTO_PTR_SHARED_BLOCK
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#include "mirage_base/auto_ptr/ref_count.hpp"
+
+namespace mirage::base {
+
+// Control block shared by `Shared` and `Weak`.
+//
+// All strong references together hold one weak reference, so the object is
+// destroyed when the strong count drops to zero and the block itself is freed
+// once the weak count follows.
+template <IsRefCount R>
+class SharedBlock {
+ public:
+  enum class Action {
+    kDestroy,
+    kDeallocate,
+  };
+
+  using RefCount = R;
+  using Handler = void (*)(Action action, SharedBlock* block);
+
+  SharedBlock(void* object, const Handler handler)
+      : ref_cnt_(1), weak_ref_cnt_(1), object_(object), handler_(handler) {}
+
+  SharedBlock(const SharedBlock&) = delete;
+  SharedBlock& operator=(const SharedBlock&) = delete;
+
+  void Release() {
+    if (ref_cnt_.TryRelease()) {
+      handler_(Action::kDestroy, this);
+      ReleaseWeak();
+    }
+  }
+
+  void ReleaseWeak() {
+    if (weak_ref_cnt_.TryRelease()) {
+      handler_(Action::kDeallocate, this);
+    }
+  }
+
+  R& ref_cnt() { return ref_cnt_; }
+  R& weak_ref_cnt() { return weak_ref_cnt_; }
+  [[nodiscard]] void* object() const { return object_; }
+
+ private:
+  R ref_cnt_;
+  R weak_ref_cnt_;
+  void* object_;
+  Handler handler_;
+};
+
+// Block allocated together with the object by `New`. `Block` is
+// `SharedBlock` or a block extending it.
+template <typename T, typename Block>
+class SharedInlineBlock final : public Block {
+  using Action = typename Block::Action;
+  using BaseBlock = SharedBlock<typename Block::RefCount>;
+
+ public:
+  template <typename... Args>
+  explicit SharedInlineBlock(Args&&... args) : Block(storage_, &Handle) {
+    new (storage_) T(std::forward<Args>(args)...);
+  }
+
+ private:
+  static void Handle(const Action action, BaseBlock* block) {
+    auto* self = static_cast<SharedInlineBlock*>(block);
+    if (action == Action::kDestroy) {
+      std::launder(reinterpret_cast<T*>(self->storage_))->~T();
+    } else {
+      delete self;
+    }
+  }
+
+  alignas(T) std::byte storage_[sizeof(T)];
+};
+
+// Block adopting an object that was allocated on its own.
+template <typename T, typename Block>
+class SharedRawBlock final : public Block {
+  using Action = typename Block::Action;
+  using BaseBlock = SharedBlock<typename Block::RefCount>;
+
+ public:
+  explicit SharedRawBlock(T* raw_ptr) : Block(raw_ptr, &Handle) {}
+
+ private:
+  static void Handle(const Action action, BaseBlock* block) {
+    if (action == Action::kDestroy) {
+      delete static_cast<T*>(block->object());
+    } else {
+      delete static_cast<SharedRawBlock*>(block);
+    }
+  }
+};
+
+}  // namespace mirage::base
+
+#endif  // MIRAGE_BASE_AUTO_PTR_SHARED_BLOCK
@@ -1,8 +1,12 @@
 ﻿#ifndef MIRAGE_BASE_AUTO_PTR_WEAK
 #define MIRAGE_BASE_AUTO_PTR_WEAK
 
+#include <cstddef>
+#include <utility>
+
 #include "mirage_base/auto_ptr/ref_count.hpp"
 #include "mirage_base/auto_ptr/shared.hpp"
+#include "mirage_base/auto_ptr/shared_block.hpp"
 #include "mirage_base/define/check.hpp"
 
 namespace mirage::base {
@@ -49,12 +53,11 @@ class Weak {
   [[nodiscard]] size_t weak_ref_cnt() const;
 
  private:
-  Weak(T* raw_ptr, RefCount* ref_cnt_ptr, RefCount* weak_ref_cnt_ptr);
-  void ResetPtr();
+  static_assert(!IsIntrusive<T, R>, "Intrusive counts have no weak count");
 
-  T* raw_ptr_{nullptr};
-  RefCount* ref_cnt_ptr_{nullptr};
-  RefCount* weak_ref_cnt_ptr_{nullptr};
+  SharedBlock<R>* block_{nullptr};
+  // See `SharedObject`.
+  T* object_{nullptr};
 };
 
 template <typename T>
@@ -70,11 +73,8 @@ Weak<T, R>::~Weak() {
 
 template <typename T, IsRefCount R>
 Weak<T, R>::Weak(Weak&& other) noexcept
-    : raw_ptr_(other.raw_ptr_),
-      ref_cnt_ptr_(other.ref_cnt_ptr_),
-      weak_ref_cnt_ptr_(other.weak_ref_cnt_ptr_) {
-  other.ResetPtr();
-}
+    : block_(std::exchange(other.block_, nullptr)),
+      object_(std::exchange(other.object_, nullptr)) {}
 
 template <typename T, IsRefCount R>
 Weak<T, R>& Weak<T, R>::operator=(Weak&& other) noexcept {
@@ -88,14 +88,11 @@ Weak<T, R>& Weak<T, R>::operator=(Weak&& other) noexcept {
 
 template <typename T, IsRefCount R>
 Weak<T, R>::Weak(const Shared<T, R>& other)
-    : raw_ptr_(other.raw_ptr_),
-      ref_cnt_ptr_(other.ref_cnt_ptr_),
-      weak_ref_cnt_ptr_(other.weak_ref_cnt_ptr_) {
-  if (is_null()) {
+    : block_(other.ptr_), object_(other.object_) {
+  if (block_ == nullptr) {
     return;
   }
-  MIRAGE_DCHECK(weak_ref_cnt_ptr_ != nullptr);
-  weak_ref_cnt_ptr_->Increase();
+  block_->weak_ref_cnt().Increase();
 }
 
 template <typename T, IsRefCount R>
@@ -109,53 +106,58 @@ Weak<T, R>& Weak<T, R>::operator=(std::nullptr_t) {
 
 template <typename T, IsRefCount R>
 void Weak<T, R>::Reset() {
-  if (weak_ref_cnt_ptr_ && weak_ref_cnt_ptr_->TryRelease() &&
-      ref_cnt_ptr_->cnt() == 0) {
-    delete ref_cnt_ptr_;
-    delete weak_ref_cnt_ptr_;
+  if (block_) {
+    block_->ReleaseWeak();
   }
-  ResetPtr();
+  block_ = nullptr;
+  object_ = nullptr;
 }
 
 template <typename T, IsRefCount R>
 Weak<T, R> Weak<T, R>::Clone() const {
-  if (weak_ref_cnt_ptr_) {
-    weak_ref_cnt_ptr_->Increase();
-    return Weak(raw_ptr_, ref_cnt_ptr_, weak_ref_cnt_ptr_);
+  Weak rv;
+  if (block_) {
+    block_->weak_ref_cnt().Increase();
+    rv.block_ = block_;
+    rv.object_ = object_;
   }
-  return nullptr;
+  return rv;
 }
 
 template <typename T, IsRefCount R>
 template <typename T1>
 Weak<T1, R> Weak<T, R>::TryConvert() {
-  T1* raw_ptr = dynamic_cast<T1*>(raw_ptr_);
+  T1* raw_ptr = dynamic_cast<T1*>(this->raw_ptr());
   if (raw_ptr == nullptr) {
     return nullptr;
   }
-  return std::move(*this).template Convert<T1>();
+  Weak<T1, R> rv;
+  rv.block_ = std::exchange(block_, nullptr);
+  rv.object_ = raw_ptr;
+  object_ = nullptr;
+  return rv;
 }
 
 template <typename T, IsRefCount R>
 template <typename T1>
 Weak<T1, R> Weak<T, R>::Convert() && {
-  auto rv =
-      Weak<T1, R>(static_cast<T1*>(raw_ptr_), ref_cnt_ptr_, weak_ref_cnt_ptr_);
-  ResetPtr();
+  Weak<T1, R> rv;
+  rv.block_ = std::exchange(block_, nullptr);
+  rv.object_ = static_cast<T1*>(std::exchange(object_, nullptr));
   return rv;
 }
 
 template <typename T, IsRefCount R>
 Shared<T, R> Weak<T, R>::TryUpgrade() const {
-  if (ref_cnt_ptr_ && ref_cnt_ptr_->TryIncrease()) {
-    return Shared<T, R>(raw_ptr_, ref_cnt_ptr_, weak_ref_cnt_ptr_);
+  if (block_ && block_->ref_cnt().TryIncrease()) {
+    return Shared<T, R>::Adopt(block_, object_);
   }
   return nullptr;
 }
 
 template <typename T, IsRefCount R>
 T* Weak<T, R>::raw_ptr() const {
-  return raw_ptr_;
+  return object_;
 }
 
 template <typename T, IsRefCount R>
@@ -170,30 +172,19 @@ bool Weak<T, R>::operator==(std::nullptr_t) const {
 
 template <typename T, IsRefCount R>
 bool Weak<T, R>::is_null() const {
-  return ref_cnt_ptr_ == nullptr || ref_cnt_ptr_->cnt() == 0;
+  return block_ == nullptr || block_->ref_cnt().cnt() == 0;
 }
 
 template <typename T, IsRefCount R>
 size_t Weak<T, R>::ref_cnt() const {
-  return ref_cnt_ptr_->cnt();
+  return block_->ref_cnt().cnt();
 }
 
 template <typename T, IsRefCount R>
 size_t Weak<T, R>::weak_ref_cnt() const {
-  return weak_ref_cnt_ptr_->cnt();
-}
-
-template <typename T, IsRefCount R>
-Weak<T, R>::Weak(T* raw_ptr, RefCount* ref_cnt_ptr, RefCount* weak_ref_cnt_ptr)
-    : raw_ptr_(raw_ptr),
-      ref_cnt_ptr_(ref_cnt_ptr),
-      weak_ref_cnt_ptr_(weak_ref_cnt_ptr) {}
-
-template <typename T, IsRefCount R>
-void Weak<T, R>::ResetPtr() {
-  raw_ptr_ = nullptr;
-  ref_cnt_ptr_ = nullptr;
-  weak_ref_cnt_ptr_ = nullptr;
+  // Don't count the weak reference held by the strong ones.
+  const size_t weak_ref_cnt = block_->weak_ref_cnt().cnt();
+  return block_->ref_cnt().cnt() == 0 ? weak_ref_cnt : weak_ref_cnt - 1;
 }
 
 }  // namespace mirage::base
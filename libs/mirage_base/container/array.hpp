@@ -4,14 +4,26 @@
 #include <concepts>
 #include <initializer_list>
 #include <iterator>
+#include <type_traits>
 
 #include "mirage_base/define/check.hpp"
+#include "mirage_base/memory/alloc_hook.hpp"
+#include "mirage_base/util/relocate.hpp"
 #include "mirage_base/wrap/place_holder.hpp"
 
 namespace mirage::base {
 
 // TODO: fmt Array
 
+// Capacity a full array of `T` grows to. Specialize it to change the growth
+// factor of one element type.
+template <typename T>
+struct ArrayGrowth {
+  constexpr size_t operator()(const size_t capacity) const {
+    return capacity == 0 ? 1 : capacity * 2;
+  }
+};
+
 template <std::move_constructible T>
 class Array {
  public:
@@ -64,12 +76,19 @@ class Array {
 
   bool operator==(const Array& other) const;
 
+  // Grows at least by the growth factor, so reserving before every push stays
+  // amortized. Use `ReserveExact` when the final size is known.
   void Reserve(size_t capacity);
+  void ReserveExact(size_t capacity);
 
   T* data() const;
 
   [[nodiscard]] size_t size() const;
   void set_size(size_t size);
+  // Change the size without constructing the new elements, they have to be
+  // written through `data()` before being read.
+  void ResizeUninitialized(size_t size)
+    requires std::is_trivially_copyable_v<T>;
   [[nodiscard]] bool empty() const;
 
   [[nodiscard]] size_t capacity() const;
@@ -184,7 +203,7 @@ template <std::move_constructible T>
 Array<T>::Array(const Array& other)
   requires std::copy_constructible<T>
 {
-  Reserve(other.size_);
+  ReserveExact(other.size_);
   for (const T& val : other) {
     Push(val);
   }
@@ -194,9 +213,18 @@ template <std::move_constructible T>
 Array<T>& Array<T>::operator=(const Array& other)
   requires std::copy_constructible<T>
 {
-  if (this != &other) {
+  if (this == &other) {
+    return *this;
+  }
+  if (capacity_ < other.size_) {
     Clear();
     new (this) Array(other);
+    return *this;
+  }
+  // Keep the storage, e.g. for arrays refreshed every frame.
+  set_size(0);
+  for (const T& val : other) {
+    Push(val);
   }
   return *this;
 }
@@ -222,7 +250,7 @@ template <std::move_constructible T>
 Array<T>::Array(std::initializer_list<T> list)
   requires std::copy_constructible<T>
 {
-  Reserve(list.size());
+  ReserveExact(list.size());
   for (const T& val : list) {
     Push(val);
   }
@@ -238,6 +266,9 @@ void Array<T>::Clear() {
   for (size_t i = 0; i < size_; ++i) {
     data_[i].ptr()->~T();
   }
+  if (data_) {
+    MIRAGE_FREE_RECORD("array", capacity_ * sizeof(PlaceHolder<T>));
+  }
   delete[] data_;
   data_ = nullptr;
   size_ = 0;
@@ -270,12 +301,7 @@ void Array<T>::Insert(const size_t index, Args&&... args) {
   }
 
   EnsureNotFull();
-  new (data_[size_].ptr()) T(std::move(data_[size_ - 1].ref()));
-  for (size_t i = size_ - 1; i > index; --i) {
-    data_[i].ptr()->~T();
-    new (data_[i].ptr()) T(std::move(data_[i - 1].ref()));
-  }
-
+  Relocate(data() + index + 1, data() + index, size_ - index);
   new (data_[index].ptr()) T(std::forward<Args>(args)...);
   ++size_;
 }
@@ -316,10 +342,9 @@ T Array<T>::Pop() {
 template <std::move_constructible T>
 void Array<T>::Remove(size_t index) {
   MIRAGE_DCHECK(index < size_);
+  data_[index].ptr()->~T();
+  Relocate(data() + index, data() + index + 1, size_ - index - 1);
   --size_;
-  for (size_t i = index; i < size_; ++i) {
-    (*this)[i] = (*this)[i + 1];
-  }
 }
 
 template <std::move_constructible T>
@@ -394,6 +419,15 @@ bool Array<T>::operator==(const Array& other) const {
 
 template <std::move_constructible T>
 void Array<T>::Reserve(const size_t capacity) {
+  if (capacity <= capacity_) {
+    return;
+  }
+  const size_t grown = ArrayGrowth<T>{}(capacity_);
+  set_capacity(capacity > grown ? capacity : grown);
+}
+
+template <std::move_constructible T>
+void Array<T>::ReserveExact(const size_t capacity) {
   if (capacity <= capacity_) {
     return;
   }
@@ -434,6 +468,14 @@ void Array<T>::set_size(const size_t size) {
   }
 }
 
+template <std::move_constructible T>
+void Array<T>::ResizeUninitialized(const size_t size)
+  requires std::is_trivially_copyable_v<T>
+{
+  Reserve(size);
+  size_ = size;
+}
+
 template <std::move_constructible T>
 bool Array<T>::empty() const {
   return size_ == 0;
@@ -450,17 +492,18 @@ void Array<T>::set_capacity(const size_t capacity) {
     return;
   }
 
-  auto* data = new PlaceHolder<T>[capacity]();
-  const size_t size = capacity < size_ ? capacity : size_;
-  for (size_t i = 0; i < size; ++i) {
-    T* ptr = data_[i].ptr();
-    new (data[i].ptr()) T(std::move(*ptr));
-    ptr->~T();
+  while (size_ > capacity) {
+    RemoveTail();
+  }
+  auto* data = new PlaceHolder<T>[capacity];
+  MIRAGE_ALLOC_RECORD("array", capacity * sizeof(PlaceHolder<T>));
+  Relocate(data->ptr(), this->data(), size_);
+  if (data_) {
+    MIRAGE_FREE_RECORD("array", capacity_ * sizeof(PlaceHolder<T>));
   }
   delete[] data_;
 
   data_ = data;
-  size_ = size;
   capacity_ = capacity;
 }
 
@@ -491,11 +534,10 @@ typename Array<T>::ConstIterator Array<T>::end() const {
 
 template <std::move_constructible T>
 void Array<T>::EnsureNotFull() {
-  if (capacity_ == 0) {
-    capacity_ = 1;
-    data_ = new PlaceHolder<T>[1]();
-  } else if (size_ == capacity_) {
-    set_capacity(2 * capacity_);
+  if (size_ == capacity_) {
+    const size_t capacity = ArrayGrowth<T>{}(capacity_);
+    MIRAGE_DCHECK(capacity > capacity_);
+    set_capacity(capacity);
   }
 }
 
@@ -7,6 +7,7 @@
 
 #include "mirage_base/container/array.hpp"
 #include "mirage_base/container/singly_linked_list.hpp"
+#include "mirage_base/memory/alloc_hook.hpp"
 #include "mirage_base/util/hash.hpp"
 #include "mirage_base/wrap/optional.hpp"
 
@@ -221,6 +222,7 @@ Optional<T> HashSet<T>::Insert(T val) {
 
   ++size_;
   if (buckets_.empty()) {
+    MIRAGE_ALLOC_DEFAULT_TAG("hash_set.bucket");
     buckets_.set_size(16);
   }
   if (const float load_factor = static_cast<float>(size_) / buckets_.size();
@@ -231,6 +233,7 @@ Optional<T> HashSet<T>::Insert(T val) {
   const size_t hash = hasher_(val);
   const size_t mask = buckets_.size() - 1;
   auto& bucket = buckets_[hash & mask];
+  MIRAGE_ALLOC_DEFAULT_TAG("hash_set.entry");
   bucket.EmplaceHead(Entry{std::move(val), hash});
   return Optional<T>::None();
 }
@@ -254,6 +257,7 @@ Optional<T> HashSet<T>::Remove(const T1& val) {
       continue;
     }
     auto rv = Optional<T>::New(std::move(iter->val));
+    MIRAGE_ALLOC_DEFAULT_TAG("hash_set.entry");
     if (iter_prev == iter) {
       bucket.RemoveHead();
     } else {
@@ -303,6 +307,14 @@ typename HashSet<T>::Iterator HashSet<T>::TryFind(const T1& val) {
 
 template <HashSetValType T>
 void HashSet<T>::Clear() {
+#if defined(MIRAGE_BUILD_ALLOC_TRACKING)
+  // Free the entries first so they are not counted as buckets.
+  for (auto& bucket : buckets_) {
+    MIRAGE_ALLOC_DEFAULT_TAG("hash_set.entry");
+    bucket.Clear();
+  }
+  MIRAGE_ALLOC_DEFAULT_TAG("hash_set.bucket");
+#endif
   buckets_.Clear();
   size_ = 0;
 }
@@ -379,7 +391,10 @@ void HashSet<T>::ExtendAndRehash() {
   }
 
   const size_t new_size = old_size * 2;
-  buckets_.set_size(new_size);
+  {
+    MIRAGE_ALLOC_DEFAULT_TAG("hash_set.bucket");
+    buckets_.set_size(new_size);
+  }
 
   for (size_t i = 0; i < old_size; ++i) {
     auto& bucket = buckets_[i];
@@ -388,7 +403,8 @@ void HashSet<T>::ExtendAndRehash() {
     auto iter = bucket.begin();
     auto iter_prev = iter;
     while (iter != bucket.end()) {
-      const size_t mask = new_size;
+      // The bit added to the mask decides whether the entry moves up.
+      const size_t mask = old_size;
       if (const bool into_new_bucket = (iter->hash & mask) != 0;
           !into_new_bucket) {
         iter_prev = iter;
@@ -402,8 +418,9 @@ void HashSet<T>::ExtendAndRehash() {
         iter = bucket.begin();
         iter_prev = bucket.begin();
       } else {
-        ++iter;
         new_bucket.EmplaceHead(iter_prev.RemoveAfter());
+        iter = iter_prev;
+        ++iter;
       }
     }
   }
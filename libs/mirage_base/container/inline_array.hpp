@@ -0,0 +1,504 @@
+#ifndef MIRAGE_BASE_CONTAINER_INLINE_ARRAY
+#define MIRAGE_BASE_CONTAINER_INLINE_ARRAY
+
+#include <concepts>
+#include <initializer_list>
+#include <type_traits>
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_base/define/check.hpp"
+#include "mirage_base/memory/alloc_hook.hpp"
+#include "mirage_base/util/relocate.hpp"
+#include "mirage_base/wrap/place_holder.hpp"
+
+namespace mirage::base {
+
+// An `Array` that keeps up to `N` elements in place and only spills to the heap
+// when it grows beyond that. It shares the interface and iterators of `Array`.
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+class InlineArray {
+ public:
+  using Iterator = typename Array<T>::Iterator;
+  using ConstIterator = typename Array<T>::ConstIterator;
+
+  constexpr static size_t kInlineCapacity = N;
+
+  InlineArray();
+
+  InlineArray(const InlineArray& other)
+    requires std::copy_constructible<T>;
+  InlineArray& operator=(const InlineArray& other)
+    requires std::copy_constructible<T>;
+
+  InlineArray(InlineArray&& other) noexcept;
+  InlineArray& operator=(InlineArray&& other) noexcept;
+
+  InlineArray(std::initializer_list<T> list)
+    requires std::copy_constructible<T>;
+
+  ~InlineArray() noexcept;
+  void Clear();
+
+  void Push(const T& val)
+    requires std::copy_constructible<T>;
+
+  template <typename... Args>
+  void Emplace(Args&&... args);
+
+  template <typename... Args>
+  void Insert(size_t index, Args&&... args);
+
+  [[nodiscard]] T Take(size_t index);
+  [[nodiscard]] T SwapTake(size_t index);
+  [[nodiscard]] T Pop();
+
+  void Remove(size_t index);
+  void SwapRemove(size_t index);
+  void RemoveTail();
+
+  void Swap(size_t index_a, size_t index_b);
+
+  T& operator[](size_t index);
+  T* TryGet(size_t index);
+
+  const T& operator[](size_t index) const;
+  const T* TryGet(size_t index) const;
+
+  T& Tail();
+  const T& Tail() const;
+
+  bool operator==(const InlineArray& other) const;
+
+  void Reserve(size_t capacity);
+  void ReserveExact(size_t capacity);
+
+  T* data() const;
+
+  [[nodiscard]] size_t size() const;
+  void set_size(size_t size);
+  void ResizeUninitialized(size_t size)
+    requires std::is_trivially_copyable_v<T>;
+  [[nodiscard]] bool empty() const;
+
+  // The capacity never drops below `N`.
+  [[nodiscard]] size_t capacity() const;
+  void set_capacity(size_t capacity);
+  void ShrinkToFit();
+
+  [[nodiscard]] bool is_inline() const;
+
+  Iterator begin();
+  Iterator end();
+
+  ConstIterator begin() const;
+  ConstIterator end() const;
+
+ private:
+  void EnsureNotFull();
+
+  PlaceHolder<T>* data_;
+  size_t size_{0};
+  size_t capacity_{N};
+  PlaceHolder<T> inline_data_[N];
+};
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+InlineArray<T, N>::InlineArray() : data_(inline_data_) {}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+InlineArray<T, N>::InlineArray(const InlineArray& other)
+  requires std::copy_constructible<T>
+    : data_(inline_data_) {
+  ReserveExact(other.size_);
+  for (const T& val : other) {
+    Push(val);
+  }
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+InlineArray<T, N>& InlineArray<T, N>::operator=(const InlineArray& other)
+  requires std::copy_constructible<T>
+{
+  if (this != &other) {
+    this->~InlineArray();
+    new (this) InlineArray(other);
+  }
+  return *this;
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+InlineArray<T, N>::InlineArray(InlineArray&& other) noexcept
+    : data_(inline_data_) {
+  if (other.is_inline()) {
+    // Inline elements can't be stolen, relocate them instead.
+    Relocate(data(), other.data(), other.size_);
+    size_ = other.size_;
+  } else {
+    data_ = other.data_;
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    other.data_ = other.inline_data_;
+    other.capacity_ = N;
+  }
+  other.size_ = 0;
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+InlineArray<T, N>& InlineArray<T, N>::operator=(InlineArray&& other) noexcept {
+  if (this != &other) {
+    this->~InlineArray();
+    new (this) InlineArray(std::move(other));
+  }
+  return *this;
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+InlineArray<T, N>::InlineArray(std::initializer_list<T> list)
+  requires std::copy_constructible<T>
+    : data_(inline_data_) {
+  ReserveExact(list.size());
+  for (const T& val : list) {
+    Push(val);
+  }
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+InlineArray<T, N>::~InlineArray() noexcept {
+  Clear();
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+void InlineArray<T, N>::Clear() {
+  for (size_t i = 0; i < size_; ++i) {
+    data_[i].ptr()->~T();
+  }
+  if (!is_inline()) {
+    MIRAGE_FREE_RECORD("inline_array", capacity_ * sizeof(PlaceHolder<T>));
+    delete[] data_;
+  }
+  data_ = inline_data_;
+  size_ = 0;
+  capacity_ = N;
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+void InlineArray<T, N>::Push(const T& val)
+  requires std::copy_constructible<T>
+{
+  Emplace(T(val));
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+template <typename... Args>
+void InlineArray<T, N>::Emplace(Args&&... args) {
+  EnsureNotFull();
+  new (data_[size_].ptr()) T(std::forward<Args>(args)...);
+  ++size_;
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+template <typename... Args>
+void InlineArray<T, N>::Insert(const size_t index, Args&&... args) {
+  MIRAGE_DCHECK(index <= size_);
+
+  if (index >= size_) {
+    Emplace(std::forward<Args>(args)...);
+    return;
+  }
+
+  EnsureNotFull();
+  Relocate(data() + index + 1, data() + index, size_ - index);
+  new (data_[index].ptr()) T(std::forward<Args>(args)...);
+  ++size_;
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+T InlineArray<T, N>::Take(const size_t index) {
+  MIRAGE_DCHECK(index < size_);
+  T rv = std::move((*this)[index]);
+  Remove(index);
+  return rv;
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+T InlineArray<T, N>::SwapTake(const size_t index) {
+  MIRAGE_DCHECK(index < size_);
+  Swap(index, size_ - 1);
+  return Pop();
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+T InlineArray<T, N>::Pop() {
+  MIRAGE_DCHECK(size_ != 0);
+  T rv = std::move(Tail());
+  RemoveTail();
+  return rv;
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+void InlineArray<T, N>::Remove(const size_t index) {
+  MIRAGE_DCHECK(index < size_);
+  data_[index].ptr()->~T();
+  Relocate(data() + index, data() + index + 1, size_ - index - 1);
+  --size_;
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+void InlineArray<T, N>::SwapRemove(const size_t index) {
+  MIRAGE_DCHECK(index < size_);
+  Swap(index, size_ - 1);
+  RemoveTail();
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+void InlineArray<T, N>::RemoveTail() {
+  MIRAGE_DCHECK(size_ != 0);
+  --size_;
+  data_[size_].ptr()->~T();
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+void InlineArray<T, N>::Swap(const size_t index_a, const size_t index_b) {
+  MIRAGE_DCHECK(index_a < size_);
+  MIRAGE_DCHECK(index_b < size_);
+  if (index_a == index_b) return;
+
+  T temp = std::move((*this)[index_a]);
+  (*this)[index_a] = std::move((*this)[index_b]);
+  (*this)[index_b] = std::move(temp);
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+T& InlineArray<T, N>::operator[](const size_t index) {
+  return data_[index].ref();
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+T* InlineArray<T, N>::TryGet(const size_t index) {
+  if (index >= size_) {
+    return nullptr;
+  }
+  return data_[index].ptr();
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+const T& InlineArray<T, N>::operator[](const size_t index) const {
+  return data_[index].ref();
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+const T* InlineArray<T, N>::TryGet(const size_t index) const {
+  if (index >= size_) {
+    return nullptr;
+  }
+  return data_[index].ptr();
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+T& InlineArray<T, N>::Tail() {
+  return data_[size_ - 1].ref();
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+const T& InlineArray<T, N>::Tail() const {
+  return data_[size_ - 1].ref();
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+bool InlineArray<T, N>::operator==(const InlineArray& other) const {
+  if (size_ != other.size_) {
+    return false;
+  }
+  if (data_ == other.data_) {
+    return true;
+  }
+  if constexpr (!std::equality_comparable<T>) {
+    return false;  // Can't be compared.
+  } else {
+    for (size_t i = 0; i < size_; ++i) {
+      if (data_[i].ref() != other.data_[i].ref()) {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+void InlineArray<T, N>::Reserve(const size_t capacity) {
+  if (capacity <= capacity_) {
+    return;
+  }
+  const size_t grown = ArrayGrowth<T>{}(capacity_);
+  set_capacity(capacity > grown ? capacity : grown);
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+void InlineArray<T, N>::ReserveExact(const size_t capacity) {
+  if (capacity <= capacity_) {
+    return;
+  }
+  set_capacity(capacity);
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+T* InlineArray<T, N>::data() const {
+  return reinterpret_cast<T*>(data_);
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+size_t InlineArray<T, N>::size() const {
+  return size_;
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+void InlineArray<T, N>::set_size(const size_t size) {
+  if (size == size_) {
+    return;
+  }
+  if (size < size_) {
+    while (size < size_) {
+      RemoveTail();
+    }
+    return;
+  }
+
+  if constexpr (!std::default_initializable<T>) {
+    MIRAGE_DCHECK(false);
+  } else {
+    Reserve(size);
+    while (size > size_) {
+      new (data_[size_].ptr()) T();
+      ++size_;
+    }
+  }
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+void InlineArray<T, N>::ResizeUninitialized(const size_t size)
+  requires std::is_trivially_copyable_v<T>
+{
+  Reserve(size);
+  size_ = size;
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+bool InlineArray<T, N>::empty() const {
+  return size_ == 0;
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+size_t InlineArray<T, N>::capacity() const {
+  return capacity_;
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+void InlineArray<T, N>::set_capacity(size_t capacity) {
+  if (capacity < N) {
+    capacity = N;
+  }
+  if (capacity == capacity_) {
+    return;
+  }
+
+  while (size_ > capacity) {
+    RemoveTail();
+  }
+  auto* data = capacity == N ? inline_data_ : new PlaceHolder<T>[capacity];
+  if (capacity != N) {
+    MIRAGE_ALLOC_RECORD("inline_array", capacity * sizeof(PlaceHolder<T>));
+  }
+  Relocate(data->ptr(), this->data(), size_);
+  if (!is_inline()) {
+    MIRAGE_FREE_RECORD("inline_array", capacity_ * sizeof(PlaceHolder<T>));
+    delete[] data_;
+  }
+
+  data_ = data;
+  capacity_ = capacity;
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+void InlineArray<T, N>::ShrinkToFit() {
+  set_capacity(size_);
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+bool InlineArray<T, N>::is_inline() const {
+  return data_ == inline_data_;
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+typename InlineArray<T, N>::Iterator InlineArray<T, N>::begin() {
+  return Iterator(data());
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+typename InlineArray<T, N>::Iterator InlineArray<T, N>::end() {
+  return Iterator(data() + size_);
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+typename InlineArray<T, N>::ConstIterator InlineArray<T, N>::begin() const {
+  return ConstIterator(data());
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+typename InlineArray<T, N>::ConstIterator InlineArray<T, N>::end() const {
+  return ConstIterator(data() + size_);
+}
+
+template <std::move_constructible T, size_t N>
+  requires(N > 0)
+void InlineArray<T, N>::EnsureNotFull() {
+  if (size_ == capacity_) {
+    const size_t capacity = ArrayGrowth<T>{}(capacity_);
+    MIRAGE_DCHECK(capacity > capacity_);
+    set_capacity(capacity);
+  }
+}
+
+}  // namespace mirage::base
+
+#endif  // MIRAGE_BASE_CONTAINER_INLINE_ARRAY
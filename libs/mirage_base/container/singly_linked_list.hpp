@@ -6,6 +6,7 @@
 #include <iterator>
 
 #include "mirage_base/define/check.hpp"
+#include "mirage_base/memory/alloc_hook.hpp"
 
 namespace mirage::base {
 
@@ -50,6 +51,10 @@ class SinglyLinkedList {
   ConstIterator end() const;
 
  private:
+  template <typename... Args>
+  static Node* NewNode(Args&&... args);
+  static void DeleteNode(const Node* node);
+
   Node* head_{nullptr};
 };
 
@@ -170,11 +175,11 @@ SinglyLinkedList<T>::SinglyLinkedList(const SinglyLinkedList& other)
   if (iter == other.end()) {
     return;
   }
-  Node* ptr = new Node(T(*iter));
+  Node* ptr = NewNode(T(*iter));
   head_ = ptr;
   ++iter;
   while (iter != other.end()) {
-    Node* next = new Node(T(*iter));
+    Node* next = NewNode(T(*iter));
     ptr->next = next;
     ptr = next;
     ++iter;
@@ -201,11 +206,11 @@ SinglyLinkedList<T>::SinglyLinkedList(std::initializer_list<T> list)
     return;
   }
   auto iter = list.begin();
-  Node* ptr = new Node(T(*iter));
+  Node* ptr = NewNode(T(*iter));
   head_ = ptr;
   ++iter;
   while (iter != list.end()) {
-    Node* next = new Node(T(*iter));
+    Node* next = NewNode(T(*iter));
     ptr->next = next;
     ptr = next;
     ++iter;
@@ -220,7 +225,7 @@ SinglyLinkedList<T>::~SinglyLinkedList() {
 template <std::move_constructible T>
 template <typename... Args>
 void SinglyLinkedList<T>::EmplaceHead(Args&&... args) {
-  Node* new_head = new Node(T(std::forward<Args>(args)...));
+  Node* new_head = NewNode(T(std::forward<Args>(args)...));
   new_head->next = head_;
   head_ = new_head;
 }
@@ -238,7 +243,7 @@ T SinglyLinkedList<T>::RemoveHead() {
   T val(std::move(head_->val));
   const Node* head = head_;
   head_ = head_->next;
-  delete head;
+  DeleteNode(head);
   return val;
 }
 
@@ -247,12 +252,26 @@ void SinglyLinkedList<T>::Clear() {
   Node* ptr = head_;
   while (ptr != nullptr) {
     Node* next = ptr->next;
-    delete ptr;
+    DeleteNode(ptr);
     ptr = next;
   }
   head_ = nullptr;
 }
 
+template <std::move_constructible T>
+template <typename... Args>
+typename SinglyLinkedList<T>::Node* SinglyLinkedList<T>::NewNode(
+    Args&&... args) {
+  MIRAGE_ALLOC_RECORD("singly_linked_list.node", sizeof(Node));
+  return new Node(std::forward<Args>(args)...);
+}
+
+template <std::move_constructible T>
+void SinglyLinkedList<T>::DeleteNode(const Node* node) {
+  MIRAGE_FREE_RECORD("singly_linked_list.node", sizeof(Node));
+  delete node;
+}
+
 template <std::move_constructible T>
 bool SinglyLinkedList<T>::empty() const {
   return begin() == end();
@@ -342,7 +361,7 @@ SinglyLinkedList<T>::Iterator::operator bool() const {
 template <std::move_constructible T>
 template <typename... Args>
 void SinglyLinkedList<T>::Iterator::EmplaceAfter(Args&&... args) {
-  Node* new_node = new Node(T(std::forward<Args>(args)...));
+  Node* new_node = NewNode(T(std::forward<Args>(args)...));
   new_node->next = here_->next;
   here_->next = new_node;
 }
@@ -359,8 +378,8 @@ T SinglyLinkedList<T>::Iterator::RemoveAfter() {
   MIRAGE_DCHECK(here_ != nullptr && here_->next != nullptr);
   T val(std::move(here_->next->val));
   const Node* next = here_->next;
-  here_->next = nullptr;
-  delete next;
+  here_->next = next->next;
+  DeleteNode(next);
   return val;
 }
 
@@ -0,0 +1,169 @@
+#include "mirage_base/io/byte_delta.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "mirage_base/io/byte_stream.hpp"
+
+using namespace mirage::base;
+
+// Delta layout: "MBDL", u32 version, u64 base size, u64 base hash, u64 target
+// size, then until the target is covered: varint equal run, varint literal
+// length, literal bytes XOR-ed with the base. The base counts as zero past
+// its end.
+
+namespace {
+
+constexpr char kMagic[4] = {'M', 'B', 'D', 'L'};
+constexpr uint32_t kVersion = 1;
+
+// FNV-1a, only to tell bases apart.
+uint64_t HashBytes(const uint8_t* data, const size_t size) {
+  uint64_t hash = 14695981039346656037ull;
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ data[i]) * 1099511628211ull;
+  }
+  return hash;
+}
+
+class Differ {
+ public:
+  Differ(const uint8_t* base, const size_t base_size, const uint8_t* target,
+         const size_t target_size)
+      : base_(base),
+        base_size_(base_size),
+        target_(target),
+        target_size_(target_size) {}
+
+  [[nodiscard]] uint8_t Xor(const size_t i) const {
+    return target_[i] ^ (i < base_size_ ? base_[i] : 0);
+  }
+
+  // First byte from `i` on that differs, or the target size.
+  [[nodiscard]] size_t SkipEqual(size_t i) const {
+    const auto common_size = std::min(base_size_, target_size_);
+    while (i + sizeof(uint64_t) <= common_size &&
+           std::memcmp(base_ + i, target_ + i, sizeof(uint64_t)) == 0) {
+      i += sizeof(uint64_t);
+    }
+    while (i < target_size_ && Xor(i) == 0) {
+      ++i;
+    }
+    return i;
+  }
+
+  // End of the literal starting at `i`, which stops before the next run of
+  // at least `kMinEqualRun` equal bytes.
+  [[nodiscard]] size_t SkipLiteral(size_t i) const {
+    size_t equal_cnt = 0;
+    while (i < target_size_ && equal_cnt < ByteDelta::kMinEqualRun) {
+      equal_cnt = Xor(i) == 0 ? equal_cnt + 1 : 0;
+      ++i;
+    }
+    return equal_cnt == ByteDelta::kMinEqualRun ? i - equal_cnt : i;
+  }
+
+  void WriteLiteral(ByteWriter& writer, const size_t begin,
+                    const size_t end) const {
+    uint8_t buffer[256];
+    for (size_t i = begin; i < end; i += sizeof(buffer)) {
+      const auto size = std::min(sizeof(buffer), end - i);
+      for (size_t j = 0; j < size; ++j) {
+        buffer[j] = Xor(i + j);
+      }
+      writer.WriteBytes(buffer, size);
+    }
+  }
+
+  void WriteRuns(ByteWriter& writer) const {
+    size_t i = 0;
+    while (i < target_size_) {
+      const auto literal_begin = SkipEqual(i);
+      const auto literal_end = SkipLiteral(literal_begin);
+      writer.WriteVarint(literal_begin - i);
+      writer.WriteVarint(literal_end - literal_begin);
+      WriteLiteral(writer, literal_begin, literal_end);
+      i = literal_end;
+    }
+  }
+
+ private:
+  const uint8_t* base_;
+  size_t base_size_;
+  const uint8_t* target_;
+  size_t target_size_;
+};
+
+}  // namespace
+
+Array<uint8_t> ByteDelta::Encode(const uint8_t* base, const size_t base_size,
+                                 const uint8_t* target,
+                                 const size_t target_size) {
+  ByteWriter writer;
+  writer.WriteBytes(kMagic, sizeof(kMagic));
+  writer.Write(kVersion);
+  writer.Write(static_cast<uint64_t>(base_size));
+  writer.Write(HashBytes(base, base_size));
+  writer.Write(static_cast<uint64_t>(target_size));
+
+  Differ(base, base_size, target, target_size).WriteRuns(writer);
+  return writer.TakeBytes();
+}
+
+bool ByteDelta::Apply(const uint8_t* base, const size_t base_size,
+                      const uint8_t* delta, const size_t delta_size,
+                      const size_t max_target_size, Array<uint8_t>& target) {
+  ByteReader reader(delta, delta_size);
+  char magic[sizeof(kMagic)];
+  reader.ReadBytes(magic, sizeof(magic));
+  if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      reader.Read<uint32_t>() != kVersion ||
+      reader.Read<uint64_t>() != base_size ||
+      reader.Read<uint64_t>() != HashBytes(base, base_size)) {
+    return false;
+  }
+  const auto target_size = reader.Read<uint64_t>();
+  if (!reader.is_ok() || target_size > max_target_size) {
+    return false;
+  }
+
+  target.ResizeUninitialized(target_size);
+  const auto common_size = std::min<size_t>(base_size, target_size);
+  if (common_size != 0) {
+    std::memcpy(target.data(), base, common_size);
+  }
+  if (target_size > common_size) {
+    std::memset(target.data() + common_size, 0, target_size - common_size);
+  }
+
+  return ApplyRuns(reader, target.data(), target_size) &&
+         reader.remaining() == 0;
+}
+
+void ByteDelta::EncodeRuns(const uint8_t* base, const uint8_t* target,
+                           const size_t size, ByteWriter& writer) {
+  Differ(base, size, target, size).WriteRuns(writer);
+}
+
+bool ByteDelta::ApplyRuns(ByteReader& reader, uint8_t* data,
+                          const size_t size) {
+  size_t i = 0;
+  while (i < size) {
+    const auto equal_size = reader.ReadVarint();
+    const auto literal_size = reader.ReadVarint();
+    if (!reader.is_ok() || equal_size > size - i ||
+        literal_size > size - i - equal_size) {
+      return false;
+    }
+    i += equal_size;
+    const auto* literal = reader.Skip(literal_size);
+    if (!reader.is_ok()) {
+      return false;
+    }
+    for (size_t j = 0; data && j < literal_size; ++j) {
+      data[i + j] ^= literal[j];
+    }
+    i += literal_size;
+  }
+  return true;
+}
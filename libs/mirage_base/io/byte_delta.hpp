@@ -0,0 +1,46 @@
+#ifndef MIRAGE_BASE_IO_BYTE_DELTA
+#define MIRAGE_BASE_IO_BYTE_DELTA
+
+#include <cstddef>
+#include <cstdint>
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_base/define/export.hpp"
+#include "mirage_base/io/byte_stream.hpp"
+
+namespace mirage::base {
+
+// Difference between two byte images, e.g. two snapshots of one world a few
+// ticks apart. The target is XOR-ed against the base and runs of zeros, the
+// bytes that did not change, are only stored as their length. A delta
+// remembers the size and hash of its base and refuses to apply to any other.
+class MIRAGE_BASE ByteDelta {
+ public:
+  // Equal runs shorter than this stay inside the surrounding literal, where
+  // they are cheaper than a new run header.
+  constexpr static size_t kMinEqualRun = 8;
+
+  ByteDelta() = delete;
+
+  static Array<uint8_t> Encode(const uint8_t* base, size_t base_size,
+                               const uint8_t* target, size_t target_size);
+  // Rebuild the target into `target`, false if the delta is corrupt, was
+  // made against another base or claims a target larger than
+  // `max_target_size`. Deltas from the network must be bounded that way,
+  // since runs past the end of the base cost a few bytes for any length.
+  static bool Apply(const uint8_t* base, size_t base_size,
+                    const uint8_t* delta, size_t delta_size,
+                    size_t max_target_size, Array<uint8_t>& target);
+
+  // The runs alone, for callers that keep track of the base themselves, e.g.
+  // per column of a table. `base` and `target` are both `size` bytes.
+  static void EncodeRuns(const uint8_t* base, const uint8_t* target,
+                         size_t size, ByteWriter& writer);
+  // XOR the runs read from `reader` into `data` in place, or only check them
+  // if it is null. False unless they cover exactly `size` bytes.
+  static bool ApplyRuns(ByteReader& reader, uint8_t* data, size_t size);
+};
+
+}  // namespace mirage::base
+
+#endif  // MIRAGE_BASE_IO_BYTE_DELTA
@@ -0,0 +1,99 @@
+#include "mirage_base/io/byte_stream.hpp"
+
+#include <cstdio>
+
+using namespace mirage::base;
+
+void ByteWriter::WriteBytes(const void* ptr, const size_t size) {
+  if (size == 0) {
+    return;
+  }
+  const auto offset = bytes_.size();
+  bytes_.ResizeUninitialized(offset + size);
+  std::memcpy(bytes_.data() + offset, ptr, size);
+}
+
+void ByteWriter::WriteVarint(uint64_t val) {
+  while (val >= 0x80) {
+    Write(static_cast<uint8_t>(val | 0x80));
+    val >>= 7;
+  }
+  Write(static_cast<uint8_t>(val));
+}
+
+void ByteWriter::WriteString(const std::string_view str) {
+  Write(static_cast<uint32_t>(str.size()));
+  WriteBytes(str.data(), str.size());
+}
+
+bool ByteWriter::WriteToFile(const char* path) const {
+  std::FILE* file = std::fopen(path, "wb");
+  if (!file) {
+    return false;
+  }
+  const bool is_written =
+      std::fwrite(bytes_.data(), 1, bytes_.size(), file) == bytes_.size();
+  return std::fclose(file) == 0 && is_written;
+}
+
+const Array<uint8_t>& ByteWriter::bytes() const { return bytes_; }
+
+Array<uint8_t> ByteWriter::TakeBytes() { return std::move(bytes_); }
+
+size_t ByteWriter::size() const { return bytes_.size(); }
+
+ByteReader::ByteReader(const uint8_t* data, const size_t size)
+    : data_(data), size_(size) {}
+
+bool ByteReader::ReadBytes(void* ptr, const size_t size) {
+  const auto* src = Skip(size);
+  if (!src) {
+    std::memset(ptr, 0, size);
+    return false;
+  }
+  if (size != 0) {
+    std::memcpy(ptr, src, size);
+  }
+  return true;
+}
+
+uint64_t ByteReader::ReadVarint() {
+  uint64_t val = 0;
+  for (uint32_t shift = 0; shift < 64; shift += 7) {
+    const auto byte = Read<uint8_t>();
+    if (!is_ok_) {
+      return 0;
+    }
+    val |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return val;
+    }
+  }
+  is_ok_ = false;
+  return 0;
+}
+
+std::string_view ByteReader::ReadString() {
+  const auto size = Read<uint32_t>();
+  const auto* ptr = Skip(size);
+  if (!ptr) {
+    return {};
+  }
+  return {reinterpret_cast<const char*>(ptr), size};
+}
+
+const uint8_t* ByteReader::Skip(const size_t size) {
+  if (!is_ok_ || size > remaining()) {
+    is_ok_ = false;
+    return nullptr;
+  }
+  const auto* ptr = data_ + position_;
+  position_ += size;
+  return ptr;
+}
+
+bool ByteReader::is_ok() const { return is_ok_; }
+
+size_t ByteReader::position() const { return position_; }
+
+size_t ByteReader::remaining() const { return size_ - position_; }
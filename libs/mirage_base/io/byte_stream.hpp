@@ -0,0 +1,98 @@
+#ifndef MIRAGE_BASE_IO_BYTE_STREAM
+#define MIRAGE_BASE_IO_BYTE_STREAM
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_base/define/check.hpp"
+#include "mirage_base/define/export.hpp"
+
+namespace mirage::base {
+
+// Appends values to a byte array in native byte order. Every supported
+// platform is little-endian.
+class MIRAGE_BASE ByteWriter {
+ public:
+  ByteWriter() = default;
+  ~ByteWriter() = default;
+
+  ByteWriter(const ByteWriter&) = delete;
+  ByteWriter& operator=(const ByteWriter&) = delete;
+
+  ByteWriter(ByteWriter&&) noexcept = default;
+  ByteWriter& operator=(ByteWriter&&) noexcept = default;
+
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  void Write(const T& val) {
+    WriteBytes(&val, sizeof(T));
+  }
+
+  void WriteBytes(const void* ptr, size_t size);
+  // LEB128, one byte per 7 bits, for counts that are usually small.
+  void WriteVarint(uint64_t val);
+  // Length-prefixed, without the terminator.
+  void WriteString(std::string_view str);
+
+  // Overwrite bytes written before, e.g. a count only known at the end.
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  void WriteAt(const size_t offset, const T& val) {
+    MIRAGE_DCHECK(offset + sizeof(T) <= bytes_.size());
+    std::memcpy(bytes_.data() + offset, &val, sizeof(T));
+  }
+
+  // Write everything to the file, replacing it.
+  [[nodiscard]] bool WriteToFile(const char* path) const;
+
+  [[nodiscard]] const Array<uint8_t>& bytes() const;
+  Array<uint8_t> TakeBytes();
+  [[nodiscard]] size_t size() const;
+
+ private:
+  Array<uint8_t> bytes_;
+};
+
+// Reads values written by `ByteWriter` from memory it does not own. Reading
+// past the end fails the reader instead of the process: the value read is
+// zeroed and `is_ok` turns false for good.
+class MIRAGE_BASE ByteReader {
+ public:
+  ByteReader() = default;
+  ByteReader(const uint8_t* data, size_t size);
+
+  template <typename T>
+    requires std::is_trivially_copyable_v<T> &&
+             std::is_default_constructible_v<T>
+  T Read() {
+    T val{};
+    ReadBytes(&val, sizeof(T));
+    return val;
+  }
+
+  bool ReadBytes(void* ptr, size_t size);
+  // Zero on failure, including a value that does not fit.
+  uint64_t ReadVarint();
+  // Points into the underlying memory, empty on failure.
+  std::string_view ReadString();
+  // The next `size` bytes without copying them, null on failure.
+  const uint8_t* Skip(size_t size);
+
+  [[nodiscard]] bool is_ok() const;
+  [[nodiscard]] size_t position() const;
+  [[nodiscard]] size_t remaining() const;
+
+ private:
+  const uint8_t* data_{nullptr};
+  size_t size_{0};
+  size_t position_{0};
+  bool is_ok_{true};
+};
+
+}  // namespace mirage::base
+
+#endif  // MIRAGE_BASE_IO_BYTE_STREAM
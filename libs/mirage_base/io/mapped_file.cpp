@@ -0,0 +1,30 @@
+#include "mirage_base/io/mapped_file.hpp"
+
+#include <utility>
+
+using namespace mirage::base;
+
+MappedFile::~MappedFile() { Unmap(); }
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(other.data_), size_(other.size_) {
+  other.data_ = nullptr;
+  other.size_ = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    Unmap();
+    new (this) MappedFile(std::move(other));
+  }
+  return *this;
+}
+
+const uint8_t* MappedFile::data() const { return data_; }
+
+size_t MappedFile::size() const { return size_; }
+
+bool MappedFile::is_valid() const { return data_ != nullptr; }
+
+MappedFile::MappedFile(const uint8_t* data, const size_t size)
+    : data_(data), size_(size) {}
@@ -0,0 +1,42 @@
+#ifndef MIRAGE_BASE_IO_MAPPED_FILE
+#define MIRAGE_BASE_IO_MAPPED_FILE
+
+#include <cstddef>
+#include <cstdint>
+
+#include "mirage_base/define/export.hpp"
+
+namespace mirage::base {
+
+// A whole file mapped read-only into memory. Pages are loaded on first
+// access, so only the parts that are read cost any I/O.
+class MIRAGE_BASE MappedFile {
+ public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  // Invalid if the file can not be opened or is empty.
+  static MappedFile Open(const char* path);
+
+  [[nodiscard]] const uint8_t* data() const;
+  [[nodiscard]] size_t size() const;
+  [[nodiscard]] bool is_valid() const;
+
+ private:
+  MappedFile(const uint8_t* data, size_t size);
+
+  void Unmap();
+
+  const uint8_t* data_{nullptr};
+  size_t size_{0};
+};
+
+}  // namespace mirage::base
+
+#endif  // MIRAGE_BASE_IO_MAPPED_FILE
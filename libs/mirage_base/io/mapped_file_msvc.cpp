@@ -0,0 +1,40 @@
+#include <windows.h>
+
+#include "mirage_base/io/mapped_file.hpp"
+
+using namespace mirage::base;
+
+MappedFile MappedFile::Open(const char* path) {
+  HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return {};
+  }
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0) {
+    CloseHandle(file);
+    return {};
+  }
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!mapping) {
+    return {};
+  }
+  void* ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  // The view keeps the mapping alive on its own.
+  CloseHandle(mapping);
+  if (!ptr) {
+    return {};
+  }
+  return {static_cast<const uint8_t*>(ptr),
+          static_cast<size_t>(file_size.QuadPart)};
+}
+
+void MappedFile::Unmap() {
+  if (data_) {
+    UnmapViewOfFile(data_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+}
@@ -0,0 +1,36 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mirage_base/io/mapped_file.hpp"
+
+using namespace mirage::base;
+
+MappedFile MappedFile::Open(const char* path) {
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return {};
+  }
+  struct stat file_stat {};
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    close(fd);
+    return {};
+  }
+  const auto size = static_cast<size_t>(file_stat.st_size);
+  void* ptr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps the file alive on its own.
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    return {};
+  }
+  return {static_cast<const uint8_t*>(ptr), size};
+}
+
+void MappedFile::Unmap() {
+  if (data_) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+}
@@ -5,6 +5,7 @@
 #include <utility>
 
 #include "mirage_base/define/check.hpp"
+#include "mirage_base/memory/alloc_hook.hpp"
 #include "mirage_base/util/math.hpp"
 
 using namespace mirage::base;
@@ -16,10 +17,12 @@ AlignedBuffer::AlignedBuffer(const size_t size, size_t align)
       align_(align) {
   MIRAGE_DCHECK(size > 0);
   MIRAGE_DCHECK(base::IsPowerOfTwo(align));
+  MIRAGE_ALLOC_RECORD("aligned_buffer", size);
 }
 
 AlignedBuffer::~AlignedBuffer() {
   if (ptr_) {
+    MIRAGE_FREE_RECORD("aligned_buffer", size_);
     ::operator delete[](ptr_, std::align_val_t{align_});
   }
   ptr_ = nullptr;
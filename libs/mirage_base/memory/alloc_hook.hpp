@@ -0,0 +1,55 @@
+#ifndef MIRAGE_BASE_MEMORY_ALLOC_HOOK
+#define MIRAGE_BASE_MEMORY_ALLOC_HOOK
+
+#include <cstddef>
+
+#include "mirage_base/define/export.hpp"
+
+namespace mirage::base {
+
+// Hooks the containers and `AlignedBuffer` report their heap allocations to,
+// see `AllocTracker`. The tag names the allocation site unless an
+// `AllocTagScope` is active, it must outlive the process, e.g. a string
+// literal.
+MIRAGE_BASE void RecordAlloc(const char* tag, size_t size);
+// A free is attributed to the tag active when it happens, which is not
+// necessarily the one the memory was allocated under.
+MIRAGE_BASE void RecordFree(const char* tag, size_t size);
+
+// Tags the allocations of the current thread until it goes out of scope.
+class MIRAGE_BASE AllocTagScope {
+ public:
+  // A default tag only applies when no outer scope is active, containers use
+  // it to name their internals without hiding the tag of their owner.
+  explicit AllocTagScope(const char* tag, bool is_default = false);
+  ~AllocTagScope();
+
+  AllocTagScope(const AllocTagScope&) = delete;
+  AllocTagScope& operator=(const AllocTagScope&) = delete;
+
+ private:
+  const char* prev_tag_;
+};
+
+}  // namespace mirage::base
+
+#define MIRAGE_ALLOC_CONCAT_INNER(a, b) a##b
+#define MIRAGE_ALLOC_CONCAT(a, b) MIRAGE_ALLOC_CONCAT_INNER(a, b)
+
+#if defined(MIRAGE_BUILD_ALLOC_TRACKING)
+#define MIRAGE_ALLOC_RECORD(tag, size) ::mirage::base::RecordAlloc(tag, size)
+#define MIRAGE_FREE_RECORD(tag, size) ::mirage::base::RecordFree(tag, size)
+#define MIRAGE_ALLOC_TAG(tag)                                        \
+  const ::mirage::base::AllocTagScope MIRAGE_ALLOC_CONCAT(           \
+      mirage_alloc_tag_, __LINE__)(tag)
+#define MIRAGE_ALLOC_DEFAULT_TAG(tag)                                \
+  const ::mirage::base::AllocTagScope MIRAGE_ALLOC_CONCAT(           \
+      mirage_alloc_tag_, __LINE__)(tag, true)
+#else
+#define MIRAGE_ALLOC_RECORD(tag, size) ((void)0)
+#define MIRAGE_FREE_RECORD(tag, size) ((void)0)
+#define MIRAGE_ALLOC_TAG(tag) ((void)0)
+#define MIRAGE_ALLOC_DEFAULT_TAG(tag) ((void)0)
+#endif
+
+#endif  // MIRAGE_BASE_MEMORY_ALLOC_HOOK
@@ -0,0 +1,213 @@
+#include "mirage_base/memory/alloc_tracker.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cinttypes>
+#include <cstring>
+
+#include "mirage_base/auto_ptr/owned.hpp"
+#include "mirage_base/sync/lock.hpp"
+#include "mirage_base/util/format.hpp"
+
+using namespace mirage::base;
+
+using Snapshot = AllocTracker::Snapshot;
+
+namespace {
+
+struct Registry {
+  Lock lock;
+  Array<Owned<AllocTracker>> tracker_array;
+};
+
+Registry& GetRegistry() {
+  // Leaked, containers may still free memory during static destruction.
+  static auto* registry = new Registry;
+  return *registry;
+}
+
+thread_local const char* t_tag = nullptr;
+// Set while the tracker runs, so its own containers are not recorded and
+// never reenter the registry lock.
+thread_local bool t_is_recording = false;
+
+class RecordingGuard {
+ public:
+  RecordingGuard() : prev_(t_is_recording) { t_is_recording = true; }
+  ~RecordingGuard() { t_is_recording = prev_; }
+
+  RecordingGuard(const RecordingGuard&) = delete;
+  RecordingGuard& operator=(const RecordingGuard&) = delete;
+
+ private:
+  bool prev_;
+};
+
+// Tags are string literals, so a few pointers cover almost every lookup
+// without touching the registry.
+struct TrackerCache {
+  constexpr static size_t kSize = 16;
+
+  const char* tag_array[kSize]{};
+  AllocTracker* tracker_array[kSize]{};
+  size_t next{0};
+};
+
+thread_local TrackerCache t_cache;
+
+AllocTracker* GetTracker(const char* tag) {
+  for (size_t i = 0; i < TrackerCache::kSize; ++i) {
+    if (t_cache.tag_array[i] == tag) {
+      return t_cache.tracker_array[i];
+    }
+  }
+  auto* tracker = AllocTracker::FindOrCreate(tag);
+  t_cache.tag_array[t_cache.next] = tag;
+  t_cache.tracker_array[t_cache.next] = tracker;
+  t_cache.next = (t_cache.next + 1) % TrackerCache::kSize;
+  return tracker;
+}
+
+}  // namespace
+
+void mirage::base::RecordAlloc(const char* tag, const size_t size) {
+  if (t_is_recording) {
+    return;
+  }
+  RecordingGuard guard;
+  GetTracker(t_tag ? t_tag : tag)->RecordAlloc(size);
+}
+
+void mirage::base::RecordFree(const char* tag, const size_t size) {
+  if (t_is_recording) {
+    return;
+  }
+  RecordingGuard guard;
+  GetTracker(t_tag ? t_tag : tag)->RecordFree(size);
+}
+
+AllocTagScope::AllocTagScope(const char* tag, const bool is_default)
+    : prev_tag_(t_tag) {
+  if (!is_default || !t_tag) {
+    t_tag = tag;
+  }
+}
+
+AllocTagScope::~AllocTagScope() { t_tag = prev_tag_; }
+
+AllocTracker* AllocTracker::FindOrCreate(const char* tag) {
+  RecordingGuard recording_guard;
+  auto& registry = GetRegistry();
+  ScopedLockGuard guard(registry.lock);
+  for (auto& tracker : registry.tracker_array) {
+    if (std::strcmp(tracker->tag_, tag) == 0) {
+      return tracker.raw_ptr();
+    }
+  }
+  registry.tracker_array.Emplace(new AllocTracker(tag));
+  return registry.tracker_array.Tail().raw_ptr();
+}
+
+Array<Snapshot> AllocTracker::SnapshotAll() {
+  RecordingGuard recording_guard;
+  auto& registry = GetRegistry();
+  ScopedLockGuard guard(registry.lock);
+  Array<Snapshot> snapshot_array;
+  snapshot_array.Reserve(registry.tracker_array.size());
+  for (const auto& tracker : registry.tracker_array) {
+    snapshot_array.Push(tracker->snapshot());
+  }
+  return snapshot_array;
+}
+
+Array<Snapshot> AllocTracker::MarkFrame() {
+  RecordingGuard recording_guard;
+  auto& registry = GetRegistry();
+  ScopedLockGuard guard(registry.lock);
+  Array<Snapshot> delta_array;
+  delta_array.Reserve(registry.tracker_array.size());
+  for (const auto& tracker : registry.tracker_array) {
+    const auto current = tracker->snapshot();
+    const auto& begin = tracker->frame_begin_;
+    Snapshot delta{.tag = current.tag,
+                   .alloc_cnt = current.alloc_cnt - begin.alloc_cnt,
+                   .alloc_bytes = current.alloc_bytes - begin.alloc_bytes,
+                   .free_cnt = current.free_cnt - begin.free_cnt,
+                   .free_bytes = current.free_bytes - begin.free_bytes};
+    for (size_t i = 0; i < kHistogramSize; ++i) {
+      delta.size_histogram[i] =
+          current.size_histogram[i] - begin.size_histogram[i];
+    }
+    tracker->frame_begin_ = current;
+    delta_array.Push(delta);
+  }
+  return delta_array;
+}
+
+std::string AllocTracker::DumpTable(const Array<Snapshot>& snapshot_array) {
+  RecordingGuard recording_guard;
+  std::string out;
+  AppendFormat(out, "%-32s %12s %14s %12s %14s\n", "tag", "alloc",
+               "alloc_bytes", "free", "free_bytes");
+  for (const auto& snapshot : snapshot_array) {
+    AppendFormat(out, "%-32s %12" PRIu64 " %14" PRIu64 " %12" PRIu64
+                 " %14" PRIu64 "\n",
+                 snapshot.tag, snapshot.alloc_cnt, snapshot.alloc_bytes,
+                 snapshot.free_cnt, snapshot.free_bytes);
+  }
+  return out;
+}
+
+void AllocTracker::ResetAll() {
+  RecordingGuard recording_guard;
+  auto& registry = GetRegistry();
+  ScopedLockGuard guard(registry.lock);
+  for (auto& tracker : registry.tracker_array) {
+    tracker->Reset();
+  }
+}
+
+size_t AllocTracker::HistogramIndex(const size_t size) {
+  if (size <= 16) {
+    return 0;
+  }
+  return std::min<size_t>(std::bit_width(size - 1) - 4, kHistogramSize - 1);
+}
+
+void AllocTracker::RecordAlloc(const size_t size) {
+  alloc_cnt_.fetch_add(1, std::memory_order_relaxed);
+  alloc_bytes_.fetch_add(size, std::memory_order_relaxed);
+  size_histogram_[HistogramIndex(size)].fetch_add(1,
+                                                  std::memory_order_relaxed);
+}
+
+void AllocTracker::RecordFree(const size_t size) {
+  free_cnt_.fetch_add(1, std::memory_order_relaxed);
+  free_bytes_.fetch_add(size, std::memory_order_relaxed);
+}
+
+Snapshot AllocTracker::snapshot() const {
+  Snapshot snapshot{.tag = tag_,
+                    .alloc_cnt = alloc_cnt_.load(std::memory_order_relaxed),
+                    .alloc_bytes = alloc_bytes_.load(std::memory_order_relaxed),
+                    .free_cnt = free_cnt_.load(std::memory_order_relaxed),
+                    .free_bytes = free_bytes_.load(std::memory_order_relaxed)};
+  for (size_t i = 0; i < kHistogramSize; ++i) {
+    snapshot.size_histogram[i] =
+        size_histogram_[i].load(std::memory_order_relaxed);
+  }
+  return snapshot;
+}
+
+AllocTracker::AllocTracker(const char* tag) : tag_(tag) {}
+
+void AllocTracker::Reset() {
+  alloc_cnt_.store(0, std::memory_order_relaxed);
+  alloc_bytes_.store(0, std::memory_order_relaxed);
+  free_cnt_.store(0, std::memory_order_relaxed);
+  free_bytes_.store(0, std::memory_order_relaxed);
+  for (auto& count : size_histogram_) {
+    count.store(0, std::memory_order_relaxed);
+  }
+  frame_begin_ = {.tag = tag_};
+}
@@ -0,0 +1,72 @@
+#ifndef MIRAGE_BASE_MEMORY_ALLOC_TRACKER
+#define MIRAGE_BASE_MEMORY_ALLOC_TRACKER
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_base/define/export.hpp"
+#include "mirage_base/memory/alloc_hook.hpp"
+
+namespace mirage::base {
+
+// Heap allocation statistics of the engine containers, per allocation tag.
+//
+// They are only collected when the engine is built with
+// `MIRAGE_BUILD_ALLOC_TRACKING`, otherwise the hooks in `alloc_hook.hpp`
+// expand to nothing. Tags sharing a name share their statistics. Allocations
+// made by the tracker itself are not recorded.
+class MIRAGE_BASE AllocTracker {
+ public:
+  // Power-of-two size classes: up to 16 bytes, up to 32 bytes, and so on,
+  // with everything above 256 KiB in the last one.
+  constexpr static size_t kHistogramSize = 16;
+
+  struct Snapshot {
+    const char* tag{nullptr};
+    uint64_t alloc_cnt{0};
+    uint64_t alloc_bytes{0};
+    uint64_t free_cnt{0};
+    uint64_t free_bytes{0};
+    uint64_t size_histogram[kHistogramSize]{};
+  };
+
+  AllocTracker(const AllocTracker&) = delete;
+  AllocTracker& operator=(const AllocTracker&) = delete;
+
+  static AllocTracker* FindOrCreate(const char* tag);
+
+  // Totals since the start or the last `ResetAll`.
+  static Array<Snapshot> SnapshotAll();
+  // Counts since the previous call, usually once per frame. A frame loop that
+  // does not allocate returns only zero counts.
+  static Array<Snapshot> MarkFrame();
+  static std::string DumpTable(const Array<Snapshot>& snapshot_array);
+  static void ResetAll();
+
+  static size_t HistogramIndex(size_t size);
+
+  void RecordAlloc(size_t size);
+  void RecordFree(size_t size);
+
+  [[nodiscard]] Snapshot snapshot() const;
+
+ private:
+  explicit AllocTracker(const char* tag);
+
+  void Reset();
+
+  const char* tag_;
+  std::atomic<uint64_t> alloc_cnt_{0};
+  std::atomic<uint64_t> alloc_bytes_{0};
+  std::atomic<uint64_t> free_cnt_{0};
+  std::atomic<uint64_t> free_bytes_{0};
+  std::atomic<uint64_t> size_histogram_[kHistogramSize]{};
+  // Totals at the last `MarkFrame`, only touched under the registry lock.
+  Snapshot frame_begin_;
+};
+
+}  // namespace mirage::base
+
+#endif  // MIRAGE_BASE_MEMORY_ALLOC_TRACKER
@@ -0,0 +1,224 @@
+#include "mirage_base/profile/profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstring>
+
+#include "mirage_base/auto_ptr/owned.hpp"
+#include "mirage_base/sync/lock.hpp"
+#include "mirage_base/util/format.hpp"
+
+using namespace mirage::base;
+
+using Zone = Profiler::Zone;
+
+namespace {
+
+// Single producer, single consumer: the owning thread writes at `head_`,
+// `Drain` reads up to it under the registry lock.
+class ZoneRing {
+ public:
+  explicit ZoneRing(const uint32_t thread_index)
+      : thread_index_(thread_index) {
+    zone_array_.ResizeUninitialized(Profiler::kRingCapacity);
+  }
+
+  void Push(const Zone& zone) {
+    const auto head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) ==
+        Profiler::kRingCapacity) {
+      dropped_cnt_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    zone_array_[head % Profiler::kRingCapacity] = zone;
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  void DrainInto(Array<Zone>& out) {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    const auto head = head_.load(std::memory_order_acquire);
+    for (auto i = tail; i < head; ++i) {
+      out.Push(zone_array_[i % Profiler::kRingCapacity]);
+    }
+    tail_.store(head, std::memory_order_release);
+  }
+
+  [[nodiscard]] uint32_t thread_index() const { return thread_index_; }
+
+  [[nodiscard]] uint64_t dropped_cnt() const {
+    return dropped_cnt_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  uint32_t thread_index_;
+  Array<Zone> zone_array_;
+  std::atomic<uint64_t> head_{0};
+  std::atomic<uint64_t> tail_{0};
+  std::atomic<uint64_t> dropped_cnt_{0};
+};
+
+struct Registry {
+  Lock lock;
+  // Rings outlive their threads, so zones of exited threads can be drained.
+  Array<Owned<ZoneRing>> ring_array;
+  std::atomic<uint64_t> frame{0};
+};
+
+Registry& GetRegistry() {
+  static Registry registry;
+  return registry;
+}
+
+ZoneRing& GetThreadRing() {
+  thread_local ZoneRing* ring = [] {
+    auto& registry = GetRegistry();
+    ScopedLockGuard guard(registry.lock);
+    const auto thread_index =
+        static_cast<uint32_t>(registry.ring_array.size());
+    registry.ring_array.Emplace(Owned<ZoneRing>::New(thread_index));
+    return registry.ring_array.Tail().raw_ptr();
+  }();
+  return *ring;
+}
+
+thread_local uint32_t t_depth = 0;
+
+template <typename T>
+void AppendBytes(Array<uint8_t>& out, const T val) {
+  // Every supported platform is little-endian.
+  uint8_t bytes[sizeof(T)];
+  std::memcpy(bytes, &val, sizeof(T));
+  for (const auto byte : bytes) {
+    out.Push(byte);
+  }
+}
+
+}  // namespace
+
+void Profiler::MarkFrame() {
+  auto& registry = GetRegistry();
+  auto& ring = GetThreadRing();
+  const auto now = Now();
+  ring.Push({.name = "frame",
+             .begin_ns = now,
+             .end_ns = now,
+             .frame = registry.frame.fetch_add(1, std::memory_order_relaxed),
+             .thread_index = ring.thread_index(),
+             .depth = kFrameMark});
+}
+
+uint64_t Profiler::frame() {
+  return GetRegistry().frame.load(std::memory_order_relaxed);
+}
+
+void Profiler::RecordZone(const char* name, const uint64_t begin_ns,
+                          const uint32_t depth) {
+  auto& ring = GetThreadRing();
+  ring.Push({.name = name,
+             .begin_ns = begin_ns,
+             .end_ns = Now(),
+             .frame = frame(),
+             .thread_index = ring.thread_index(),
+             .depth = depth});
+}
+
+Array<Zone> Profiler::Drain() {
+  auto& registry = GetRegistry();
+  ScopedLockGuard guard(registry.lock);
+  Array<Zone> zone_array;
+  for (auto& ring : registry.ring_array) {
+    ring->DrainInto(zone_array);
+  }
+  return zone_array;
+}
+
+uint64_t Profiler::dropped_cnt() {
+  auto& registry = GetRegistry();
+  ScopedLockGuard guard(registry.lock);
+  uint64_t dropped_cnt = 0;
+  for (const auto& ring : registry.ring_array) {
+    dropped_cnt += ring->dropped_cnt();
+  }
+  return dropped_cnt;
+}
+
+std::string Profiler::DumpChromeTrace(const Array<Zone>& zone_array) {
+  std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  for (size_t i = 0; i < zone_array.size(); ++i) {
+    const auto& zone = zone_array[i];
+    out += i == 0 ? "{\"name\":\"" : ",{\"name\":\"";
+    AppendJsonEscaped(out, zone.name);
+    // Timestamps are in microseconds.
+    const double ts = static_cast<double>(zone.begin_ns) / 1000.0;
+    if (zone.depth == kFrameMark) {
+      AppendFormat(out,
+                   "\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":0,"
+                   "\"tid\":%" PRIu32 ",\"args\":{\"frame\":%" PRIu64 "}}",
+                   ts, zone.thread_index, zone.frame);
+      continue;
+    }
+    const double dur =
+        static_cast<double>(zone.end_ns - zone.begin_ns) / 1000.0;
+    AppendFormat(out,
+                 "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,"
+                 "\"tid\":%" PRIu32 ",\"args\":{\"frame\":%" PRIu64 "}}",
+                 ts, dur, zone.thread_index, zone.frame);
+  }
+  out += "]}";
+  return out;
+}
+
+Array<uint8_t> Profiler::DumpBinary(const Array<Zone>& zone_array) {
+  // Names are interned by address, zones refer to them by index.
+  Array<const char*> name_array;
+  Array<uint32_t> name_index_array;
+  name_index_array.Reserve(zone_array.size());
+  for (const auto& zone : zone_array) {
+    const auto it = std::ranges::find(name_array, zone.name);
+    name_index_array.Push(static_cast<uint32_t>(it - name_array.begin()));
+    if (it == name_array.end()) {
+      name_array.Push(zone.name);
+    }
+  }
+
+  constexpr uint32_t kVersion = 1;
+  Array<uint8_t> out;
+  for (const char c : {'M', 'P', 'R', 'F'}) {
+    out.Push(static_cast<uint8_t>(c));
+  }
+  AppendBytes(out, kVersion);
+  AppendBytes(out, static_cast<uint32_t>(name_array.size()));
+  for (const auto* name : name_array) {
+    const auto length = static_cast<uint32_t>(std::strlen(name));
+    AppendBytes(out, length);
+    for (uint32_t i = 0; i < length; ++i) {
+      out.Push(static_cast<uint8_t>(name[i]));
+    }
+  }
+  AppendBytes(out, static_cast<uint64_t>(zone_array.size()));
+  for (size_t i = 0; i < zone_array.size(); ++i) {
+    const auto& zone = zone_array[i];
+    AppendBytes(out, name_index_array[i]);
+    AppendBytes(out, zone.thread_index);
+    AppendBytes(out, zone.depth);
+    AppendBytes(out, zone.frame);
+    AppendBytes(out, zone.begin_ns);
+    AppendBytes(out, zone.end_ns - zone.begin_ns);  // Duration.
+  }
+  return out;
+}
+
+uint64_t Profiler::Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+ProfileZone::ProfileZone(const char* name)
+    : name_(name), begin_ns_(Profiler::Now()), depth_(t_depth++) {}
+
+ProfileZone::~ProfileZone() {
+  --t_depth;
+  Profiler::RecordZone(name_, begin_ns_, depth_);
+}
@@ -0,0 +1,84 @@
+#ifndef MIRAGE_BASE_PROFILE_PROFILER
+#define MIRAGE_BASE_PROFILE_PROFILER
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_base/define/export.hpp"
+
+namespace mirage::base {
+
+// Frame profiler recording scoped zones.
+//
+// Zones are only recorded when the engine is built with
+// `MIRAGE_BUILD_PROFILE`, otherwise `MIRAGE_PROFILE_ZONE` expands to nothing.
+// Every thread owns a ring buffer that only it writes to, so recording never
+// locks; a zone is dropped when the buffer is full until the next `Drain`.
+// Zone names must outlive the process, e.g. string literals.
+class MIRAGE_BASE Profiler {
+ public:
+  struct Zone {
+    const char* name{nullptr};
+    uint64_t begin_ns{0};
+    uint64_t end_ns{0};
+    uint64_t frame{0};
+    uint32_t thread_index{0};
+    // Nesting depth on its thread, or `kFrameMark` for a frame boundary.
+    uint32_t depth{0};
+  };
+
+  constexpr static uint32_t kFrameMark = UINT32_MAX;
+  constexpr static size_t kRingCapacity = 1 << 14;
+
+  Profiler() = delete;
+
+  // Closes the current frame, zones recorded afterward belong to the next.
+  static void MarkFrame();
+  [[nodiscard]] static uint64_t frame();
+
+  static void RecordZone(const char* name, uint64_t begin_ns, uint32_t depth);
+
+  // Takes the zones recorded by every thread so far, oldest first per thread.
+  static Array<Zone> Drain();
+  [[nodiscard]] static uint64_t dropped_cnt();
+
+  // Chrome trace-event JSON, viewable in chrome://tracing or Perfetto.
+  static std::string DumpChromeTrace(const Array<Zone>& zone_array);
+  // Little-endian "MPRF" header, name table, then fixed-size zone records.
+  static Array<uint8_t> DumpBinary(const Array<Zone>& zone_array);
+
+  static uint64_t Now();
+};
+
+class MIRAGE_BASE ProfileZone {
+ public:
+  explicit ProfileZone(const char* name);
+  ~ProfileZone();
+
+  ProfileZone(const ProfileZone&) = delete;
+  ProfileZone& operator=(const ProfileZone&) = delete;
+
+ private:
+  const char* name_;
+  uint64_t begin_ns_;
+  uint32_t depth_;
+};
+
+}  // namespace mirage::base
+
+#define MIRAGE_PROFILE_CONCAT_INNER(a, b) a##b
+#define MIRAGE_PROFILE_CONCAT(a, b) MIRAGE_PROFILE_CONCAT_INNER(a, b)
+
+#if defined(MIRAGE_BUILD_PROFILE)
+#define MIRAGE_PROFILE_ZONE(name)                                   \
+  const ::mirage::base::ProfileZone MIRAGE_PROFILE_CONCAT(          \
+      mirage_profile_zone_, __LINE__)(name)
+#define MIRAGE_PROFILE_FRAME() ::mirage::base::Profiler::MarkFrame()
+#else
+#define MIRAGE_PROFILE_ZONE(name) ((void)0)
+#define MIRAGE_PROFILE_FRAME() ((void)0)
+#endif
+
+#endif  // MIRAGE_BASE_PROFILE_PROFILER
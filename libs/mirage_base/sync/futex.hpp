@@ -0,0 +1,59 @@
+#ifndef MIRAGE_BASE_SYNC_FUTEX
+#define MIRAGE_BASE_SYNC_FUTEX
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdint>
+
+// Helpers shared by the futex based lock implementations, not part of the
+// public interface.
+namespace mirage::base::futex {
+
+// Sleep while `*futex` still holds `expected`. May return spuriously.
+inline void Wait(const std::atomic<uint32_t>& futex, const uint32_t expected) {
+  syscall(SYS_futex, &futex, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr,
+          0);
+}
+
+// Return whether a thread was woken.
+inline bool WakeOne(const std::atomic<uint32_t>& futex) {
+  return syscall(SYS_futex, &futex, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr,
+                 0) > 0;
+}
+
+inline void WakeAll(const std::atomic<uint32_t>& futex) {
+  syscall(SYS_futex, &futex, FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr,
+          0);
+}
+
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  __asm__ __volatile__("yield");
+#endif
+}
+
+// Number of polls before a waiter goes to sleep. Critical sections guarded by
+// these locks are short, so a holder usually releases within this window.
+constexpr int32_t kSpinCount = 100;
+
+// Poll `futex` until `pred` holds or the spin budget runs out, and return the
+// last observed value.
+template <typename Pred>
+uint32_t SpinUntil(const std::atomic<uint32_t>& futex, Pred pred) {
+  for (int32_t spin = 0;; ++spin) {
+    const auto state = futex.load(std::memory_order_relaxed);
+    if (pred(state) || spin == kSpinCount) {
+      return state;
+    }
+    CpuRelax();
+  }
+}
+
+}  // namespace mirage::base::futex
+
+#endif  // MIRAGE_BASE_SYNC_FUTEX
@@ -3,11 +3,34 @@
 #include <new>  // IWYU pragma: keep
 #include <utility>
 
+#include "mirage_base/define/check.hpp"
+#include "mirage_base/sync/lock_stats.hpp"
+
 using namespace mirage::base;
 
+Lock::Lock([[maybe_unused]] const char* name) : Lock() {
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+  stats_ = LockStats::FindOrCreate(name);
+#endif
+}
+
+#if defined(MIRAGE_HAS_FUTEX)
+// The futex word lives inside the lock, so only an unlocked lock can be moved
+// and the new one starts unlocked as well.
+Lock::Lock([[maybe_unused]] Lock&& other) noexcept {
+  MIRAGE_DCHECK(other.state_.load(std::memory_order_relaxed) == 0);
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+  stats_ = other.stats_;
+#endif
+}
+#else
 Lock::Lock(Lock&& other) noexcept : native_handle_(other.native_handle_) {
   other.native_handle_ = nullptr;
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+  stats_ = other.stats_;
+#endif
 }
+#endif
 
 Lock& Lock::operator=(Lock&& other) noexcept {
   if (this == &other) {
@@ -18,6 +41,37 @@ Lock& Lock::operator=(Lock&& other) noexcept {
   return *this;
 }
 
+void Lock::Acquire() const {
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+  if (stats_) {
+    const auto start = LockStats::Now();
+    const bool is_contended = !TryAcquire();
+    if (is_contended) {
+      AcquireInternal();
+    }
+    acquired_at_ = LockStats::Now();
+    stats_->RecordAcquire(is_contended, acquired_at_ - start);
+    return;
+  }
+#endif
+  // Try the lock first to acquire it cheaply if it's not contended. Try() is
+  // cheap on platforms with futex-type locks, as it doesn't call into the
+  // kernel.
+  if (TryAcquire()) {
+    return;
+  }
+  AcquireInternal();
+}
+
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+void Lock::RecordRelease() const {
+  if (stats_ && acquired_at_ != 0) {
+    stats_->RecordHold(LockStats::Now() - acquired_at_);
+    acquired_at_ = 0;
+  }
+}
+#endif
+
 LockGuard::LockGuard(const Lock& lock) : lock_(&lock) { lock.Acquire(); }
 
 LockGuard::~LockGuard() { Reset(); }
@@ -1,15 +1,31 @@
 #ifndef MIRAGE_BASE_SYNC_LOCK
 #define MIRAGE_BASE_SYNC_LOCK
 
+#include <cstdint>
+
+#if defined(MIRAGE_HAS_FUTEX)
+#include <atomic>
+#endif
+
 #include "mirage_base/define/export.hpp"
 
 namespace mirage::base {
 
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+class LockStats;
+#endif
+
+// With futexes (`MIRAGE_HAS_FUTEX`) the lock is a 4-byte word stored inline,
+// elsewhere it wraps the native mutex of the platform.
 class MIRAGE_BASE Lock {
  public:
+#if !defined(MIRAGE_HAS_FUTEX)
   using NativeHandle = void*;
+#endif
 
   Lock();
+  // The name is only kept with `MIRAGE_BUILD_LOCK_STATS`, see `LockStats`.
+  explicit Lock(const char* name);
   ~Lock();
 
   Lock(const Lock&) = delete;
@@ -25,7 +41,18 @@ class MIRAGE_BASE Lock {
  private:
   void AcquireInternal() const;
 
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+  void RecordRelease() const;
+
+  LockStats* stats_{nullptr};
+  mutable uint64_t acquired_at_{0};
+#endif
+
+#if defined(MIRAGE_HAS_FUTEX)
+  mutable std::atomic<uint32_t> state_{0};
+#else
   NativeHandle native_handle_;
+#endif
 };
 
 class MIRAGE_BASE LockGuard {
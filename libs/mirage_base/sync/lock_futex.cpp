@@ -0,0 +1,53 @@
+#include "mirage_base/define/check.hpp"
+#include "mirage_base/sync/futex.hpp"
+#include "mirage_base/sync/lock.hpp"
+
+using namespace mirage::base;
+
+// The state is 0 when unlocked, 1 when locked and 2 when locked with threads
+// possibly sleeping on it.
+namespace {
+
+constexpr uint32_t kUnlocked = 0;
+constexpr uint32_t kLocked = 1;
+constexpr uint32_t kContended = 2;
+
+}  // namespace
+
+Lock::Lock() = default;
+
+Lock::~Lock() { MIRAGE_DCHECK(state_.load() == kUnlocked); }
+
+bool Lock::TryAcquire() const {
+  auto expected = kUnlocked;
+  return state_.compare_exchange_strong(expected, kLocked,
+                                        std::memory_order_acquire,
+                                        std::memory_order_relaxed);
+}
+
+void Lock::Release() const {
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+  RecordRelease();
+#endif
+  if (state_.exchange(kUnlocked, std::memory_order_release) == kContended) {
+    futex::WakeOne(state_);
+  }
+}
+
+void Lock::AcquireInternal() const {
+  // Spin while the holder is running. Once someone sleeps on the lock the
+  // holder is unlikely to be quick, so stop spinning.
+  auto state = futex::SpinUntil(
+      state_, [](const uint32_t state) { return state != kLocked; });
+  if (state == kUnlocked &&
+      state_.compare_exchange_strong(state, kLocked, std::memory_order_acquire,
+                                     std::memory_order_relaxed)) {
+    return;
+  }
+
+  // Mark the lock as contended so the holder wakes us up on release.
+  while (state_.exchange(kContended, std::memory_order_acquire) !=
+         kUnlocked) {
+    futex::Wait(state_, kContended);
+  }
+}
@@ -23,17 +23,10 @@ bool Lock::TryAcquire() const {
   return TryAcquireSRWLockExclusive(static_cast<SRWLOCK*>(native_handle_));
 }
 
-void Lock::Acquire() const {
-  // Try the lock first to acquire it cheaply if it's not contended. Try() is
-  // cheap on platforms with futex-type locks, as it doesn't call into the
-  // kernel.
-  if (TryAcquire()) {
-    return;
-  }
-  AcquireInternal();
-}
-
 void Lock::Release() const {
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+  RecordRelease();
+#endif
   MIRAGE_DCHECK(native_handle_ != nullptr);
   ReleaseSRWLockExclusive(static_cast<SRWLOCK*>(native_handle_));
 }
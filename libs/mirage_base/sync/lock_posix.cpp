@@ -29,17 +29,10 @@ bool Lock::TryAcquire() const {
   return pthread_mutex_trylock(handle) == 0;
 }
 
-void Lock::Acquire() const {
-  // Try the lock first to acquire it cheaply if it's not contended. Try() is
-  // cheap on platforms with futex-type locks, as it doesn't call into the
-  // kernel.
-  if (TryAcquire()) {
-    return;
-  }
-  AcquireInternal();
-}
-
 void Lock::Release() const {
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+  RecordRelease();
+#endif
   MIRAGE_DCHECK(native_handle_ != nullptr);
   [[maybe_unused]] int32_t rv =
       pthread_mutex_unlock(static_cast<pthread_mutex_t*>(native_handle_));
@@ -0,0 +1,128 @@
+#include "mirage_base/sync/lock_stats.hpp"
+
+#include <chrono>
+#include <cinttypes>
+#include <cstring>
+
+#include "mirage_base/auto_ptr/owned.hpp"
+#include "mirage_base/sync/lock.hpp"
+#include "mirage_base/util/format.hpp"
+
+using namespace mirage::base;
+
+namespace {
+
+struct Registry {
+  // Not named, so it is never instrumented itself.
+  Lock lock;
+  Array<Owned<LockStats>> stats_array;
+};
+
+Registry& GetRegistry() {
+  static Registry registry;
+  return registry;
+}
+
+}  // namespace
+
+LockStats* LockStats::FindOrCreate(const char* name) {
+  auto& registry = GetRegistry();
+  ScopedLockGuard guard(registry.lock);
+  for (auto& stats : registry.stats_array) {
+    if (std::strcmp(stats->name_, name) == 0) {
+      return stats.raw_ptr();
+    }
+  }
+  registry.stats_array.Emplace(new LockStats(name));
+  return registry.stats_array.Tail().raw_ptr();
+}
+
+Array<LockStats::Snapshot> LockStats::SnapshotAll() {
+  auto& registry = GetRegistry();
+  ScopedLockGuard guard(registry.lock);
+  Array<Snapshot> snapshot_array;
+  snapshot_array.Reserve(registry.stats_array.size());
+  for (const auto& stats : registry.stats_array) {
+    snapshot_array.Push(stats->snapshot());
+  }
+  return snapshot_array;
+}
+
+std::string LockStats::DumpTable() {
+  std::string out;
+  AppendFormat(out, "%-32s %12s %12s %14s %14s\n", "name", "acquire",
+               "contended", "wait_us", "max_hold_us");
+  for (const auto& snapshot : SnapshotAll()) {
+    AppendFormat(out, "%-32s %12" PRIu64 " %12" PRIu64 " %14" PRIu64
+                 " %14" PRIu64 "\n",
+                 snapshot.name, snapshot.acquire_cnt, snapshot.contended_cnt,
+                 snapshot.wait_ns / 1000, snapshot.max_hold_ns / 1000);
+  }
+  return out;
+}
+
+std::string LockStats::DumpJson() {
+  std::string out = "[";
+  const auto snapshot_array = SnapshotAll();
+  for (size_t i = 0; i < snapshot_array.size(); ++i) {
+    const auto& snapshot = snapshot_array[i];
+    out += i == 0 ? "{\"name\":\"" : ",{\"name\":\"";
+    AppendJsonEscaped(out, snapshot.name);
+    AppendFormat(out,
+                 "\",\"acquire_cnt\":%" PRIu64 ",\"contended_cnt\":%" PRIu64
+                 ",\"wait_ns\":%" PRIu64 ",\"max_hold_ns\":%" PRIu64 "}",
+                 snapshot.acquire_cnt, snapshot.contended_cnt,
+                 snapshot.wait_ns, snapshot.max_hold_ns);
+  }
+  out += "]";
+  return out;
+}
+
+void LockStats::ResetAll() {
+  auto& registry = GetRegistry();
+  ScopedLockGuard guard(registry.lock);
+  for (auto& stats : registry.stats_array) {
+    stats->Reset();
+  }
+}
+
+uint64_t LockStats::Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void LockStats::RecordAcquire(const bool is_contended, const uint64_t wait_ns) {
+  acquire_cnt_.fetch_add(1, std::memory_order_relaxed);
+  if (is_contended) {
+    contended_cnt_.fetch_add(1, std::memory_order_relaxed);
+    wait_ns_.fetch_add(wait_ns, std::memory_order_relaxed);
+  }
+}
+
+void LockStats::RecordHold(const uint64_t hold_ns) {
+  auto max_hold_ns = max_hold_ns_.load(std::memory_order_relaxed);
+  while (hold_ns > max_hold_ns &&
+         !max_hold_ns_.compare_exchange_weak(max_hold_ns, hold_ns,
+                                             std::memory_order_relaxed)) {
+  }
+}
+
+LockStats::Snapshot LockStats::snapshot() const {
+  return {
+      .name = name_,
+      .acquire_cnt = acquire_cnt_.load(std::memory_order_relaxed),
+      .contended_cnt = contended_cnt_.load(std::memory_order_relaxed),
+      .wait_ns = wait_ns_.load(std::memory_order_relaxed),
+      .max_hold_ns = max_hold_ns_.load(std::memory_order_relaxed),
+  };
+}
+
+LockStats::LockStats(const char* name) : name_(name) {}
+
+void LockStats::Reset() {
+  acquire_cnt_.store(0, std::memory_order_relaxed);
+  contended_cnt_.store(0, std::memory_order_relaxed);
+  wait_ns_.store(0, std::memory_order_relaxed);
+  max_hold_ns_.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,62 @@
+#ifndef MIRAGE_BASE_SYNC_LOCK_STATS
+#define MIRAGE_BASE_SYNC_LOCK_STATS
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_base/define/export.hpp"
+
+namespace mirage::base {
+
+// Contention statistics of named locks.
+//
+// They are only collected when the engine is built with
+// `MIRAGE_BUILD_LOCK_STATS`, otherwise locks carry no statistics and their
+// names are dropped. Locks sharing a name share their statistics, and the
+// name must outlive the process, e.g. a string literal. Hold time is measured
+// for exclusive acquisitions only.
+class MIRAGE_BASE LockStats {
+ public:
+  struct Snapshot {
+    const char* name{nullptr};
+    uint64_t acquire_cnt{0};
+    // Acquisitions that failed the uncontended fast path.
+    uint64_t contended_cnt{0};
+    uint64_t wait_ns{0};
+    uint64_t max_hold_ns{0};
+  };
+
+  LockStats(const LockStats&) = delete;
+  LockStats& operator=(const LockStats&) = delete;
+
+  static LockStats* FindOrCreate(const char* name);
+
+  static Array<Snapshot> SnapshotAll();
+  static std::string DumpTable();
+  static std::string DumpJson();
+  static void ResetAll();
+
+  static uint64_t Now();
+
+  void RecordAcquire(bool is_contended, uint64_t wait_ns);
+  void RecordHold(uint64_t hold_ns);
+
+  [[nodiscard]] Snapshot snapshot() const;
+
+ private:
+  explicit LockStats(const char* name);
+
+  void Reset();
+
+  const char* name_;
+  std::atomic<uint64_t> acquire_cnt_{0};
+  std::atomic<uint64_t> contended_cnt_{0};
+  std::atomic<uint64_t> wait_ns_{0};
+  std::atomic<uint64_t> max_hold_ns_{0};
+};
+
+}  // namespace mirage::base
+
+#endif  // MIRAGE_BASE_SYNC_LOCK_STATS
@@ -3,11 +3,34 @@
 #include <new>  // IWYU pragma: keep
 #include <utility>
 
+#include "mirage_base/define/check.hpp"
+#include "mirage_base/sync/lock_stats.hpp"
+
 using namespace mirage::base;
 
+RWLock::RWLock([[maybe_unused]] const char* name) : RWLock() {
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+  stats_ = LockStats::FindOrCreate(name);
+#endif
+}
+
+#if defined(MIRAGE_HAS_FUTEX)
+// The futex words live inside the lock, so only an unlocked lock can be moved
+// and the new one starts unlocked as well.
+RWLock::RWLock([[maybe_unused]] RWLock&& other) noexcept {
+  MIRAGE_DCHECK(other.state_.load(std::memory_order_relaxed) == 0);
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+  stats_ = other.stats_;
+#endif
+}
+#else
 RWLock::RWLock(RWLock&& other) noexcept : native_handle_(other.native_handle_) {
   other.native_handle_ = nullptr;
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+  stats_ = other.stats_;
+#endif
 }
+#endif
 
 RWLock& RWLock::operator=(RWLock&& other) noexcept {
   if (this == &other) {
@@ -18,6 +41,55 @@ RWLock& RWLock::operator=(RWLock&& other) noexcept {
   return *this;
 }
 
+void RWLock::Read() const {
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+  if (stats_) {
+    const auto start = LockStats::Now();
+    const bool is_contended = !TryRead();
+    if (is_contended) {
+      ReadInternal();
+    }
+    stats_->RecordAcquire(is_contended, LockStats::Now() - start);
+    return;
+  }
+#endif
+  // Try the lock first to acquire it cheaply if it's not contended. Try() is
+  // cheap on platforms with futex-type locks, as it doesn't call into the
+  // kernel.
+  if (TryRead()) {
+    return;
+  }
+  ReadInternal();
+}
+
+void RWLock::Write() const {
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+  if (stats_) {
+    const auto start = LockStats::Now();
+    const bool is_contended = !TryWrite();
+    if (is_contended) {
+      WriteInternal();
+    }
+    acquired_at_ = LockStats::Now();
+    stats_->RecordAcquire(is_contended, acquired_at_ - start);
+    return;
+  }
+#endif
+  if (TryWrite()) {
+    return;
+  }
+  WriteInternal();
+}
+
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+void RWLock::RecordRelease() const {
+  if (stats_ && acquired_at_ != 0) {
+    stats_->RecordHold(LockStats::Now() - acquired_at_);
+    acquired_at_ = 0;
+  }
+}
+#endif
+
 ReadGuard::ReadGuard(const RWLock& rw_lock) : rw_lock_(&rw_lock) {
   rw_lock.Read();
 }
@@ -1,15 +1,32 @@
 #ifndef MIRAGE_BASE_SYNC_RW_LOCK
 #define MIRAGE_BASE_SYNC_RW_LOCK
 
+#include <cstdint>
+
+#if defined(MIRAGE_HAS_FUTEX)
+#include <atomic>
+#endif
+
 #include "mirage_base/define/export.hpp"
 
 namespace mirage::base {
 
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+class LockStats;
+#endif
+
+// With futexes (`MIRAGE_HAS_FUTEX`) the lock is built on words stored inline
+// and prefers writers, so a steady stream of readers can't starve them.
+// Elsewhere it wraps the native readers-writer lock of the platform.
 class MIRAGE_BASE RWLock {
  public:
+#if !defined(MIRAGE_HAS_FUTEX)
   using NativeHandle = void*;
+#endif
 
   RWLock();
+  // The name is only kept with `MIRAGE_BUILD_LOCK_STATS`, see `LockStats`.
+  explicit RWLock(const char* name);
   ~RWLock();
 
   RWLock(const RWLock&) = delete;
@@ -29,7 +46,23 @@ class MIRAGE_BASE RWLock {
   void ReadInternal() const;
   void WriteInternal() const;
 
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+  void RecordRelease() const;
+
+  LockStats* stats_{nullptr};
+  mutable uint64_t acquired_at_{0};
+#endif
+
+#if defined(MIRAGE_HAS_FUTEX)
+  void WakeWriterOrReaders(uint32_t state) const;
+  bool WakeWriter() const;
+
+  mutable std::atomic<uint32_t> state_{0};
+  // Bumped on every writer wake up, writers sleep on it.
+  mutable std::atomic<uint32_t> writer_notify_{0};
+#else
   NativeHandle native_handle_;
+#endif
 };
 
 class MIRAGE_BASE ReadGuard {
@@ -0,0 +1,202 @@
+#include "mirage_base/define/check.hpp"
+#include "mirage_base/sync/futex.hpp"
+#include "mirage_base/sync/rw_lock.hpp"
+
+using namespace mirage::base;
+
+// The low 30 bits of the state count the readers, or are all set when a
+// writer holds the lock. The two high bits flag sleeping readers and writers.
+// Readers don't take the lock while a writer is waiting, and an unlock wakes
+// a writer before any reader.
+namespace {
+
+constexpr uint32_t kReadLocked = 1;
+constexpr uint32_t kMask = (1u << 30) - 1;
+constexpr uint32_t kWriteLocked = kMask;
+constexpr uint32_t kMaxReaders = kMask - 1;
+constexpr uint32_t kReadersWaiting = 1u << 30;
+constexpr uint32_t kWritersWaiting = 1u << 31;
+
+bool IsUnlocked(const uint32_t state) { return (state & kMask) == 0; }
+
+bool IsWriteLocked(const uint32_t state) {
+  return (state & kMask) == kWriteLocked;
+}
+
+bool HasReadersWaiting(const uint32_t state) {
+  return state & kReadersWaiting;
+}
+
+bool HasWritersWaiting(const uint32_t state) {
+  return state & kWritersWaiting;
+}
+
+bool IsReadLockable(const uint32_t state) {
+  return (state & kMask) < kMaxReaders && !HasReadersWaiting(state) &&
+         !HasWritersWaiting(state);
+}
+
+}  // namespace
+
+RWLock::RWLock() = default;
+
+RWLock::~RWLock() { MIRAGE_DCHECK(IsUnlocked(state_.load())); }
+
+bool RWLock::TryRead() const {
+  auto state = state_.load(std::memory_order_relaxed);
+  while (IsReadLockable(state)) {
+    if (state_.compare_exchange_weak(state, state + kReadLocked,
+                                     std::memory_order_acquire,
+                                     std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool RWLock::TryWrite() const {
+  auto state = state_.load(std::memory_order_relaxed);
+  while (IsUnlocked(state)) {
+    if (state_.compare_exchange_weak(state, state + kWriteLocked,
+                                     std::memory_order_acquire,
+                                     std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void RWLock::UnlockRead() const {
+  const auto state =
+      state_.fetch_sub(kReadLocked, std::memory_order_release) - kReadLocked;
+  MIRAGE_DCHECK(!HasReadersWaiting(state) || HasWritersWaiting(state));
+
+  // Readers only wait behind a writer, so the last reader wakes a writer.
+  if (IsUnlocked(state) && HasWritersWaiting(state)) {
+    WakeWriterOrReaders(state);
+  }
+}
+
+void RWLock::UnlockWrite() const {
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+  RecordRelease();
+#endif
+  const auto state =
+      state_.fetch_sub(kWriteLocked, std::memory_order_release) - kWriteLocked;
+  MIRAGE_DCHECK(IsUnlocked(state));
+  if (HasReadersWaiting(state) || HasWritersWaiting(state)) {
+    WakeWriterOrReaders(state);
+  }
+}
+
+void RWLock::ReadInternal() const {
+  auto spin_read = [this] {
+    return futex::SpinUntil(state_, [](const uint32_t state) {
+      return !IsWriteLocked(state) || HasReadersWaiting(state) ||
+             HasWritersWaiting(state);
+    });
+  };
+
+  auto state = spin_read();
+  while (true) {
+    if (IsReadLockable(state)) {
+      if (state_.compare_exchange_weak(state, state + kReadLocked,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+        return;
+      }
+      continue;
+    }
+    MIRAGE_CHECK((state & kMask) != kMaxReaders);
+
+    // Flag this reader before sleeping so that an unlock wakes it up.
+    if (!HasReadersWaiting(state) &&
+        !state_.compare_exchange_weak(state, state | kReadersWaiting,
+                                      std::memory_order_relaxed,
+                                      std::memory_order_relaxed)) {
+      continue;
+    }
+    futex::Wait(state_, state | kReadersWaiting);
+    state = spin_read();
+  }
+}
+
+void RWLock::WriteInternal() const {
+  auto spin_write = [this] {
+    return futex::SpinUntil(state_, [](const uint32_t state) {
+      return IsUnlocked(state) || HasWritersWaiting(state);
+    });
+  };
+
+  // Once this writer slept it can't tell whether others still wait, so it
+  // keeps the flag set when it takes the lock.
+  uint32_t other_writers_waiting = 0;
+  auto state = spin_write();
+  while (true) {
+    if (IsUnlocked(state)) {
+      if (state_.compare_exchange_weak(
+              state, state | kWriteLocked | other_writers_waiting,
+              std::memory_order_acquire, std::memory_order_relaxed)) {
+        return;
+      }
+      continue;
+    }
+
+    if (!HasWritersWaiting(state) &&
+        !state_.compare_exchange_weak(state, state | kWritersWaiting,
+                                      std::memory_order_relaxed,
+                                      std::memory_order_relaxed)) {
+      continue;
+    }
+    other_writers_waiting = kWritersWaiting;
+
+    // Sample the notification counter before checking the state again, so a
+    // wake up between the check and the sleep is never lost.
+    const auto seq = writer_notify_.load(std::memory_order_acquire);
+    state = state_.load(std::memory_order_relaxed);
+    if (IsUnlocked(state) || !HasWritersWaiting(state)) {
+      continue;
+    }
+    futex::Wait(writer_notify_, seq);
+    state = spin_write();
+  }
+}
+
+void RWLock::WakeWriterOrReaders(uint32_t state) const {
+  MIRAGE_DCHECK(IsUnlocked(state));
+
+  // Only writers are waiting.
+  if (state == kWritersWaiting) {
+    if (state_.compare_exchange_strong(state, 0, std::memory_order_relaxed,
+                                       std::memory_order_relaxed)) {
+      WakeWriter();
+      return;
+    }
+  }
+
+  // Both are waiting, leave the readers flagged and try a writer first.
+  if (state == (kReadersWaiting | kWritersWaiting)) {
+    if (!state_.compare_exchange_strong(state, kReadersWaiting,
+                                        std::memory_order_relaxed,
+                                        std::memory_order_relaxed)) {
+      // Someone took the lock, it wakes the rest on unlock.
+      return;
+    }
+    if (WakeWriter()) {
+      return;
+    }
+    // No writer was asleep, so wake the readers instead.
+    state = kReadersWaiting;
+  }
+
+  if (state == kReadersWaiting &&
+      state_.compare_exchange_strong(state, 0, std::memory_order_relaxed,
+                                     std::memory_order_relaxed)) {
+    futex::WakeAll(state_);
+  }
+}
+
+bool RWLock::WakeWriter() const {
+  writer_notify_.fetch_add(1, std::memory_order_release);
+  return futex::WakeOne(writer_notify_);
+}
@@ -28,29 +28,15 @@ bool RWLock::TryWrite() const {
   return TryAcquireSRWLockExclusive(static_cast<SRWLOCK*>(native_handle_));
 }
 
-void RWLock::Read() const {
-  // Try the lock first to acquire it cheaply if it's not contended. Try() is
-  // cheap on platforms with futex-type locks, as it doesn't call into the
-  // kernel.
-  if (TryRead()) {
-    return;
-  }
-  ReadInternal();
-}
-
-void RWLock::Write() const {
-  if (TryWrite()) {
-    return;
-  }
-  WriteInternal();
-}
-
 void RWLock::UnlockRead() const {
   MIRAGE_DCHECK(native_handle_ != nullptr);
   ReleaseSRWLockShared(static_cast<SRWLOCK*>(native_handle_));
 }
 
 void RWLock::UnlockWrite() const {
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+  RecordRelease();
+#endif
   MIRAGE_DCHECK(native_handle_ != nullptr);
   ReleaseSRWLockExclusive(static_cast<SRWLOCK*>(native_handle_));
 }
@@ -35,23 +35,6 @@ bool RWLock::TryWrite() const {
   return pthread_rwlock_trywrlock(handle) == 0;
 }
 
-void RWLock::Read() const {
-  // Try the lock first to acquire it cheaply if it's not contended. Try() is
-  // cheap on platforms with futex-type locks, as it doesn't call into the
-  // kernel.
-  if (TryRead()) {
-    return;
-  }
-  ReadInternal();
-}
-
-void RWLock::Write() const {
-  if (TryWrite()) {
-    return;
-  }
-  WriteInternal();
-}
-
 void RWLock::UnlockRead() const {
   MIRAGE_DCHECK(native_handle_ != nullptr);
   [[maybe_unused]] int32_t rv =
@@ -60,6 +43,9 @@ void RWLock::UnlockRead() const {
 }
 
 void RWLock::UnlockWrite() const {
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+  RecordRelease();
+#endif
   MIRAGE_DCHECK(native_handle_ != nullptr);
   [[maybe_unused]] int32_t rv =
       pthread_rwlock_unlock(static_cast<pthread_rwlock_t*>(native_handle_));
@@ -0,0 +1,56 @@
+#include "mirage_base/util/format.hpp"
+
+#include <cstdarg>
+#include <cstdio>
+
+bool mirage::base::AppendFormat(std::string& out, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  va_list retry_args;
+  va_copy(retry_args, args);
+
+  // Most lines fit, so only long ones are expanded twice.
+  char buffer[256];
+  const int size = std::vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  if (size >= 0 && static_cast<size_t>(size) < sizeof(buffer)) {
+    out.append(buffer, size);
+  } else if (size >= 0) {
+    const size_t old_size = out.size();
+    // Room for the terminator `vsnprintf` always writes.
+    out.resize(old_size + size + 1);
+    std::vsnprintf(out.data() + old_size, size + 1, format, retry_args);
+    out.resize(old_size + size);
+  }
+  va_end(retry_args);
+  return size >= 0;
+}
+
+void mirage::base::AppendJsonEscaped(std::string& out, const char* str) {
+  for (const char* c = str; *c; ++c) {
+    switch (*c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(*c) < 0x20) {
+          AppendFormat(out, "\\u%04x", static_cast<unsigned>(*c));
+        } else {
+          out += *c;
+        }
+        break;
+    }
+  }
+}
@@ -0,0 +1,23 @@
+#ifndef MIRAGE_BASE_UTIL_FORMAT
+#define MIRAGE_BASE_UTIL_FORMAT
+
+#include <string>
+
+#include "mirage_base/define/export.hpp"
+
+namespace mirage::base {
+
+// Append `format` expanded like `printf` to `out`, growing it as far as
+// needed. Returns false and leaves `out` as it was if the expansion fails.
+#if defined(__GNUC__)
+__attribute__((format(printf, 2, 3)))
+#endif
+MIRAGE_BASE bool AppendFormat(std::string& out, const char* format, ...);
+
+// Append `str` as the contents of a JSON string: quotes, backslashes and
+// control characters are escaped.
+MIRAGE_BASE void AppendJsonEscaped(std::string& out, const char* str);
+
+}  // namespace mirage::base
+
+#endif  // MIRAGE_BASE_UTIL_FORMAT
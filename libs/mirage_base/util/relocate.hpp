@@ -0,0 +1,48 @@
+#ifndef MIRAGE_BASE_UTIL_RELOCATE
+#define MIRAGE_BASE_UTIL_RELOCATE
+
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace mirage::base {
+
+// Whether an object can be moved to another address by copying its bytes,
+// skipping both the move constructor and the destructor of the source.
+// Types whose destructor only resets their own fields may specialize it.
+template <typename T>
+struct IsTriviallyRelocatable
+    : std::bool_constant<std::is_trivially_move_constructible_v<T> &&
+                         std::is_trivially_destructible_v<T>> {};
+
+template <typename T>
+constexpr bool kIsTriviallyRelocatable = IsTriviallyRelocatable<T>::value;
+
+// Move `cnt` objects from `src` to the uninitialized memory at `dst` and end
+// the lifetime of the sources. The two ranges may overlap.
+template <std::move_constructible T>
+void Relocate(T* dst, T* src, const size_t cnt) {
+  if (cnt == 0 || dst == src) {
+    return;
+  }
+  if constexpr (kIsTriviallyRelocatable<T>) {
+    std::memmove(static_cast<void*>(dst), static_cast<const void*>(src),
+                 cnt * sizeof(T));
+  } else if (dst < src) {
+    for (size_t i = 0; i < cnt; ++i) {
+      new (dst + i) T(std::move(src[i]));
+      src[i].~T();
+    }
+  } else {
+    for (size_t i = cnt; i > 0; --i) {
+      new (dst + i - 1) T(std::move(src[i - 1]));
+      src[i - 1].~T();
+    }
+  }
+}
+
+}  // namespace mirage::base
+
+#endif  // MIRAGE_BASE_UTIL_RELOCATE
@@ -2,6 +2,7 @@
 #define MIRAGE_BASE_WRAP_BOX
 
 #include <concepts>
+#include <cstring>
 #include <type_traits>
 
 #include "mirage_base/define/check.hpp"
@@ -12,19 +13,30 @@ namespace mirage::base {
 template <typename T>
 struct AnyConstraint : std::true_type {};
 
-template <template <typename> typename Constraint = AnyConstraint>
+// A type-erased owner of one object. Objects that fit the inline buffer live
+// in place, others on the heap. Objects that are small and trivially copyable
+// need no handler at all, the box copies their bytes.
+template <template <typename> typename Constraint = AnyConstraint,
+          size_t InlineSize = 3 * sizeof(void*)>
 class Box {
  public:
+  constexpr static size_t kInlineSize = InlineSize;
+
   Box() = default;
   ~Box() { Reset(); }
 
   Box(const Box&) = delete;
   Box& operator=(const Box&) = delete;
 
-  Box(Box&& other) noexcept {
-    if (other.handle_func_ != nullptr) {
+  Box(Box&& other) noexcept
+      : handle_func_(other.handle_func_), type_meta_(other.type_meta_) {
+    if (handle_func_ == nullptr) {
+      std::memcpy(&obj_, &other.obj_, sizeof(obj_));
+    } else {
       other.Call(kMove, this);
     }
+    other.handle_func_ = nullptr;
+    other.type_meta_ = nullptr;
   }
 
   Box& operator=(Box&& other) noexcept {
@@ -39,9 +51,11 @@ class Box {
   template <typename T>
     requires /* conflict with move */ (!std::is_reference_v<T>) ||
              (std::move_constructible<T> && Constraint<T>::value)
-  Box(T val) {
+  Box(T val) : type_meta_(&TypeMeta::Of<T>()) {
     if constexpr (AllowSmallObjectOptimize<T>()) {
-      handle_func_ = SmallHandler<T>;
+      if constexpr (!std::is_trivially_copyable_v<T>) {
+        handle_func_ = SmallHandler<T>;
+      }
       new (&obj_.buffer) T(std::move(val));
     } else {
       handle_func_ = LargeHandler<T>;
@@ -72,30 +86,44 @@ class Box {
 
   template <typename T>
   T* TryCast() {
-    return static_cast<T*>(Call(kGet, nullptr, &TypeMeta::Of<T>()));
+    if (!is_valid() || type_id() != TypeId::Of<T>()) {
+      return nullptr;
+    }
+    if constexpr (AllowSmallObjectOptimize<T>()) {
+      return reinterpret_cast<T*>(&obj_.buffer);
+    } else {
+      return static_cast<T*>(obj_.ptr);
+    }
   }
 
   template <typename T>
   const T* TryCast() const {
-    return static_cast<const T*>(Call(kGet, nullptr, &TypeMeta::Of<T>()));
+    return const_cast<Box*>(this)->TryCast<T>();
   }
 
   void Reset() {
-    if (handle_func_ == nullptr) return;
-    Call(kDestruct);
+    if (handle_func_ != nullptr) {
+      Call(kDestruct);
+    }
     obj_.ptr = nullptr;
     handle_func_ = nullptr;
+    type_meta_ = nullptr;
   }
 
-  [[nodiscard]] bool is_valid() const { return handle_func_ != nullptr; }
+  [[nodiscard]] bool is_valid() const { return type_meta_ != nullptr; }
 
   [[nodiscard]] TypeId type_id() const {
     MIRAGE_DCHECK(is_valid());
-    return TypeId(*static_cast<const TypeMeta*>(Call(kTypeMeta)));
+    return TypeId(*type_meta_);
   }
 
-  void* raw_ptr() { return Call(kGet); }
-  const void* raw_ptr() const { return Call(kGet); }
+  void* raw_ptr() {
+    if (handle_func_ == nullptr) {
+      return is_valid() ? &obj_.buffer : nullptr;
+    }
+    return Call(kGet);
+  }
+  const void* raw_ptr() const { return const_cast<Box*>(this)->raw_ptr(); }
 
   template <typename T>
   consteval static bool AllowSmallObjectOptimize() {
@@ -109,72 +137,54 @@ class Box {
     kMove,
     kDestruct,
     kGet,
-    kTypeMeta,
   };
 
-  using HandleFuncPtr = void* (*)(Action action, Box* target, Box* dest,
-                                  const TypeMeta* type_meta);
+  using HandleFuncPtr = void* (*)(Action action, Box* target, Box* dest);
 
   template <typename T>
-  static void* LargeHandler(Action action, Box* target, Box* dest,
-                            const TypeMeta* type_meta) {
+  static void* LargeHandler(Action action, Box* target, Box* dest) {
     switch (action) {
       case kMove:
         dest->obj_.ptr = target->obj_.ptr;
-        dest->handle_func_ = target->handle_func_;
         target->obj_.ptr = nullptr;
-        target->handle_func_ = nullptr;
         break;
       case kDestruct:
         delete static_cast<T*>(target->obj_.ptr);
         break;
       case kGet:
-        if (type_meta == nullptr || target->type_id() == TypeId(*type_meta)) {
-          return target->obj_.ptr;
-        }
-        break;
-      case kTypeMeta:
-        return const_cast<TypeMeta*>(&TypeMeta::Of<T>());
+        return target->obj_.ptr;
     }
     return nullptr;
   }
 
   template <typename T>
     requires /* check soo */ (Box::AllowSmallObjectOptimize<T>())
-  static void* SmallHandler(Action action, Box* target, Box* dest,
-                            const TypeMeta* type_meta) {
+  static void* SmallHandler(Action action, Box* target, Box* dest) {
     T* ptr = reinterpret_cast<T*>(&target->obj_.buffer);
     switch (action) {
       case kMove:
         new (&dest->obj_.buffer) T(std::move(*ptr));
-        dest->handle_func_ = target->handle_func_;
         ptr->~T();
-        target->handle_func_ = nullptr;
         break;
       case kDestruct:
         ptr->~T();
         break;
       case kGet:
-        if (type_meta == nullptr || target->type_id() == TypeId(*type_meta)) {
-          return ptr;
-        }
-        break;
-      case kTypeMeta:
-        return const_cast<TypeMeta*>(&TypeMeta::Of<T>());
+        return ptr;
     }
     return nullptr;
   }
 
-  void* Call(Action action, Box* dest = nullptr,
-             const TypeMeta* type_meta = nullptr) const {
-    return handle_func_(action, const_cast<Box*>(this), dest, type_meta);
+  void* Call(Action action, Box* dest = nullptr) const {
+    return handle_func_(action, const_cast<Box*>(this), dest);
   }
 
   union {
     void* ptr{nullptr};
-    std::byte buffer[3 * sizeof(void*)];
+    std::byte buffer[InlineSize];
   } obj_;
   HandleFuncPtr handle_func_{nullptr};
+  const TypeMeta* type_meta_{nullptr};
 };
 
 }  // namespace mirage::base
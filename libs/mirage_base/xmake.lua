@@ -5,12 +5,17 @@ target("mirage_base")
 end
   set_kind(get_config("kind"))
   add_defines("MIRAGE_BUILD_BASE")
-  add_files("**.cpp|sync/*_msvc.cpp|sync/*_posix.cpp")
+  add_files("**.cpp|sync/*_msvc.cpp|sync/*_posix.cpp|sync/*_futex.cpp|"..
+            "io/*_msvc.cpp|io/*_posix.cpp")
 
   on_config(function (target)
     local lock_impl
     if target:has_cxxincludes("windows.h") then
       lock_impl = "sync/*_msvc.cpp"
+    elseif target:has_cxxincludes("linux/futex.h") then
+      lock_impl = "sync/*_futex.cpp"
+      -- The lock headers lay out their state for the implementation.
+      target:add("defines", "MIRAGE_HAS_FUTEX", {public = true})
     elseif target:has_cxxincludes("pthread.h") then
       lock_impl = "sync/*_posix.cpp"
     else
@@ -19,5 +24,13 @@ end
     target:add(
         "files",
         path.translate("$(projectdir)/libs/mirage_base/"..lock_impl))
+
+    local io_impl = "io/*_posix.cpp"
+    if target:has_cxxincludes("windows.h") then
+      io_impl = "io/*_msvc.cpp"
+    end
+    target:add(
+        "files",
+        path.translate("$(projectdir)/libs/mirage_base/"..io_impl))
   end)
 target_end()
@@ -3,11 +3,12 @@
 using namespace mirage::base;
 using namespace mirage::ecs;
 
-Optional<BoxComponent> ComponentBundle::Add(BoxComponent component) {
+Optional<BoxComponent> ComponentBundle::Add(const ComponentId &id,
+                                            BoxComponent component) {
   MIRAGE_DCHECK(component.is_valid());
+  MIRAGE_DCHECK(component.type_id() == id.type_id());
 
-  TypeId type_id = component.type_id();
-  auto kv_opt = component_map_.Insert(type_id, std::move(component));
+  auto kv_opt = component_map_.Insert(id, std::move(component));
   if (!kv_opt.is_valid()) {
     return Optional<BoxComponent>::None();
   }
@@ -15,8 +16,8 @@ Optional<BoxComponent> ComponentBundle::Add(BoxComponent component) {
   return Optional<BoxComponent>::New(std::move(kv.val()));
 }
 
-Optional<BoxComponent> ComponentBundle::Remove(const TypeId &type_id) {
-  auto kv_opt = component_map_.Remove(type_id);
+Optional<BoxComponent> ComponentBundle::Remove(const ComponentId &id) {
+  auto kv_opt = component_map_.Remove(id);
   if (!kv_opt.is_valid()) {
     return Optional<BoxComponent>::None();
   }
@@ -28,11 +29,20 @@ TypeSet ComponentBundle::MakeTypeSet() const {
   TypeSet type_set;
   type_set.Reserve(component_map_.size());
   for (const auto &kv : component_map_) {
-    type_set.AddTypeId(kv.key());
+    type_set.AddTypeId(kv.key().type_id());
   }
   return type_set;
 }
 
+ComponentIdArray ComponentBundle::MakeComponentIdArray() const {
+  ComponentIdArray component_id_array;
+  component_id_array.Reserve(component_map_.size());
+  for (const auto &kv : component_map_) {
+    component_id_array.Push(kv.key());
+  }
+  return component_id_array;
+}
+
 const ComponentBundle::ComponentMap &ComponentBundle::component_map() const {
   return component_map_;
 }
@@ -4,6 +4,7 @@
 #include "mirage_base/container/hash_map.hpp"
 #include "mirage_base/util/type_id.hpp"
 #include "mirage_base/wrap/box.hpp"
+#include "mirage_ecs/component/component_handler.hpp"
 #include "mirage_ecs/util/marker.hpp"
 #include "mirage_ecs/util/type_set.hpp"
 
@@ -16,7 +17,7 @@ class ComponentBundle {
   using Optional = base::Optional<T>;
 
  public:
-  using ComponentMap = base::HashMap<TypeId, BoxComponent>;
+  using ComponentMap = base::HashMap<ComponentId, BoxComponent>;
 
   MIRAGE_ECS ComponentBundle() = default;
   MIRAGE_ECS ~ComponentBundle() = default;
@@ -29,16 +30,18 @@ class ComponentBundle {
 
   template <IsComponent T>
   Optional<T> Add(T component);
-  MIRAGE_ECS Optional<BoxComponent> Add(BoxComponent component);
+  MIRAGE_ECS Optional<BoxComponent> Add(const ComponentId &id,
+                                        BoxComponent component);
 
   template <IsComponent... Ts>
   void AddMany(Ts... components);
 
   template <IsComponent T>
   Optional<T> Remove();
-  MIRAGE_ECS Optional<BoxComponent> Remove(const TypeId &type_id);
+  MIRAGE_ECS Optional<BoxComponent> Remove(const ComponentId &id);
 
   [[nodiscard]] MIRAGE_ECS TypeSet MakeTypeSet() const;
+  [[nodiscard]] MIRAGE_ECS ComponentIdArray MakeComponentIdArray() const;
 
   [[nodiscard]] MIRAGE_ECS const ComponentMap &component_map() const;
   [[nodiscard]] MIRAGE_ECS size_t size() const;
@@ -50,7 +53,7 @@ class ComponentBundle {
 template <IsComponent T>
 base::Optional<T> ComponentBundle::Add(T component) {
   Optional<BoxComponent> old_component_opt =
-      Add(BoxComponent(std::move(component)));
+      Add(ComponentId::Of<T>(), BoxComponent(std::move(component)));
   if (!old_component_opt.is_valid()) {
     return Optional<T>::None();
   }
@@ -64,7 +67,7 @@ void ComponentBundle::AddMany(Ts... components) {
 
 template <IsComponent T>
 base::Optional<T> ComponentBundle::Remove() {
-  Optional<BoxComponent> component_opt = Remove(TypeId::Of<T>());
+  Optional<BoxComponent> component_opt = Remove(ComponentId::Of<T>());
   if (!component_opt.is_valid()) {
     return Optional<T>::None();
   }
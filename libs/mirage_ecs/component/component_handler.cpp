@@ -1,5 +1,6 @@
 #include "mirage_ecs/component/component_handler.hpp"
 
+#include "mirage_base/define/check.hpp"
 #include "mirage_base/util/type_id.hpp"
 
 using namespace mirage::base;
@@ -30,6 +31,56 @@ void ComponentHandler::move(void* target, void* dest) const {
   handler_(kMove, target, dest);
 }
 
+void ComponentHandler::move_construct(void* target, void* dest) const {
+  handler_(kMoveConstruct, target, dest);
+}
+
 void ComponentHandler::destruct(void* target) const {
   handler_(kDestruct, target, nullptr);
 }
+
+StorageType ComponentHandler::storage_type() const {
+  if (handler_(kSparseSet, nullptr, nullptr) != nullptr) {
+    return StorageType::kSparseSet;
+  }
+  return StorageType::kTable;
+}
+
+bool ComponentHandler::is_relation() const {
+  return handler_(kRelationKind, nullptr, nullptr) != nullptr;
+}
+
+bool ComponentHandler::is_tag() const {
+  return handler_(kTag, nullptr, nullptr) != nullptr;
+}
+
+const EntityId* ComponentHandler::relation_target(const void* target) const {
+  MIRAGE_DCHECK(is_relation());
+  return static_cast<const EntityId*>(
+      handler_(kRelationTarget, const_cast<void*>(target), nullptr));
+}
+
+bool ComponentHandler::is_bytewise_serializable() const {
+  return handler_(kBytewise, nullptr, nullptr) != nullptr;
+}
+
+bool ComponentHandler::is_serializable() const {
+  return is_bytewise_serializable() ||
+         handler_(kSerializeHook, nullptr, nullptr) != nullptr;
+}
+
+bool ComponentHandler::serialize(const void* target, ByteWriter& writer) const {
+  return handler_(kSerialize, const_cast<void*>(target), &writer) != nullptr;
+}
+
+bool ComponentHandler::deserialize(ByteReader& reader, void* dest) const {
+  return handler_(kDeserialize, &reader, dest) != nullptr;
+}
+
+bool ComponentHandler::is_cloneable() const {
+  return handler_(kCloneable, nullptr, nullptr) != nullptr;
+}
+
+bool ComponentHandler::clone(const void* target, void* dest) const {
+  return handler_(kClone, const_cast<void*>(target), dest) != nullptr;
+}
@@ -1,14 +1,28 @@
 #ifndef MIRAGE_ECS_COMPONENT_COMPONENT_HANDLER
 #define MIRAGE_ECS_COMPONENT_COMPONENT_HANDLER
 
+#include <type_traits>
+
+#include "mirage_base/io/byte_stream.hpp"
 #include "mirage_base/util/hash.hpp"
 #include "mirage_base/util/type_id.hpp"
+#include "mirage_ecs/component/relation.hpp"
+#include "mirage_ecs/component/serialize.hpp"
 #include "mirage_ecs/define/export.hpp"
+#include "mirage_ecs/entity/generation_id.hpp"
 #include "mirage_ecs/util/marker.hpp"
+#include "mirage_ecs/util/type_set.hpp"
 
 namespace mirage {
 namespace ecs {
 
+// Components that are not copy constructible can still be cloned, e.g. by
+// `World::CloneInto`, through `T Clone() const`.
+template <typename T>
+concept HasCloneHook = requires(const T &component) {
+  { component.Clone() } -> std::same_as<T>;
+};
+
 class MIRAGE_ECS ComponentHandler {
  public:
   ComponentHandler() = delete;
@@ -19,8 +33,19 @@ class MIRAGE_ECS ComponentHandler {
 
   enum Action {
     kMove,
+    kMoveConstruct,
     kDestruct,
     kTypeMeta,
+    kRelationKind,
+    kRelationTarget,
+    kSparseSet,
+    kTag,
+    kBytewise,
+    kSerializeHook,
+    kSerialize,
+    kDeserialize,
+    kCloneable,
+    kClone,
   };
 
   using HandlerFuncPtr = void *(*)(Action action, void *target, void *dest);
@@ -37,9 +62,36 @@ class MIRAGE_ECS ComponentHandler {
   std::strong_ordering operator<=>(const ComponentHandler &other) const;
 
   [[nodiscard]] base::TypeId type_id() const;
+  // Move `target` into `dest` and destruct `target`.
   void move(void *target, void *dest) const;
+  // Move `target` into `dest`; `target` is left for its owner to destruct.
+  void move_construct(void *target, void *dest) const;
   void destruct(void *target) const;
 
+  [[nodiscard]] StorageType storage_type() const;
+  [[nodiscard]] bool is_relation() const;
+  // Empty components are tags, which only live in the archetype type set.
+  [[nodiscard]] bool is_tag() const;
+  // Target entity of a `Relation` component stored at `target`.
+  [[nodiscard]] const EntityId *relation_target(const void *target) const;
+
+  // Whether the component is snapshotted as its raw bytes, see
+  // `IsBytewiseSerializable`.
+  [[nodiscard]] bool is_bytewise_serializable() const;
+  // Bytewise components or ones with serialize hooks.
+  [[nodiscard]] bool is_serializable() const;
+  // Append the component at `target`, false if it is not serializable.
+  bool serialize(const void *target, base::ByteWriter &writer) const;
+  // Construct a component at the uninitialized `dest` from what `serialize`
+  // wrote, false if it is not serializable.
+  bool deserialize(base::ByteReader &reader, void *dest) const;
+
+  // Copy constructible components or ones with a clone hook.
+  [[nodiscard]] bool is_cloneable() const;
+  // Construct a copy of `target` at the uninitialized `dest`, false if the
+  // component is not cloneable.
+  bool clone(const void *target, void *dest) const;
+
  private:
   template <IsComponent T>
   static void *Handler(Action action, void *target, void *dest) {
@@ -50,11 +102,80 @@ class MIRAGE_ECS ComponentHandler {
         new (dest_ptr) T(std::move(*target_ptr));
         target_ptr->~T();
         break;
+      case kMoveConstruct:
+        new (dest_ptr) T(std::move(*target_ptr));
+        break;
       case kDestruct:
         target_ptr->~T();
         break;
       case kTypeMeta:
         return const_cast<base::TypeMeta *>(&base::TypeMeta::Of<T>());
+      case kRelationKind:
+        if constexpr (IsRelation<T>) {
+          return const_cast<base::TypeMeta *>(
+              &base::TypeMeta::Of<typename T::Kind>());
+        }
+        break;
+      case kRelationTarget:
+        if constexpr (IsRelation<T>) {
+          return &target_ptr->target;
+        }
+        break;
+      case kSparseSet:
+        if constexpr (StorageTypeOf<T>() == StorageType::kSparseSet) {
+          return const_cast<base::TypeMeta *>(&base::TypeMeta::Of<T>());
+        }
+        break;
+      case kTag:
+        if constexpr (std::is_empty_v<T>) {
+          return const_cast<base::TypeMeta *>(&base::TypeMeta::Of<T>());
+        }
+        break;
+      case kBytewise:
+        if constexpr (kIsBytewiseSerializable<T>) {
+          return const_cast<base::TypeMeta *>(&base::TypeMeta::Of<T>());
+        }
+        break;
+      case kSerializeHook:
+        if constexpr (HasSerializeHook<T>) {
+          return const_cast<base::TypeMeta *>(&base::TypeMeta::Of<T>());
+        }
+        break;
+      case kSerialize:
+        // `dest` is the writer.
+        if constexpr (kIsBytewiseSerializable<T>) {
+          static_cast<base::ByteWriter *>(dest)->WriteBytes(target, sizeof(T));
+          return dest;
+        } else if constexpr (HasSerializeHook<T>) {
+          target_ptr->Serialize(*static_cast<base::ByteWriter *>(dest));
+          return dest;
+        }
+        break;
+      case kDeserialize:
+        // `target` is the reader.
+        if constexpr (kIsBytewiseSerializable<T>) {
+          static_cast<base::ByteReader *>(target)->ReadBytes(dest, sizeof(T));
+          return dest;
+        } else if constexpr (HasSerializeHook<T>) {
+          new (dest_ptr)
+              T(T::Deserialize(*static_cast<base::ByteReader *>(target)));
+          return dest;
+        }
+        break;
+      case kCloneable:
+        if constexpr (std::copy_constructible<T> || HasCloneHook<T>) {
+          return const_cast<base::TypeMeta *>(&base::TypeMeta::Of<T>());
+        }
+        break;
+      case kClone:
+        if constexpr (std::copy_constructible<T>) {
+          new (dest_ptr) T(*target_ptr);
+          return dest;
+        } else if constexpr (HasCloneHook<T>) {
+          new (dest_ptr) T(target_ptr->Clone());
+          return dest;
+        }
+        break;
     }
     return nullptr;
   }
@@ -63,6 +184,9 @@ class MIRAGE_ECS ComponentHandler {
 };
 
 using ComponentId = ComponentHandler;
+// Components of one archetype, small enough to be kept in place.
+using ComponentIdArray =
+    base::InlineArray<ComponentId, TypeSet::kInlineCapacity>;
 
 }  // namespace ecs
 
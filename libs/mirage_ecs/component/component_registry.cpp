@@ -0,0 +1,24 @@
+#include "mirage_ecs/component/component_registry.hpp"
+
+#include <algorithm>
+
+using namespace mirage::ecs;
+
+void ComponentRegistry::Register(const ComponentId &component_id) {
+  if (std::ranges::find(component_id_array_, component_id) ==
+      component_id_array_.end()) {
+    component_id_array_.Push(component_id);
+  }
+}
+
+const ComponentId *ComponentRegistry::TryFind(
+    const std::string_view type_name) const {
+  for (const auto &component_id : component_id_array_) {
+    if (component_id.type_id().type_name() == type_name) {
+      return &component_id;
+    }
+  }
+  return nullptr;
+}
+
+size_t ComponentRegistry::size() const { return component_id_array_.size(); }
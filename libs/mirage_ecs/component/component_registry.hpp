@@ -0,0 +1,44 @@
+#ifndef MIRAGE_ECS_COMPONENT_COMPONENT_REGISTRY
+#define MIRAGE_ECS_COMPONENT_COMPONENT_REGISTRY
+
+#include <string_view>
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_ecs/component/component_handler.hpp"
+#include "mirage_ecs/define/export.hpp"
+#include "mirage_ecs/util/marker.hpp"
+
+namespace mirage::ecs {
+
+// Component types known by name, so data written by another run of the same
+// build can be mapped back to them, e.g. when loading a snapshot. Names come
+// from `base::TypeId` and are only stable for one compiler.
+class ComponentRegistry {
+ public:
+  MIRAGE_ECS ComponentRegistry() = default;
+  MIRAGE_ECS ~ComponentRegistry() = default;
+
+  ComponentRegistry(const ComponentRegistry &) = delete;
+  ComponentRegistry &operator=(const ComponentRegistry &) = delete;
+
+  MIRAGE_ECS ComponentRegistry(ComponentRegistry &&) noexcept = default;
+  MIRAGE_ECS ComponentRegistry &operator=(ComponentRegistry &&) noexcept =
+      default;
+
+  template <IsComponent... Ts>
+  void Register() {
+    (Register(ComponentId::Of<Ts>()), ...);
+  }
+  MIRAGE_ECS void Register(const ComponentId &component_id);
+
+  [[nodiscard]] MIRAGE_ECS const ComponentId *TryFind(
+      std::string_view type_name) const;
+  [[nodiscard]] MIRAGE_ECS size_t size() const;
+
+ private:
+  base::Array<ComponentId> component_id_array_;
+};
+
+}  // namespace mirage::ecs
+
+#endif  // MIRAGE_ECS_COMPONENT_COMPONENT_REGISTRY
@@ -0,0 +1,39 @@
+#ifndef MIRAGE_ECS_COMPONENT_RELATION
+#define MIRAGE_ECS_COMPONENT_RELATION
+
+#include <concepts>
+
+#include "mirage_ecs/component/serialize.hpp"
+#include "mirage_ecs/entity/generation_id.hpp"
+#include "mirage_ecs/util/marker.hpp"
+
+namespace mirage::ecs {
+
+struct RelationTag {};
+
+// Pair component linking its owner to `target` through the relation kind `R`,
+// e.g. `Relation<ChildOf>(parent)`. The kind is part of the archetype type
+// set while the target is stored as data, so an entity holds at most one
+// target per kind.
+template <typename R>
+struct Relation : RelationTag {
+  MIRAGE_COMPONENT;
+
+  using Kind = R;
+
+  Relation() = default;
+  explicit Relation(const EntityId &target) : target(target) {}
+
+  EntityId target;
+};
+
+template <typename T>
+concept IsRelation = std::derived_from<T, RelationTag> && IsComponent<T>;
+
+// The target is only an entity id, which a snapshot restores as is.
+template <typename R>
+struct IsBytewiseSerializable<Relation<R>> : std::true_type {};
+
+}  // namespace mirage::ecs
+
+#endif  // MIRAGE_ECS_COMPONENT_RELATION
@@ -0,0 +1,40 @@
+#ifndef MIRAGE_ECS_COMPONENT_SERIALIZE
+#define MIRAGE_ECS_COMPONENT_SERIALIZE
+
+#include <concepts>
+#include <type_traits>
+
+#include "mirage_base/io/byte_stream.hpp"
+#include "mirage_ecs/entity/generation_id.hpp"
+
+namespace mirage::ecs {
+
+// Whether a component is written to a snapshot, or cloned into another world,
+// as its raw bytes, so whole columns can be copied at once. Types that are not
+// trivially copyable but whose bytes keep their meaning after a reload, e.g.
+// entity ids, may specialize it.
+template <typename T>
+struct IsBytewiseSerializable
+    : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+template <typename T>
+constexpr bool kIsBytewiseSerializable = IsBytewiseSerializable<T>::value;
+
+// Other components opt in with a pair of hooks:
+//   void Serialize(base::ByteWriter &writer) const;
+//   static T Deserialize(base::ByteReader &reader);
+template <typename T>
+concept HasSerializeHook = requires(const T &component,
+                                    base::ByteWriter &writer,
+                                    base::ByteReader &reader) {
+  component.Serialize(writer);
+  { T::Deserialize(reader) } -> std::same_as<T>;
+};
+
+// Indices and generations are restored as they were saved.
+template <>
+struct IsBytewiseSerializable<GenerationId> : std::true_type {};
+
+}  // namespace mirage::ecs
+
+#endif  // MIRAGE_ECS_COMPONENT_SERIALIZE
@@ -5,6 +5,8 @@
 
 #include "mirage_base/define/check.hpp"
 #include "mirage_base/memory/aligned_buffer.hpp"
+#include "mirage_base/memory/alloc_hook.hpp"
+#include "mirage_base/profile/profiler.hpp"
 #include "mirage_base/util/constant.hpp"
 #include "mirage_ecs/entity/buffer/archetype_data_buffer.hpp"
 #include "mirage_ecs/entity/buffer/sparse_dense_buffer.hpp"
@@ -23,6 +25,7 @@ Archetype::Archetype(SharedDescriptor &&descriptor)
     : descriptor_(std::move(descriptor)) {}
 
 Index Archetype::Push(const EntityId &id, ComponentBundle &bundle) {
+  MIRAGE_PROFILE_ZONE("Archetype::Push");
   EnsureNotFull();
   ++size_;
   auto &data_buffer = data_.Tail();
@@ -31,6 +34,7 @@ Index Archetype::Push(const EntityId &id, ComponentBundle &bundle) {
 }
 
 Index Archetype::Push(View &&view) {
+  MIRAGE_PROFILE_ZONE("Archetype::Migrate");
   EnsureNotFull();
   ++size_;
   auto &data_buffer = data_.Tail();
@@ -38,6 +42,25 @@ Index Archetype::Push(View &&view) {
   return PushSparseDenseBuffer();
 }
 
+Archetype::RawRows Archetype::PushUninitialized(const EntityId *id_ptr,
+                                                const size_t cnt,
+                                                Index *index_ptr) {
+  MIRAGE_PROFILE_ZONE("Archetype::PushUninitialized");
+  MIRAGE_DCHECK(cnt > 0);
+  EnsureNotFullData();
+  auto &data_buffer = data_.Tail();
+  const auto push_cnt = static_cast<uint16_t>(std::min<size_t>(
+      cnt, data_buffer.capacity() - data_buffer.size()));
+  auto *row_ptr = data_buffer.PushUninitialized(id_ptr, push_cnt);
+  size_ += push_cnt;
+  for (uint16_t i = 0; i < push_cnt; ++i) {
+    EnsureNotFullSparse();
+    EnsureNotFullDense();
+    index_ptr[i] = PushSparseDenseBuffer();
+  }
+  return {.ptr = row_ptr, .cnt = push_cnt};
+}
+
 ConstView Archetype::operator[](Index index) const {
   return const_cast<Archetype &>(*this)[index];
 }
@@ -50,8 +73,20 @@ View Archetype::operator[](Index index) {
   return data_[data_route.id][data_route.offset];
 }
 
+Index Archetype::IndexAt(const size_t row) const {
+  auto &self = const_cast<Archetype &>(*this);
+  const auto route = self.GetDenseRoute(row);
+  return self.dense_[route.id][route.offset];
+}
+
+View Archetype::RowAt(const size_t row) {
+  const auto route = GetDataRoute(row);
+  return data_[route.id][route.offset];
+}
+
 Array<ArchetypeDataBuffer> Archetype::TakeMany(SharedDescriptor &&target,
-                                               Array<Index> &&index_list) {
+                                               IndexArray &&index_list) {
+  MIRAGE_PROFILE_ZONE("Archetype::TakeMany");
   if (index_list.empty()) {
     return Array<ArchetypeDataBuffer>();
   }
@@ -60,6 +95,7 @@ Array<ArchetypeDataBuffer> Archetype::TakeMany(SharedDescriptor &&target,
     index = TakeDenseIdFromSparse(index);
   }
 
+  MIRAGE_ALLOC_TAG("archetype.data");
   Array<ArchetypeDataBuffer> take_buffer;
   const auto index_list_size = index_list.size();
   const auto unit_size = target->size() + sizeof(EntityId);
@@ -90,6 +126,10 @@ Array<ArchetypeDataBuffer> Archetype::TakeMany(SharedDescriptor &&target,
                         target.Clone());
   }
 
+  for (auto &buffer : take_buffer) {
+    buffer.BindChangeTick(change_tick_);
+  }
+
   auto iter = index_list.begin();
   for (auto &buffer : take_buffer) {
     while (!buffer.is_full() && iter != index_list.end()) {
@@ -104,10 +144,12 @@ Array<ArchetypeDataBuffer> Archetype::TakeMany(SharedDescriptor &&target,
 }
 
 void Archetype::Remove(Index index) {
+  MIRAGE_PROFILE_ZONE("Archetype::Remove");
   RemoveDenseDataBuffer(TakeDenseIdFromSparse(index));
 }
 
-void Archetype::RemoveMany(Array<Index> &&index_list) {
+void Archetype::RemoveMany(IndexArray &&index_list) {
+  MIRAGE_PROFILE_ZONE("Archetype::RemoveMany");
   if (index_list.empty()) {
     return;
   }
@@ -117,8 +159,84 @@ void Archetype::RemoveMany(Array<Index> &&index_list) {
   RemoveManyDenseDataBuffer(std::move(index_list));
 }
 
+void Archetype::CloneInto(Archetype &dst) const {
+  MIRAGE_PROFILE_ZONE("Archetype::CloneInto");
+  MIRAGE_DCHECK(descriptor_->IsSameLayout(*dst.descriptor_));
+  dst.sparse_.set_size(sparse_.size());
+  for (size_t i = 0; i < sparse_.size(); ++i) {
+    sparse_[i].CloneInto(dst.sparse_[i]);
+  }
+  dst.available_sparse_ = available_sparse_;
+  dst.dense_.set_size(dense_.size());
+  for (size_t i = 0; i < dense_.size(); ++i) {
+    dense_[i].CloneInto(dst.dense_[i]);
+  }
+
+  dst.data_.set_size(std::min(dst.data_.size(), data_.size()));
+  for (size_t i = 0; i < data_.size(); ++i) {
+    if (i == dst.data_.size()) {
+      MIRAGE_ALLOC_TAG("archetype.data");
+      dst.data_.Emplace(
+          AlignedBuffer{data_[i].buffer().size(), data_[i].buffer().align()},
+          dst.descriptor_.Clone());
+      dst.data_.Tail().BindChangeTick(dst.change_tick_);
+    }
+    data_[i].CloneInto(dst.data_[i]);
+  }
+  dst.size_ = size_;
+}
+
 size_t Archetype::size() const { return size_; }
 
+const ArchetypeDescriptor &Archetype::descriptor() const {
+  return *descriptor_;
+}
+
+const Array<ArchetypeDataBuffer> &Archetype::chunk_array() const {
+  return data_;
+}
+
+ArchetypeMemory Archetype::memory_usage() const {
+  ArchetypeMemory memory{.archetype_id = descriptor_->id(),
+                         .entity_cnt = size_,
+                         .chunk_cnt = data_.size()};
+  const auto unit_size = descriptor_->size() + sizeof(EntityId);
+  for (const auto &buffer : data_) {
+    if (!buffer.is_full()) {
+      ++memory.partial_chunk_cnt;
+    }
+    memory.data_bytes += buffer.buffer().size();
+    memory.data_used_bytes += buffer.size() * unit_size;
+  }
+  for (const auto &buffer : sparse_) {
+    memory.sparse_bytes += buffer.buffer().size();
+    memory.sparse_used_bytes += buffer.size() * SparseBuffer::kUnitSize;
+    memory.sparse_hole_cnt += buffer.hole_cnt();
+  }
+  for (const auto &buffer : dense_) {
+    memory.dense_bytes += buffer.buffer().size();
+    memory.dense_used_bytes += buffer.size() * DenseBuffer::kUnitSize;
+  }
+  return memory;
+}
+
+size_t Archetype::data_capacity() const {
+  size_t capacity = 0;
+  for (const auto &buffer : data_) {
+    capacity += buffer.capacity();
+  }
+  return capacity;
+}
+
+Tick Archetype::change_tick() const { return *change_tick_; }
+
+void Archetype::BindChangeTick(const Tick *change_tick) {
+  change_tick_ = change_tick;
+  for (auto &buffer : data_) {
+    buffer.BindChangeTick(change_tick);
+  }
+}
+
 void Archetype::EnsureNotFull() {
   EnsureNotFullSparse();
   EnsureNotFullDense();
@@ -126,6 +244,7 @@ void Archetype::EnsureNotFull() {
 }
 
 void Archetype::EnsureNotFullSparse() {
+  MIRAGE_ALLOC_TAG("archetype.sparse");
   if (!available_sparse_.empty()) {
     return;
   }
@@ -153,6 +272,7 @@ void Archetype::EnsureNotFullSparse() {
 }
 
 void Archetype::EnsureNotFullDense() {
+  MIRAGE_ALLOC_TAG("archetype.dense");
   if (!dense_.empty() && !dense_.Tail().is_full()) {
     return;
   }
@@ -177,6 +297,7 @@ void Archetype::EnsureNotFullDense() {
 }
 
 void Archetype::EnsureNotFullData() {
+  MIRAGE_ALLOC_TAG("archetype.data");
   if (!data_.empty() && !data_.Tail().is_full()) {
     return;
   }
@@ -190,6 +311,7 @@ void Archetype::EnsureNotFullData() {
 
   if (data_.empty()) {
     data_.Emplace(AlignedBuffer{unit_size, align}, descriptor_.Clone());
+    data_.Tail().BindChangeTick(change_tick_);
     return;
   } else if (data_.size() == 1) {
     const auto new_byte_size = data_[0].buffer().size() * 2;
@@ -205,6 +327,7 @@ void Archetype::EnsureNotFullData() {
     }
   }
   data_.Emplace(AlignedBuffer{kMaxBufferSize, align}, descriptor_.Clone());
+  data_.Tail().BindChangeTick(change_tick_);
 }
 
 SparseId Archetype::PushSparseDenseBuffer() {
@@ -213,6 +336,7 @@ SparseId Archetype::PushSparseDenseBuffer() {
   const auto sparse_buffer_id = available_sparse_[0];
   auto &sparse_buffer = sparse_[sparse_buffer_id];
   if (sparse_buffer.capacity() == 0) {
+    MIRAGE_ALLOC_TAG("archetype.sparse");
     if (sparse_.size() == 1) {
       sparse_buffer = SparseBuffer(
           AlignedBuffer{SparseBuffer::kUnitSize, SparseBuffer::kAlign});
@@ -306,9 +430,15 @@ void Archetype::RemoveDenseDataBuffer(DenseId dense_id) {
 
   // Remove dense buffer
   auto &dense_tail_buffer = dense_.Tail();
-  SparseId &dense_tail = dense_tail_buffer[dense_tail_buffer.size() - 1];
+  const SparseId dense_tail = dense_tail_buffer[dense_tail_buffer.size() - 1];
   const auto dense_route = GetDenseRoute(dense_id);
-  dense_[dense_route.id][dense_route.offset] = dense_tail;
+  if (&dense_[dense_route.id] != &dense_tail_buffer ||
+      dense_route.offset != dense_tail_buffer.size() - 1) {
+    // The tail entity fills the hole, so its sparse slot has to follow.
+    dense_[dense_route.id][dense_route.offset] = dense_tail;
+    const auto sparse_route = GetSparseRoute(dense_tail);
+    sparse_[sparse_route.id][sparse_route.offset] = dense_id;
+  }
   dense_tail_buffer.RemoveTail();
   if (dense_tail_buffer.size() == 0) {
     dense_.RemoveTail();
@@ -320,16 +450,26 @@ void Archetype::RemoveDenseDataBuffer(DenseId dense_id) {
   const auto data_route = GetDataRoute(dense_id);
   auto data = data_[data_route.id][data_route.offset];
 
-  data.entity_id() = data_tail.entity_id();
-  data_tail.entity_id().Reset();
-
   auto *data_view_ptr = data.view_ptr();
   auto *data_tail_view_ptr = data_tail.view_ptr();
+  // A row taken by `TakeMany` or `Push(View &&)` was already moved out.
+  const bool is_moved_out = !data.entity_id().is_valid();
+  const bool is_tail = data_view_ptr == data_tail_view_ptr;
   for (auto &entry : descriptor_->offset_map()) {
     const auto component_id = entry.key();
     const auto offset = entry.val();
-    component_id.destruct(data_view_ptr + offset);
-    component_id.move(data_tail_view_ptr + offset, data_view_ptr + offset);
+    if (!is_moved_out) {
+      component_id.destruct(data_view_ptr + offset);
+    }
+    if (!is_tail) {
+      component_id.move(data_tail_view_ptr + offset, data_view_ptr + offset);
+    }
+  }
+  data.entity_id() = data_tail.entity_id();
+  data_tail.entity_id().Reset();
+  // The tail entity keeps its change state after being moved into the hole.
+  if (&data_[data_route.id] != &data_tail_buffer) {
+    data_[data_route.id].MergeTicks(data_tail_buffer);
   }
   data_tail_buffer.RemoveTail();
   if (data_tail_buffer.size() == 0) {
@@ -337,7 +477,7 @@ void Archetype::RemoveDenseDataBuffer(DenseId dense_id) {
   }
 }
 
-void Archetype::RemoveManyDenseDataBuffer(Array<DenseId> &&dense_list) {
+void Archetype::RemoveManyDenseDataBuffer(IndexArray &&dense_list) {
   std::ranges::sort(dense_list, std::greater<DenseId>());
   for (const auto &dense_id : dense_list) {
     RemoveDenseDataBuffer(dense_id);
@@ -3,11 +3,14 @@
 
 #include "mirage_base/auto_ptr/shared.hpp"
 #include "mirage_base/container/array.hpp"
+#include "mirage_base/container/inline_array.hpp"
 #include "mirage_ecs/define/export.hpp"
 #include "mirage_ecs/entity/archetype_descriptor.hpp"
 #include "mirage_ecs/entity/buffer/archetype_data_buffer.hpp"
 #include "mirage_ecs/entity/buffer/sparse_dense_buffer.hpp"
 #include "mirage_ecs/entity/generation_id.hpp"
+#include "mirage_ecs/entity/memory_report.hpp"
+#include "mirage_ecs/util/tick.hpp"
 
 namespace mirage::ecs {
 
@@ -22,6 +25,13 @@ class Archetype {
   using View = ArchetypeDataBuffer::View;
 
   using Index = SparseId;
+  using IndexArray = base::InlineArray<Index, 16>;
+
+  // Rows appended for the caller to construct in place.
+  struct RawRows {
+    std::byte *ptr{nullptr};
+    size_t cnt{0};
+  };
 
   Archetype() = default;
   MIRAGE_ECS Archetype(SharedDescriptor &&descriptor);
@@ -35,17 +45,40 @@ class Archetype {
 
   MIRAGE_ECS Index Push(const EntityId &id, ComponentBundle &bundle);
   MIRAGE_ECS Index Push(View &&view);
+  // Append up to `cnt` rows to the tail chunk and write their indices to
+  // `index_ptr`. Rows never span chunks, so callers loop until all are placed,
+  // constructing every component of a run before pushing the next one.
+  MIRAGE_ECS RawRows PushUninitialized(const EntityId *id_ptr, size_t cnt,
+                                       Index *index_ptr);
 
   MIRAGE_ECS ConstView operator[](Index index) const;
   MIRAGE_ECS View operator[](Index index);
+  // Rows by their position in the chunks, from 0 to `size()`.
+  [[nodiscard]] MIRAGE_ECS Index IndexAt(size_t row) const;
+  MIRAGE_ECS View RowAt(size_t row);
 
   MIRAGE_ECS Array<ArchetypeDataBuffer> TakeMany(SharedDescriptor &&target,
-                                                 Array<Index> &&index_list);
+                                                 IndexArray &&index_list);
 
   MIRAGE_ECS void Remove(Index index);
-  MIRAGE_ECS void RemoveMany(Array<Index> &&index_list);
+  MIRAGE_ECS void RemoveMany(IndexArray &&index_list);
+
+  // Make `dst`, an archetype with the same layout, a copy of this one. Chunks
+  // it already has are reused, and indices stay the same.
+  MIRAGE_ECS void CloneInto(Archetype &dst) const;
 
   [[nodiscard]] MIRAGE_ECS size_t size() const;
+  [[nodiscard]] MIRAGE_ECS const ArchetypeDescriptor &descriptor() const;
+  [[nodiscard]] MIRAGE_ECS const Array<ArchetypeDataBuffer> &chunk_array()
+      const;
+  [[nodiscard]] MIRAGE_ECS ArchetypeMemory memory_usage() const;
+  // Entity slots of all data chunks, filled or not.
+  [[nodiscard]] MIRAGE_ECS size_t data_capacity() const;
+
+  [[nodiscard]] MIRAGE_ECS Tick change_tick() const;
+  // Bind the chunks, including those created later, to the tick of the
+  // owning entity manager.
+  MIRAGE_ECS void BindChangeTick(const Tick *change_tick);
 
  private:
   MIRAGE_ECS void EnsureNotFull();
@@ -66,17 +99,18 @@ class Archetype {
   MIRAGE_ECS DenseId TakeDenseIdFromSparse(SparseId sparse_id);
 
   MIRAGE_ECS void RemoveDenseDataBuffer(DenseId dense_id);
-  MIRAGE_ECS void RemoveManyDenseDataBuffer(Array<DenseId> &&dense_list);
+  MIRAGE_ECS void RemoveManyDenseDataBuffer(IndexArray &&dense_list);
 
   SharedDescriptor descriptor_;
 
   Array<SparseBuffer> sparse_;
-  Array<size_t> available_sparse_;
+  base::InlineArray<size_t, 4> available_sparse_;
   Array<DenseBuffer> dense_;
 
   Array<ArchetypeDataBuffer> data_;
 
   size_t size_{0};
+  const Tick *change_tick_{&kInitTick};
 };
 
 }  // namespace mirage::ecs
@@ -13,7 +13,7 @@
 using namespace mirage::ecs;
 
 ArchetypeDescriptor::ArchetypeDescriptor(
-    const ArchetypeId& id, base::Array<ComponentId>&& component_id_array)
+    const ArchetypeId& id, ComponentIdArray&& component_id_array)
     : id_(id) {
   // Build type set and remove duplicates.
   type_set_.Reserve(component_id_array.size());
@@ -29,11 +29,23 @@ ArchetypeDescriptor::ArchetypeDescriptor(
   }
   type_set_.ShrinkToFit();
 
+  // Tags take no storage, so they are moved out of the layout.
+  for (auto iter = component_id_array.begin();
+       iter != component_id_array.end();) {
+    if (iter->is_tag()) {
+      tag_array_.Push(*iter);
+      component_id_array.SwapRemove(iter - component_id_array.begin());
+    } else {
+      ++iter;
+    }
+  }
+
   // Set the least common multiple (LCM) of all component alignments as the
   // entity alignment.
   // Because all alignments are powers of 2, the LCM is the largest alignment.
-  align_ = type_set_.type_array()[0].type_align();
-  for (const auto& type_id : type_set_.type_array()) {
+  align_ = 1;
+  for (const auto& component_id : component_id_array) {
+    const auto type_id = component_id.type_id();
     const size_t align = type_id.type_align();
     MIRAGE_DCHECK(base::IsPowerOfTwo(align));
     align_ = std::max(align_, align);
@@ -57,6 +69,9 @@ ArchetypeDescriptor::ArchetypeDescriptor(
     }
     offset_map_[component_id] = offset;
     offset += type_id.type_size();
+    if (component_id.is_relation()) {
+      relation_array_.Push(component_id);
+    }
   }
 
   // Align the end of the entity.
@@ -66,6 +81,33 @@ ArchetypeDescriptor::ArchetypeDescriptor(
   size_ = offset;
 }
 
+ArchetypeDescriptor ArchetypeDescriptor::Clone() const {
+  ArchetypeDescriptor descriptor;
+  descriptor.id_ = id_;
+  descriptor.align_ = align_;
+  descriptor.size_ = size_;
+  for (const auto& entry : offset_map_) {
+    descriptor.offset_map_.Insert(entry.key(), entry.val());
+  }
+  descriptor.type_set_ = type_set_.Clone();
+  descriptor.tag_array_ = tag_array_;
+  descriptor.relation_array_ = relation_array_;
+  return descriptor;
+}
+
+bool ArchetypeDescriptor::IsSameLayout(const ArchetypeDescriptor& other) const {
+  if (size_ != other.size_ || !(type_set_ == other.type_set_)) {
+    return false;
+  }
+  for (const auto& entry : offset_map_) {
+    const auto it = other.offset_map_.TryFind(entry.key());
+    if (!it || it->val() != entry.val()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 const ArchetypeId& ArchetypeDescriptor::id() const { return id_; }
 
 size_t ArchetypeDescriptor::align() const { return align_; }
@@ -83,3 +125,29 @@ const ArchetypeDescriptor::OffsetMap& ArchetypeDescriptor::offset_map() const {
 }
 
 const TypeSet& ArchetypeDescriptor::type_set() const { return type_set_; }
+
+size_t ArchetypeDescriptor::column_index(const ComponentId& id) const {
+  const auto& type_array = type_set_.type_array();
+  const auto type_id = id.type_id();
+  const auto iter =
+      std::lower_bound(type_array.begin(), type_array.end(), type_id);
+  if (iter == type_array.end() || *iter != type_id) {
+    return kInvalidColumn;
+  }
+  return iter - type_array.begin();
+}
+
+size_t ArchetypeDescriptor::column_cnt() const { return type_set_.size(); }
+
+bool ArchetypeDescriptor::HasTag(const ComponentId& id) const {
+  return id.is_tag() && type_set_.With(id.type_id());
+}
+
+const mirage::base::Array<ComponentId>& ArchetypeDescriptor::tag_array() const {
+  return tag_array_;
+}
+
+const mirage::base::Array<ComponentId>& ArchetypeDescriptor::relation_array()
+    const {
+  return relation_array_;
+}
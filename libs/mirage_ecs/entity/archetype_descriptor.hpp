@@ -11,11 +11,14 @@ namespace mirage::ecs {
 
 class ArchetypeDescriptor {
  public:
+  // Offsets of the components that have a column. Tags have none.
   using OffsetMap = base::HashMap<ComponentId, size_t>;
 
+  constexpr static size_t kInvalidColumn = SIZE_MAX;
+
   MIRAGE_ECS ArchetypeDescriptor() = default;
   MIRAGE_ECS ArchetypeDescriptor(const ArchetypeId &id,
-                                 base::Array<ComponentId> &&component_id_array);
+                                 ComponentIdArray &&component_id_array);
   MIRAGE_ECS ~ArchetypeDescriptor() = default;
 
   ArchetypeDescriptor(const ArchetypeDescriptor &) = delete;
@@ -27,6 +30,12 @@ class ArchetypeDescriptor {
   template <IsComponent... Ts>
   static ArchetypeDescriptor New(const ArchetypeId &id);
 
+  // Components of equal alignment and size may be laid out in any order, so
+  // a copy of the layout is cloned rather than rebuilt.
+  [[nodiscard]] MIRAGE_ECS ArchetypeDescriptor Clone() const;
+  [[nodiscard]] MIRAGE_ECS bool IsSameLayout(
+      const ArchetypeDescriptor &other) const;
+
   [[nodiscard]] MIRAGE_ECS const ArchetypeId &id() const;
   [[nodiscard]] MIRAGE_ECS size_t align() const;
   [[nodiscard]] MIRAGE_ECS size_t size() const;
@@ -34,17 +43,28 @@ class ArchetypeDescriptor {
   [[nodiscard]] MIRAGE_ECS const OffsetMap &offset_map() const;
   [[nodiscard]] MIRAGE_ECS const TypeSet &type_set() const;
 
+  // Index of the component in the sorted type set, or `kInvalidColumn`.
+  [[nodiscard]] MIRAGE_ECS size_t column_index(const ComponentId &id) const;
+  [[nodiscard]] MIRAGE_ECS size_t column_cnt() const;
+  [[nodiscard]] MIRAGE_ECS bool HasTag(const ComponentId &id) const;
+  [[nodiscard]] MIRAGE_ECS const base::Array<ComponentId> &tag_array() const;
+  // Components of the archetype that are `Relation` pairs.
+  [[nodiscard]] MIRAGE_ECS const base::Array<ComponentId> &relation_array()
+      const;
+
  private:
   ArchetypeId id_;
   size_t align_{0};
   size_t size_{0};
   OffsetMap offset_map_;
   TypeSet type_set_;
+  base::Array<ComponentId> tag_array_;
+  base::Array<ComponentId> relation_array_;
 };
 
 template <IsComponent... Ts>
 ArchetypeDescriptor ArchetypeDescriptor::New(const ArchetypeId &id) {
-  base::Array<ComponentId> component_id_array;
+  ComponentIdArray component_id_array;
   component_id_array.Reserve(sizeof...(Ts));
   (component_id_array.Push(ComponentId::Of<Ts>()), ...);
   return {id, std::move(component_id_array)};
@@ -1,5 +1,7 @@
 #include "mirage_ecs/entity/buffer/archetype_data_buffer.hpp"
 
+#include <cstring>
+
 #include "mirage_base/define/check.hpp"
 #include "mirage_ecs/entity/archetype_descriptor.hpp"
 
@@ -13,10 +15,14 @@ ArchetypeDataBuffer::ArchetypeDataBuffer(Buffer&& buffer,
   size_ = 0;
   const auto capacity = buffer_.size() / unit_size(*descriptor_);
   capacity_ = static_cast<uint16_t>(capacity);
+  column_ticks_.set_size(descriptor_->column_cnt());
 }
 
 ArchetypeDataBuffer::~ArchetypeDataBuffer() {
-  Clear();
+  // The change tick may already be gone with the owning manager.
+  while (size_ > 0) {
+    DestructTail();
+  }
   descriptor_ = nullptr;
   capacity_ = 0;
 }
@@ -25,7 +31,10 @@ ArchetypeDataBuffer::ArchetypeDataBuffer(ArchetypeDataBuffer&& other) noexcept
     : descriptor_(std::move(other.descriptor_)),
       buffer_(std::move(other.buffer_)),
       size_(other.size_),
-      capacity_(other.capacity_) {
+      capacity_(other.capacity_),
+      column_ticks_(std::move(other.column_ticks_)),
+      row_tick_(other.row_tick_),
+      change_tick_(other.change_tick_) {
   other.size_ = 0;
   other.capacity_ = 0;
 }
@@ -46,7 +55,8 @@ ArchetypeDataBuffer::ConstView ArchetypeDataBuffer::operator[](
   const auto* entity_id_ptr =
       reinterpret_cast<const EntityId*>(buffer_.ptr() + buffer_.size()) -
       (capacity_ - index);
-  return ConstView(descriptor_.raw_ptr(), view_ptr, entity_id_ptr);
+  return ConstView(descriptor_.raw_ptr(), view_ptr, entity_id_ptr,
+                   column_ticks_.data());
 }
 
 ArchetypeDataBuffer::View ArchetypeDataBuffer::operator[](
@@ -56,7 +66,8 @@ ArchetypeDataBuffer::View ArchetypeDataBuffer::operator[](
   auto* entity_id_ptr =
       reinterpret_cast<EntityId*>(buffer_.ptr() + buffer_.size()) -
       (capacity_ - index);
-  return View(descriptor_.raw_ptr(), view_ptr, entity_id_ptr);
+  return View(descriptor_.raw_ptr(), view_ptr, entity_id_ptr,
+              column_ticks_.data(), *change_tick_);
 }
 
 void ArchetypeDataBuffer::Push(const EntityId& id, ComponentBundle& bundle) {
@@ -66,11 +77,16 @@ void ArchetypeDataBuffer::Push(const EntityId& id, ComponentBundle& bundle) {
     const auto& component_id = entry.key();
     const auto& offset = entry.val();
 
-    auto box_op = bundle.Remove(component_id.type_id());
+    auto box_op = bundle.Remove(component_id);
     MIRAGE_DCHECK(box_op.is_valid());
+    // The box still owns the moved-from value and destructs it.
     auto box = box_op.Unwrap();
-    component_id.move(box.raw_ptr(), view_ptr + offset);
+    component_id.move_construct(box.raw_ptr(), view_ptr + offset);
   }
+  for (auto& ticks : column_ticks_) {
+    ticks.MarkAdded(*change_tick_);
+  }
+  row_tick_ = *change_tick_;
 
   auto* entity_id_ptr =
       reinterpret_cast<EntityId*>(buffer_.ptr() + buffer_.size()) -
@@ -87,11 +103,30 @@ void ArchetypeDataBuffer::Push(View&& view) {
     const auto& component_id = entry.key();
     const auto& offset = entry.val();
 
-    void* component_ptr = view.TryGet(component_id);
+    auto& ticks = column_ticks_[descriptor_->column_index(component_id)];
+    void* component_ptr = view.TryGetUntracked(component_id);
     if (!component_ptr) {
+      ticks.MarkAdded(*change_tick_);
       continue;
     }
     component_id.move(component_ptr, view_ptr + offset);
+    ticks.Merge(*view.TryGetTicks(component_id));
+  }
+  for (const auto& tag : descriptor_->tag_array()) {
+    auto& ticks = column_ticks_[descriptor_->column_index(tag)];
+    const auto* tag_ticks = view.TryGetTicks(tag);
+    if (tag_ticks) {
+      ticks.Merge(*tag_ticks);
+    } else {
+      ticks.MarkAdded(*change_tick_);
+    }
+  }
+  // Components the target archetype does not have are dropped.
+  for (const auto& entry : view.descriptor_->offset_map()) {
+    const auto& component_id = entry.key();
+    if (!descriptor_->offset_map().TryFind(component_id)) {
+      component_id.destruct(view.view_ptr_ + entry.val());
+    }
   }
 
   auto* entity_id_ptr =
@@ -99,16 +134,49 @@ void ArchetypeDataBuffer::Push(View&& view) {
       (capacity_ - size_);
   *entity_id_ptr = view.entity_id();
   view.entity_id().Reset();
+  row_tick_ = *change_tick_;
 
   ++size_;
 }
 
+std::byte* ArchetypeDataBuffer::PushUninitialized(const EntityId* id_ptr,
+                                                  const uint16_t cnt) {
+  MIRAGE_DCHECK(cnt <= capacity_ - size_);
+  auto* view_ptr = buffer_.ptr() + size_ * descriptor_->size();
+  auto* entity_id_ptr =
+      reinterpret_cast<EntityId*>(buffer_.ptr() + buffer_.size()) -
+      (capacity_ - size_);
+  std::memcpy(static_cast<void*>(entity_id_ptr), id_ptr,
+              cnt * sizeof(EntityId));
+  for (auto& ticks : column_ticks_) {
+    ticks.MarkAdded(*change_tick_);
+  }
+  row_tick_ = *change_tick_;
+  size_ += cnt;
+  return view_ptr;
+}
+
 void ArchetypeDataBuffer::RemoveTail() {
+  row_tick_ = *change_tick_;
+  DestructTail();
+}
+
+void ArchetypeDataBuffer::Clear() {
+  while (size_ > 0) {
+    RemoveTail();
+  }
+}
+
+void ArchetypeDataBuffer::DestructTail() {
   MIRAGE_DCHECK(size_ > 0);
   --size_;
   auto* entity_id_ptr =
       reinterpret_cast<EntityId*>(buffer_.ptr() + buffer_.size()) -
       (capacity_ - size_);
+  // Rows whose components were moved out carry an invalid entity id.
+  if (!entity_id_ptr->is_valid()) {
+    return;
+  }
   entity_id_ptr->Reset();
 
   auto* view_ptr = buffer_.ptr() + size_ * descriptor_->size();
@@ -119,12 +187,6 @@ void ArchetypeDataBuffer::RemoveTail() {
   }
 }
 
-void ArchetypeDataBuffer::Clear() {
-  while (size_ > 0) {
-    RemoveTail();
-  }
-}
-
 void ArchetypeDataBuffer::Reserve(size_t byte_size) {
   if (byte_size <= buffer_.size()) {
     return;
@@ -134,11 +196,85 @@ void ArchetypeDataBuffer::Reserve(size_t byte_size) {
   const auto old_buffer_size = old_buffer.size_;
   new (this) ArchetypeDataBuffer({byte_size, old_buffer.buffer_.align()},
                                  old_buffer.descriptor_.Clone());
+  change_tick_ = old_buffer.change_tick_;
+  row_tick_ = old_buffer.row_tick_;
   for (auto i = 0; i < old_buffer_size; ++i) {
     Push(old_buffer[i]);
   }
 }
 
+void ArchetypeDataBuffer::CloneInto(ArchetypeDataBuffer& dst) const {
+  MIRAGE_DCHECK(descriptor_->IsSameLayout(*dst.descriptor_));
+  // Bytewise components need no destructor, see `IsBytewiseSerializable`.
+  Array<ComponentId> cloned_array;
+  for (const auto& entry : descriptor_->offset_map()) {
+    if (!entry.key().is_bytewise_serializable()) {
+      cloned_array.Push(entry.key());
+    }
+  }
+  for (const auto& component_id : cloned_array) {
+    const auto offset = descriptor_->offset_map().TryFind(component_id)->val();
+    for (uint16_t i = 0; i < dst.size_; ++i) {
+      component_id.destruct(dst.buffer_.ptr() + i * descriptor_->size() +
+                            offset);
+    }
+  }
+  dst.size_ = 0;
+  if (dst.buffer_.size() != buffer_.size() ||
+      dst.buffer_.align() != buffer_.align()) {
+    dst.buffer_ = {buffer_.size(), buffer_.align()};
+    dst.capacity_ = capacity_;
+  }
+
+  const auto row_size = descriptor_->size();
+  std::memcpy(dst.buffer_.ptr(), buffer_.ptr(), size_ * row_size);
+  auto* entity_id_ptr =
+      reinterpret_cast<EntityId*>(dst.buffer_.ptr() + dst.buffer_.size()) -
+      dst.capacity_;
+  std::memcpy(static_cast<void*>(entity_id_ptr), entity_id_data(),
+              size_ * sizeof(EntityId));
+  for (const auto& component_id : cloned_array) {
+    const auto offset = descriptor_->offset_map().TryFind(component_id)->val();
+    for (uint16_t i = 0; i < size_; ++i) {
+      component_id.clone(buffer_.ptr() + i * row_size + offset,
+                         dst.buffer_.ptr() + i * row_size + offset);
+    }
+  }
+  dst.size_ = size_;
+  for (size_t i = 0; i < column_ticks_.size(); ++i) {
+    dst.column_ticks_[i] = column_ticks_[i];
+  }
+  // The copied column ticks may be older than what they replaced.
+  dst.row_tick_ = *dst.change_tick_;
+}
+
+void ArchetypeDataBuffer::MergeTicks(const ArchetypeDataBuffer& other) {
+  MIRAGE_DCHECK(descriptor_.raw_ptr() == other.descriptor_.raw_ptr());
+  for (size_t i = 0; i < column_ticks_.size(); ++i) {
+    column_ticks_[i].Merge(other.column_ticks_[i]);
+  }
+  row_tick_ = *change_tick_;
+}
+
+bool ArchetypeDataBuffer::IsColumnAdded(const ComponentId id,
+                                        const Tick last_run_tick) const {
+  const auto column = descriptor_->column_index(id);
+  if (column == ArchetypeDescriptor::kInvalidColumn) {
+    return false;
+  }
+  return column_ticks_[column].IsAdded(last_run_tick);
+}
+
+bool ArchetypeDataBuffer::IsColumnChanged(const ComponentId id,
+                                          const Tick last_run_tick) const {
+  const auto column = descriptor_->column_index(id);
+  if (column == ArchetypeDescriptor::kInvalidColumn) {
+    return false;
+  }
+  return row_tick_ > last_run_tick ||
+         column_ticks_[column].IsChanged(last_run_tick);
+}
+
 const ArchetypeDataBuffer::SharedDescriptor& ArchetypeDataBuffer::descriptor()
     const {
   return descriptor_;
@@ -148,6 +284,11 @@ const ArchetypeDataBuffer::Buffer& ArchetypeDataBuffer::buffer() const {
   return buffer_;
 }
 
+const EntityId* ArchetypeDataBuffer::entity_id_data() const {
+  return reinterpret_cast<const EntityId*>(buffer_.ptr() + buffer_.size()) -
+         capacity_;
+}
+
 uint16_t ArchetypeDataBuffer::size() const { return size_; }
 
 uint16_t ArchetypeDataBuffer::capacity() const { return capacity_; }
@@ -158,22 +299,39 @@ size_t ArchetypeDataBuffer::unit_size(ArchetypeDescriptor& descriptor) {
   return descriptor.size() + sizeof(EntityId);
 }
 
+const mirage::base::Array<ComponentTicks>& ArchetypeDataBuffer::column_ticks()
+    const {
+  return column_ticks_;
+}
+
+Tick ArchetypeDataBuffer::row_tick() const { return row_tick_; }
+
+Tick ArchetypeDataBuffer::change_tick() const { return *change_tick_; }
+
+void ArchetypeDataBuffer::BindChangeTick(const Tick* change_tick) {
+  change_tick_ = change_tick;
+}
+
 ArchetypeDataBuffer::ConstView::ConstView(const ArchetypeDescriptor* descriptor,
                                           const std::byte* view_ptr,
-                                          const EntityId* entity_id_ptr)
+                                          const EntityId* entity_id_ptr,
+                                          const ComponentTicks* ticks_ptr)
     : descriptor_(descriptor),
       view_ptr_(view_ptr),
-      entity_id_ptr_(entity_id_ptr) {}
+      entity_id_ptr_(entity_id_ptr),
+      ticks_ptr_(ticks_ptr) {}
 
 ArchetypeDataBuffer::ConstView::ConstView(const View& view)
     : descriptor_(view.descriptor_),
       view_ptr_(view.view_ptr_),
-      entity_id_ptr_(view.entity_id_ptr_) {}
+      entity_id_ptr_(view.entity_id_ptr_),
+      ticks_ptr_(view.ticks_ptr_) {}
 
 const void* ArchetypeDataBuffer::ConstView::TryGet(const ComponentId id) const {
   const auto it = descriptor_->offset_map().TryFind(id);
   if (!it) {
-    return nullptr;
+    // Any non-null address stands for a tag.
+    return descriptor_->HasTag(id) ? view_ptr_ : nullptr;
   }
   const auto& offset = it->val();
   return view_ptr_ + offset;
@@ -183,28 +341,41 @@ const EntityId& ArchetypeDataBuffer::ConstView::entity_id() const {
   return *entity_id_ptr_;
 }
 
+const ComponentTicks* ArchetypeDataBuffer::ConstView::TryGetTicks(
+    const ComponentId id) const {
+  const auto column = descriptor_->column_index(id);
+  if (column == ArchetypeDescriptor::kInvalidColumn) {
+    return nullptr;
+  }
+  return ticks_ptr_ + column;
+}
+
 ArchetypeDataBuffer::View::View(const ArchetypeDescriptor* descriptor,
-                                std::byte* view_ptr, EntityId* entity_id_ptr)
+                                std::byte* view_ptr, EntityId* entity_id_ptr,
+                                ComponentTicks* ticks_ptr,
+                                const Tick change_tick)
     : descriptor_(descriptor),
       view_ptr_(view_ptr),
-      entity_id_ptr_(entity_id_ptr) {}
+      entity_id_ptr_(entity_id_ptr),
+      ticks_ptr_(ticks_ptr),
+      change_tick_(change_tick) {}
 
 const void* ArchetypeDataBuffer::View::TryGet(const ComponentId id) const {
   const auto it = descriptor_->offset_map().TryFind(id);
   if (!it) {
-    return nullptr;
+    // Any non-null address stands for a tag.
+    return descriptor_->HasTag(id) ? view_ptr_ : nullptr;
   }
   const auto& offset = it->val();
   return view_ptr_ + offset;
 }
 
-void* ArchetypeDataBuffer::View::TryGet(const ComponentId id) {
-  const auto it = descriptor_->offset_map().TryFind(id);
-  if (!it) {
-    return nullptr;
+void* ArchetypeDataBuffer::View::TryGetMut(const ComponentId id) {
+  void* component_ptr = TryGetUntracked(id);
+  if (component_ptr) {
+    ticks_ptr_[descriptor_->column_index(id)].MarkChanged(change_tick_);
   }
-  const auto& offset = it->val();
-  return view_ptr_ + offset;
+  return component_ptr;
 }
 
 std::byte* ArchetypeDataBuffer::View::view_ptr() { return view_ptr_; }
@@ -214,3 +385,18 @@ const EntityId& ArchetypeDataBuffer::View::entity_id() const {
 }
 
 EntityId& ArchetypeDataBuffer::View::entity_id() { return *entity_id_ptr_; }
+
+const ComponentTicks* ArchetypeDataBuffer::View::TryGetTicks(
+    const ComponentId id) const {
+  return ConstView(*this).TryGetTicks(id);
+}
+
+void* ArchetypeDataBuffer::View::TryGetUntracked(const ComponentId id) const {
+  const auto it = descriptor_->offset_map().TryFind(id);
+  if (!it) {
+    // Any non-null address stands for a tag.
+    return descriptor_->HasTag(id) ? view_ptr_ : nullptr;
+  }
+  const auto& offset = it->val();
+  return view_ptr_ + offset;
+}
@@ -4,11 +4,13 @@
 #include <cstdint>
 
 #include "mirage_base/auto_ptr/shared.hpp"
+#include "mirage_base/container/array.hpp"
 #include "mirage_base/memory/aligned_buffer.hpp"
 #include "mirage_ecs/component/component_bundle.hpp"
 #include "mirage_ecs/define/export.hpp"
 #include "mirage_ecs/entity/archetype_descriptor.hpp"
 #include "mirage_ecs/entity/generation_id.hpp"
+#include "mirage_ecs/util/tick.hpp"
 
 namespace mirage::ecs {
 
@@ -16,6 +18,9 @@ class ArchetypeDataBuffer {
   using Buffer = base::AlignedBuffer;
   using SharedDescriptor = base::SharedLocal<ArchetypeDescriptor>;
 
+  template <typename T>
+  using Array = base::Array<T>;
+
  public:
   class ConstView;
   class View;
@@ -36,33 +41,78 @@ class ArchetypeDataBuffer {
 
   MIRAGE_ECS void Push(const EntityId& id, ComponentBundle& bundle);
   MIRAGE_ECS void Push(View&& view);
+  // Append `cnt` rows whose components the caller constructs in place, e.g.
+  // by copying raw bytes. Returns the first row.
+  MIRAGE_ECS std::byte* PushUninitialized(const EntityId* id_ptr,
+                                          uint16_t cnt);
 
   MIRAGE_ECS void RemoveTail();
   MIRAGE_ECS void Clear();
   MIRAGE_ECS void Reserve(size_t byte_size);
+  // Replace the rows of `dst`, whose descriptor has the same layout, with
+  // copies of these. Its buffer is reused if it has the same size. Bytewise
+  // columns are copied with the rows in one go, the others are then cloned
+  // over them one by one.
+  MIRAGE_ECS void CloneInto(ArchetypeDataBuffer& dst) const;
+
+  // Merge the column ticks of a buffer with the same descriptor, used when
+  // entities are moved between chunks of one archetype. Counts as a row
+  // change of this buffer.
+  MIRAGE_ECS void MergeTicks(const ArchetypeDataBuffer& other);
+
+  // Chunk-level skip checks, false for components the chunk does not have.
+  [[nodiscard]] MIRAGE_ECS bool IsColumnAdded(ComponentId id,
+                                              Tick last_run_tick) const;
+  // Whether the column was written, or its rows were shifted, after
+  // `last_run_tick`. A chunk for which it is false holds the same values at
+  // the same rows as back then.
+  [[nodiscard]] MIRAGE_ECS bool IsColumnChanged(ComponentId id,
+                                                Tick last_run_tick) const;
 
   [[nodiscard]] MIRAGE_ECS const SharedDescriptor& descriptor() const;
 
   [[nodiscard]] MIRAGE_ECS const Buffer& buffer() const;
+  // Entity ids of the rows, packed at the end of the buffer.
+  [[nodiscard]] MIRAGE_ECS const EntityId* entity_id_data() const;
   [[nodiscard]] MIRAGE_ECS uint16_t size() const;
   [[nodiscard]] MIRAGE_ECS uint16_t capacity() const;
   [[nodiscard]] MIRAGE_ECS bool is_full() const;
   [[nodiscard]] MIRAGE_ECS static size_t unit_size(
       ArchetypeDescriptor& descriptor);
 
+  [[nodiscard]] MIRAGE_ECS const Array<ComponentTicks>& column_ticks() const;
+  // Last tick rows were added to, removed from or moved into the chunk,
+  // which shifts them without touching the column ticks.
+  [[nodiscard]] MIRAGE_ECS Tick row_tick() const;
+  [[nodiscard]] MIRAGE_ECS Tick change_tick() const;
+  // Stamp writes with the tick `change_tick` points to, which its owner
+  // advances in place.
+  MIRAGE_ECS void BindChangeTick(const Tick* change_tick);
+
  private:
+  // Drop the tail row without counting it as a row change.
+  MIRAGE_ECS void DestructTail();
+
   SharedDescriptor descriptor_{nullptr};
 
   Buffer buffer_;
   uint16_t size_{0};
   uint16_t capacity_{0};
+
+  // Ticks are tracked per column of the whole chunk, so a system can skip the
+  // chunk entirely when nothing inside has been touched since its last run.
+  Array<ComponentTicks> column_ticks_;
+  Tick row_tick_{kInitTick};
+  // Shared by every chunk of the entity manager, so advancing the tick
+  // does not have to visit them.
+  const Tick* change_tick_{&kInitTick};
 };
 
 class MIRAGE_ECS ArchetypeDataBuffer::ConstView {
  public:
   ConstView() = default;
   ConstView(const ArchetypeDescriptor* descriptor, const std::byte* view_ptr,
-            const EntityId* entity_id_ptr);
+            const EntityId* entity_id_ptr, const ComponentTicks* ticks_ptr);
   ConstView(const View& view);  // NOLINT: Convert from View
 
   ~ConstView() = default;
@@ -77,7 +127,7 @@ class MIRAGE_ECS ArchetypeDataBuffer::ConstView {
 
   template <IsComponent T>
   const T* TryGet() const {
-    return static_cast<T*>(TryGet(ComponentId::Of<T>()));
+    return static_cast<const T*>(TryGet(ComponentId::Of<T>()));
   }
 
   template <IsComponent T>
@@ -86,18 +136,20 @@ class MIRAGE_ECS ArchetypeDataBuffer::ConstView {
   }
 
   [[nodiscard]] const EntityId& entity_id() const;
+  [[nodiscard]] const ComponentTicks* TryGetTicks(ComponentId id) const;
 
  private:
   const ArchetypeDescriptor* descriptor_{nullptr};
   const std::byte* view_ptr_{nullptr};
   const EntityId* entity_id_ptr_{nullptr};
+  const ComponentTicks* ticks_ptr_{nullptr};
 };
 
 class MIRAGE_ECS ArchetypeDataBuffer::View {
  public:
   View() = default;
   View(const ArchetypeDescriptor* descriptor, std::byte* view_ptr,
-       EntityId* entity_id_ptr);
+       EntityId* entity_id_ptr, ComponentTicks* ticks_ptr, Tick change_tick);
 
   ~View() = default;
 
@@ -108,11 +160,12 @@ class MIRAGE_ECS ArchetypeDataBuffer::View {
   View& operator=(View&&) noexcept = default;
 
   [[nodiscard]] const void* TryGet(ComponentId id) const;
-  [[nodiscard]] void* TryGet(ComponentId id);
+  // Write access, which marks the component column as changed.
+  [[nodiscard]] void* TryGetMut(ComponentId id);
 
   template <IsComponent T>
   const T* TryGet() const {
-    return static_cast<T*>(TryGet(ComponentId::Of<T>()));
+    return static_cast<const T*>(TryGet(ComponentId::Of<T>()));
   }
 
   template <IsComponent T>
@@ -121,26 +174,32 @@ class MIRAGE_ECS ArchetypeDataBuffer::View {
   }
 
   template <IsComponent T>
-  T* TryGet() {
-    return static_cast<T*>(TryGet(ComponentId::Of<T>()));
+  T* TryGetMut() {
+    return static_cast<T*>(TryGetMut(ComponentId::Of<T>()));
   }
 
   template <IsComponent T>
-  T& Get() {
-    return *TryGet<T>();
+  T& GetMut() {
+    return *TryGetMut<T>();
   }
 
   std::byte* view_ptr();
 
   EntityId& entity_id();
   [[nodiscard]] const EntityId& entity_id() const;
+  [[nodiscard]] const ComponentTicks* TryGetTicks(ComponentId id) const;
 
  private:
+  friend class ArchetypeDataBuffer;
   friend class ConstView;
 
+  [[nodiscard]] void* TryGetUntracked(ComponentId id) const;
+
   const ArchetypeDescriptor* descriptor_{nullptr};
   std::byte* view_ptr_{nullptr};
   EntityId* entity_id_ptr_{nullptr};
+  ComponentTicks* ticks_ptr_{nullptr};
+  Tick change_tick_{kInitTick};
 };
 
 }  // namespace mirage::ecs
@@ -1,12 +1,29 @@
 #include "mirage_ecs/entity/buffer/sparse_dense_buffer.hpp"
 
+#include <cstring>
 #include <new>  // IWYU pragma: keep
 #include <utility>
 
 #include "mirage_base/define/check.hpp"
 
+using namespace mirage::base;
 using namespace mirage::ecs;
 
+namespace {
+
+void CloneBuffer(const AlignedBuffer& src, AlignedBuffer& dst) {
+  if (src.size() == 0) {
+    dst = {};
+    return;
+  }
+  if (dst.size() != src.size() || dst.align() != src.align()) {
+    dst = {src.size(), src.align()};
+  }
+  std::memcpy(dst.ptr(), src.ptr(), src.size());
+}
+
+}  // namespace
+
 DenseBuffer::DenseBuffer(Buffer&& buffer)
     : buffer_(std::move(buffer)),
       capacity_(static_cast<uint16_t>(buffer_.size()) / kUnitSize) {
@@ -72,6 +89,12 @@ void DenseBuffer::Reserve(const size_t byte_size) {
   }
 }
 
+void DenseBuffer::CloneInto(DenseBuffer& dst) const {
+  CloneBuffer(buffer_, dst.buffer_);
+  dst.size_ = size_;
+  dst.capacity_ = capacity_;
+}
+
 const DenseBuffer::Buffer& DenseBuffer::buffer() const { return buffer_; }
 
 uint16_t DenseBuffer::size() const { return size_; }
@@ -202,6 +225,13 @@ void SparseBuffer::Reserve(const size_t byte_size) {
   hole_cnt_ = capacity_ - size_;
 }
 
+void SparseBuffer::CloneInto(SparseBuffer& dst) const {
+  CloneBuffer(buffer_, dst.buffer_);
+  dst.size_ = size_;
+  dst.hole_cnt_ = hole_cnt_;
+  dst.capacity_ = capacity_;
+}
+
 const SparseBuffer::Buffer& SparseBuffer::buffer() const { return buffer_; }
 
 uint16_t SparseBuffer::size() const { return size_; }
@@ -38,6 +38,8 @@ class MIRAGE_ECS DenseBuffer {
   void Push(SparseId sparse_id);
   void RemoveTail();
   void Reserve(size_t byte_size);
+  // Copy into `dst`, reusing its buffer if it has the same size.
+  void CloneInto(DenseBuffer& dst) const;
 
   [[nodiscard]] const Buffer& buffer() const;
   [[nodiscard]] uint16_t size() const;
@@ -73,6 +75,7 @@ class MIRAGE_ECS SparseBuffer {
   [[nodiscard]] uint16_t FillHole(DenseId dense_id);
   DenseId Remove(uint16_t index);
   void Reserve(size_t byte_size);
+  void CloneInto(SparseBuffer& dst) const;
 
   [[nodiscard]] const Buffer& buffer() const;
   [[nodiscard]] uint16_t size() const;
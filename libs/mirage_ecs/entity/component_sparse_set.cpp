@@ -0,0 +1,253 @@
+#include "mirage_ecs/entity/component_sparse_set.hpp"
+
+#include <cstring>
+#include <utility>
+
+#include "mirage_base/define/check.hpp"
+#include "mirage_base/memory/alloc_hook.hpp"
+
+using namespace mirage::base;
+using namespace mirage::ecs;
+
+ComponentSparseSet::ComponentSparseSet(const ComponentId& component_id)
+    : component_id_(component_id) {}
+
+ComponentSparseSet::~ComponentSparseSet() { Clear(); }
+
+ComponentSparseSet::ComponentSparseSet(ComponentSparseSet&& other) noexcept
+    : component_id_(other.component_id_),
+      sparse_page_array_(std::move(other.sparse_page_array_)),
+      entity_array_(std::move(other.entity_array_)),
+      ticks_array_(std::move(other.ticks_array_)),
+      buffer_(std::move(other.buffer_)),
+      capacity_(other.capacity_),
+      change_tick_(other.change_tick_) {
+  other.capacity_ = 0;
+}
+
+ComponentSparseSet& ComponentSparseSet::operator=(
+    ComponentSparseSet&& other) noexcept {
+  if (this != &other) {
+    this->~ComponentSparseSet();
+    new (this) ComponentSparseSet(std::move(other));
+  }
+  return *this;
+}
+
+void ComponentSparseSet::Insert(const EntityId& entity_id,
+                                BoxComponent&& component) {
+  MIRAGE_DCHECK(entity_id.is_valid());
+  MIRAGE_DCHECK(component.type_id() == component_id_.type_id());
+  auto& dense_id = EnsureSparseSlot(entity_id.index());
+  // Destroyed entities are removed from every set, so an occupied slot
+  // always belongs to this entity.
+  MIRAGE_DCHECK(dense_id == kInvalidDenseId ||
+                entity_array_[dense_id] == entity_id);
+  if (dense_id != kInvalidDenseId) {
+    auto* component_ptr = GetComponentPtr(dense_id);
+    component_id_.destruct(component_ptr);
+    component_id_.move_construct(component.raw_ptr(), component_ptr);
+    component.Reset();
+    ticks_array_[dense_id].MarkAdded(*change_tick_);
+    return;
+  }
+
+  component_id_.move_construct(component.raw_ptr(),
+                               PushUninitialized(entity_id));
+  component.Reset();
+}
+
+void* ComponentSparseSet::PushUninitialized(const EntityId& entity_id) {
+  MIRAGE_DCHECK(entity_id.is_valid());
+  auto& dense_id = EnsureSparseSlot(entity_id.index());
+  MIRAGE_DCHECK(dense_id == kInvalidDenseId);
+  if (entity_array_.size() == capacity_) {
+    Reserve(capacity_ == 0 ? 4 : capacity_ * 2);
+  }
+  dense_id = entity_array_.size();
+  entity_array_.Push(entity_id);
+  ticks_array_.Emplace();
+  ticks_array_.Tail().MarkAdded(*change_tick_);
+  return GetComponentPtr(dense_id);
+}
+
+bool ComponentSparseSet::Remove(const EntityId& entity_id) {
+  const auto dense_id = GetDenseId(entity_id);
+  if (dense_id == kInvalidDenseId) {
+    return false;
+  }
+
+  // Fill the hole with the dense tail.
+  const auto tail_id = entity_array_.size() - 1;
+  component_id_.destruct(GetComponentPtr(dense_id));
+  if (dense_id != tail_id) {
+    const auto& tail_entity = entity_array_[tail_id];
+    component_id_.move(GetComponentPtr(tail_id), GetComponentPtr(dense_id));
+    sparse_page_array_[tail_entity.index() / kPageSize]
+                      [tail_entity.index() % kPageSize] = dense_id;
+    entity_array_[dense_id] = tail_entity;
+    ticks_array_[dense_id] = ticks_array_[tail_id];
+  }
+  sparse_page_array_[entity_id.index() / kPageSize]
+                    [entity_id.index() % kPageSize] = kInvalidDenseId;
+  entity_array_.RemoveTail();
+  ticks_array_.RemoveTail();
+  return true;
+}
+
+void ComponentSparseSet::Clear() {
+  for (size_t i = 0; i < entity_array_.size(); ++i) {
+    component_id_.destruct(GetComponentPtr(i));
+  }
+  entity_array_.Clear();
+  ticks_array_.Clear();
+  sparse_page_array_.Clear();
+}
+
+void ComponentSparseSet::CloneInto(ComponentSparseSet& dst) const {
+  MIRAGE_DCHECK(component_id_ == dst.component_id_);
+  const bool is_bytewise = component_id_.is_bytewise_serializable();
+  if (!is_bytewise) {
+    for (size_t i = 0; i < dst.entity_array_.size(); ++i) {
+      component_id_.destruct(dst.GetComponentPtr(i));
+    }
+  }
+  if (dst.capacity_ < entity_array_.size()) {
+    MIRAGE_ALLOC_TAG("sparse_set.data");
+    const auto type_id = component_id_.type_id();
+    dst.buffer_ = {capacity_ * type_id.type_size(), type_id.type_align()};
+    dst.capacity_ = capacity_;
+  }
+  dst.sparse_page_array_.set_size(sparse_page_array_.size());
+  for (size_t i = 0; i < sparse_page_array_.size(); ++i) {
+    dst.sparse_page_array_[i] = sparse_page_array_[i];
+  }
+  dst.entity_array_ = entity_array_;
+  dst.ticks_array_ = ticks_array_;
+
+  if (is_bytewise) {
+    if (!entity_array_.empty()) {
+      std::memcpy(dst.buffer_.ptr(), buffer_.ptr(),
+                  size() * component_id_.type_id().type_size());
+    }
+  } else {
+    for (size_t i = 0; i < entity_array_.size(); ++i) {
+      component_id_.clone(
+          const_cast<ComponentSparseSet*>(this)->GetComponentPtr(i),
+          dst.GetComponentPtr(i));
+    }
+  }
+}
+
+bool ComponentSparseSet::Contains(const EntityId& entity_id) const {
+  return GetDenseId(entity_id) != kInvalidDenseId;
+}
+
+const void* ComponentSparseSet::TryGet(const EntityId& entity_id) const {
+  const auto dense_id = GetDenseId(entity_id);
+  if (dense_id == kInvalidDenseId) {
+    return nullptr;
+  }
+  return const_cast<ComponentSparseSet*>(this)->GetComponentPtr(dense_id);
+}
+
+void* ComponentSparseSet::TryGetMut(const EntityId& entity_id) {
+  const auto dense_id = GetDenseId(entity_id);
+  if (dense_id == kInvalidDenseId) {
+    return nullptr;
+  }
+  ticks_array_[dense_id].MarkChanged(*change_tick_);
+  return GetComponentPtr(dense_id);
+}
+
+const ComponentTicks* ComponentSparseSet::TryGetTicks(
+    const EntityId& entity_id) const {
+  const auto dense_id = GetDenseId(entity_id);
+  if (dense_id == kInvalidDenseId) {
+    return nullptr;
+  }
+  return &ticks_array_[dense_id];
+}
+
+const ComponentId& ComponentSparseSet::component_id() const {
+  return component_id_;
+}
+
+const Array<EntityId>& ComponentSparseSet::entity_array() const {
+  return entity_array_;
+}
+
+size_t ComponentSparseSet::size() const { return entity_array_.size(); }
+
+size_t ComponentSparseSet::allocated_bytes() const {
+  size_t bytes = buffer_.size() +
+                 entity_array_.capacity() * sizeof(EntityId) +
+                 ticks_array_.capacity() * sizeof(ComponentTicks) +
+                 sparse_page_array_.capacity() * sizeof(Array<DenseId>);
+  for (const auto& page : sparse_page_array_) {
+    bytes += page.capacity() * sizeof(DenseId);
+  }
+  return bytes;
+}
+
+size_t ComponentSparseSet::used_bytes() const {
+  // Every live component also takes one slot of a sparse page.
+  return size() * (component_id_.type_id().type_size() + sizeof(EntityId) +
+                   sizeof(ComponentTicks) + sizeof(DenseId));
+}
+
+Tick ComponentSparseSet::change_tick() const { return *change_tick_; }
+
+void ComponentSparseSet::BindChangeTick(const Tick* change_tick) {
+  change_tick_ = change_tick;
+}
+
+DenseId ComponentSparseSet::GetDenseId(const EntityId& entity_id) const {
+  if (!entity_id.is_valid()) {
+    return kInvalidDenseId;
+  }
+  const auto page_id = entity_id.index() / kPageSize;
+  if (page_id >= sparse_page_array_.size() ||
+      sparse_page_array_[page_id].empty()) {
+    return kInvalidDenseId;
+  }
+  const auto dense_id =
+      sparse_page_array_[page_id][entity_id.index() % kPageSize];
+  if (dense_id == kInvalidDenseId || !(entity_array_[dense_id] == entity_id)) {
+    return kInvalidDenseId;
+  }
+  return dense_id;
+}
+
+DenseId& ComponentSparseSet::EnsureSparseSlot(const size_t entity_index) {
+  const auto page_id = entity_index / kPageSize;
+  while (sparse_page_array_.size() <= page_id) {
+    sparse_page_array_.Emplace();
+  }
+  auto& page = sparse_page_array_[page_id];
+  if (page.empty()) {
+    page.Reserve(kPageSize);
+    for (size_t i = 0; i < kPageSize; ++i) {
+      page.Push(kInvalidDenseId);
+    }
+  }
+  return page[entity_index % kPageSize];
+}
+
+std::byte* ComponentSparseSet::GetComponentPtr(const DenseId dense_id) {
+  MIRAGE_DCHECK(dense_id < capacity_);
+  return buffer_.ptr() + dense_id * component_id_.type_id().type_size();
+}
+
+void ComponentSparseSet::Reserve(const size_t capacity) {
+  MIRAGE_DCHECK(capacity > capacity_);
+  MIRAGE_ALLOC_TAG("sparse_set.data");
+  const auto type_id = component_id_.type_id();
+  AlignedBuffer buffer(capacity * type_id.type_size(), type_id.type_align());
+  for (size_t i = 0; i < entity_array_.size(); ++i) {
+    component_id_.move(GetComponentPtr(i),
+                       buffer.ptr() + i * type_id.type_size());
+  }
+  buffer_ = std::move(buffer);
+  capacity_ = capacity;
+}
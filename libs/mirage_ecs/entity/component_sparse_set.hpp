@@ -0,0 +1,82 @@
+#ifndef MIRAGE_ECS_ENTITY_COMPONENT_SPARSE_SET
+#define MIRAGE_ECS_ENTITY_COMPONENT_SPARSE_SET
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_base/memory/aligned_buffer.hpp"
+#include "mirage_ecs/component/component_handler.hpp"
+#include "mirage_ecs/define/export.hpp"
+#include "mirage_ecs/entity/buffer/sparse_dense_buffer.hpp"
+#include "mirage_ecs/entity/generation_id.hpp"
+#include "mirage_ecs/util/marker.hpp"
+#include "mirage_ecs/util/tick.hpp"
+
+namespace mirage::ecs {
+
+// Storage of one sparse-set component type. Components are packed densely,
+// and a paged sparse index maps entity indices to dense slots.
+class ComponentSparseSet {
+  template <typename T>
+  using Array = base::Array<T>;
+
+ public:
+  constexpr static size_t kPageSize = 1024;
+
+  MIRAGE_ECS explicit ComponentSparseSet(const ComponentId &component_id);
+  MIRAGE_ECS ~ComponentSparseSet();
+
+  ComponentSparseSet(const ComponentSparseSet &) = delete;
+  ComponentSparseSet &operator=(const ComponentSparseSet &) = delete;
+
+  MIRAGE_ECS ComponentSparseSet(ComponentSparseSet &&other) noexcept;
+  MIRAGE_ECS ComponentSparseSet &operator=(
+      ComponentSparseSet &&other) noexcept;
+
+  // Move the component into the set, replacing the one the entity already has.
+  MIRAGE_ECS void Insert(const EntityId &entity_id, BoxComponent &&component);
+  // Add a slot for an entity not in the set yet, for the caller to construct
+  // the component in.
+  MIRAGE_ECS void *PushUninitialized(const EntityId &entity_id);
+  MIRAGE_ECS bool Remove(const EntityId &entity_id);
+  MIRAGE_ECS void Clear();
+  // Make `dst`, a set of the same component, a copy of this one, reusing its
+  // storage when it is large enough.
+  MIRAGE_ECS void CloneInto(ComponentSparseSet &dst) const;
+
+  [[nodiscard]] MIRAGE_ECS bool Contains(const EntityId &entity_id) const;
+  [[nodiscard]] MIRAGE_ECS const void *TryGet(const EntityId &entity_id) const;
+  // Write access, which marks the component as changed.
+  MIRAGE_ECS void *TryGetMut(const EntityId &entity_id);
+  [[nodiscard]] MIRAGE_ECS const ComponentTicks *TryGetTicks(
+      const EntityId &entity_id) const;
+
+  [[nodiscard]] MIRAGE_ECS const ComponentId &component_id() const;
+  // Dense entity array, in storage order.
+  [[nodiscard]] MIRAGE_ECS const Array<EntityId> &entity_array() const;
+  [[nodiscard]] MIRAGE_ECS size_t size() const;
+  // Bytes of the components, their entity ids and ticks, and the sparse pages.
+  [[nodiscard]] MIRAGE_ECS size_t allocated_bytes() const;
+  // The part of `allocated_bytes` taken by live components.
+  [[nodiscard]] MIRAGE_ECS size_t used_bytes() const;
+
+  [[nodiscard]] MIRAGE_ECS Tick change_tick() const;
+  // See `ArchetypeDataBuffer::BindChangeTick`.
+  MIRAGE_ECS void BindChangeTick(const Tick *change_tick);
+
+ private:
+  [[nodiscard]] MIRAGE_ECS DenseId GetDenseId(const EntityId &entity_id) const;
+  MIRAGE_ECS DenseId &EnsureSparseSlot(size_t entity_index);
+  MIRAGE_ECS std::byte *GetComponentPtr(DenseId dense_id);
+  MIRAGE_ECS void Reserve(size_t capacity);
+
+  ComponentId component_id_;
+  Array<Array<DenseId>> sparse_page_array_;
+  Array<EntityId> entity_array_;
+  Array<ComponentTicks> ticks_array_;
+  base::AlignedBuffer buffer_;
+  size_t capacity_{0};
+  const Tick *change_tick_{&kInitTick};
+};
+
+}  // namespace mirage::ecs
+
+#endif  // MIRAGE_ECS_ENTITY_COMPONENT_SPARSE_SET
@@ -0,0 +1,449 @@
+#include "mirage_ecs/entity/entity_manager.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "mirage_base/define/check.hpp"
+#include "mirage_base/profile/profiler.hpp"
+
+using namespace mirage::base;
+using namespace mirage::ecs;
+
+using View = EntityManager::View;
+using ConstView = EntityManager::ConstView;
+
+EntityId EntityManager::Create(ComponentBundle &bundle) {
+  MIRAGE_DCHECK(bundle.size() > 0);
+
+  for (const auto &kv : bundle.component_map()) {
+    if (kv.key().is_relation() &&
+        !Contains(*kv.key().relation_target(kv.val().raw_ptr()))) {
+      return {};
+    }
+  }
+
+  // Sparse-set components are not part of the archetype.
+  ComponentIdArray sparse_id_array;
+  for (const auto &kv : bundle.component_map()) {
+    if (kv.key().storage_type() == StorageType::kSparseSet) {
+      sparse_id_array.Push(kv.key());
+    }
+  }
+  Array<BoxComponent> sparse_component_array;
+  sparse_component_array.Reserve(sparse_id_array.size());
+  for (const auto &component_id : sparse_id_array) {
+    sparse_component_array.Emplace(bundle.Remove(component_id).Unwrap());
+  }
+
+  const auto archetype_id = FindOrCreateArchetype(
+      bundle.MakeTypeSet(), bundle.MakeComponentIdArray());
+  const auto entity_id = AllocateEntityId();
+
+  auto &archetype = archetype_array_[archetype_id.index()];
+  const auto index = archetype.Push(entity_id, bundle);
+  auto &route = entity_route_array_[entity_id.index()];
+  route.archetype_id = archetype_id;
+  route.entity_index = index;
+  ++size_;
+
+  const auto &relation_array = archetype.descriptor().relation_array();
+  if (!relation_array.empty()) {
+    const auto view = std::as_const(archetype)[index];
+    for (const auto &relation : relation_array) {
+      const auto *target = relation.relation_target(view.TryGet(relation));
+      relation_index_.Add(relation, entity_id, *target);
+    }
+  }
+
+  for (size_t i = 0; i < sparse_id_array.size(); ++i) {
+    GetOrCreateSparseSet(sparse_id_array[i])
+        .Insert(entity_id, std::move(sparse_component_array[i]));
+  }
+  return entity_id;
+}
+
+void EntityManager::Destroy(const EntityId &entity_id) {
+  DestroyWithoutCleanup(entity_id);
+  CleanupRelations({entity_id});
+}
+
+void EntityManager::DestroyMany(const Array<EntityId> &entity_id_array) {
+  for (const auto &entity_id : entity_id_array) {
+    DestroyWithoutCleanup(entity_id);
+  }
+  CleanupRelations(entity_id_array);
+}
+
+View EntityManager::Get(const EntityId &entity_id) {
+  MIRAGE_DCHECK(Contains(entity_id));
+  const auto &route = entity_route_array_[entity_id.index()];
+  return archetype_array_[route.archetype_id.index()][route.entity_index];
+}
+
+ConstView EntityManager::Get(const EntityId &entity_id) const {
+  MIRAGE_DCHECK(Contains(entity_id));
+  const auto &route = entity_route_array_[entity_id.index()];
+  return archetype_array_[route.archetype_id.index()][route.entity_index];
+}
+
+void EntityManager::AddSparseComponent(const EntityId &entity_id,
+                                       const ComponentId &component_id,
+                                       BoxComponent &&component) {
+  MIRAGE_DCHECK(Contains(entity_id));
+  MIRAGE_DCHECK(component_id.storage_type() == StorageType::kSparseSet);
+  GetOrCreateSparseSet(component_id).Insert(entity_id, std::move(component));
+}
+
+bool EntityManager::RemoveSparseComponent(const EntityId &entity_id,
+                                          const ComponentId &component_id) {
+  const auto it = sparse_set_map_.TryFind(component_id.type_id());
+  if (!it) {
+    return false;
+  }
+  return it->val().Remove(entity_id);
+}
+
+void *EntityManager::TryGetComponent(const EntityId &entity_id,
+                                     const ComponentId &component_id) {
+  if (!Contains(entity_id)) {
+    return nullptr;
+  }
+  if (component_id.storage_type() == StorageType::kSparseSet) {
+    const auto it = sparse_set_map_.TryFind(component_id.type_id());
+    return it ? it->val().TryGetMut(entity_id) : nullptr;
+  }
+  return Get(entity_id).TryGetMut(component_id);
+}
+
+const void *EntityManager::TryGetComponent(
+    const EntityId &entity_id, const ComponentId &component_id) const {
+  if (!Contains(entity_id)) {
+    return nullptr;
+  }
+  if (component_id.storage_type() == StorageType::kSparseSet) {
+    const auto it = sparse_set_map_.TryFind(component_id.type_id());
+    return it ? std::as_const(it->val()).TryGet(entity_id) : nullptr;
+  }
+  return Get(entity_id).TryGet(component_id);
+}
+
+bool EntityManager::HasComponent(const EntityId &entity_id,
+                                 const TypeId &type_id) const {
+  MIRAGE_DCHECK(Contains(entity_id));
+  const auto &route = entity_route_array_[entity_id.index()];
+  const auto &archetype = archetype_array_[route.archetype_id.index()];
+  if (archetype.descriptor().type_set().With(type_id)) {
+    return true;
+  }
+  const auto it = sparse_set_map_.TryFind(type_id);
+  return it && it->val().Contains(entity_id);
+}
+
+bool EntityManager::Matches(const EntityId &entity_id, const TypeSet &with,
+                            const TypeSet &without) const {
+  MIRAGE_DCHECK(Contains(entity_id));
+  const auto &route = entity_route_array_[entity_id.index()];
+  const auto &type_set =
+      archetype_array_[route.archetype_id.index()].descriptor().type_set();
+  if (sparse_set_map_.empty()) {
+    return type_set.With(with) && type_set.Without(without);
+  }
+  for (const auto &type_id : with.type_array()) {
+    if (!HasComponent(entity_id, type_id)) {
+      return false;
+    }
+  }
+  for (const auto &type_id : without.type_array()) {
+    if (HasComponent(entity_id, type_id)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+const ComponentSparseSet *EntityManager::TryGetSparseSet(
+    const TypeId &type_id) const {
+  const auto it = sparse_set_map_.TryFind(type_id);
+  return it ? &it->val() : nullptr;
+}
+
+bool EntityManager::Contains(const EntityId &entity_id) const {
+  if (!entity_id.is_valid() ||
+      entity_id.index() >= entity_route_array_.size()) {
+    return false;
+  }
+  const auto &route = entity_route_array_[entity_id.index()];
+  if (!route.archetype_id.is_valid()) {
+    return false;
+  }
+  const auto &archetype = archetype_array_[route.archetype_id.index()];
+  return archetype[route.entity_index].entity_id() == entity_id;
+}
+
+const Array<EntityId> *EntityManager::TryGetSources(
+    const ComponentId &relation, const EntityId &target) const {
+  return relation_index_.TryGetSources(relation, target);
+}
+
+size_t EntityManager::size() const { return size_; }
+
+const Array<Archetype> &EntityManager::archetype_array() const {
+  return archetype_array_;
+}
+
+EntityMemory EntityManager::MemoryReport() const {
+  EntityMemory report;
+  report.entity_cnt = size_;
+  // Components in the order they are first seen.
+  HashMap<TypeId, size_t> component_index_map;
+  auto get_component = [&](const ComponentId &component_id) -> auto & {
+    const auto type_id = component_id.type_id();
+    const auto iter = component_index_map.TryFind(type_id);
+    if (iter != component_index_map.end()) {
+      return report.component_array[iter->val()];
+    }
+    component_index_map.Insert(type_id, report.component_array.size());
+    report.component_array.Push(
+        {.type_id = type_id, .storage_type = component_id.storage_type()});
+    return report.component_array.Tail();
+  };
+
+  report.archetype_array.Reserve(archetype_array_.size());
+  for (const auto &archetype : archetype_array_) {
+    auto memory = archetype.memory_usage();
+    report.allocated_bytes += memory.allocated_bytes();
+    report.used_bytes += memory.used_bytes();
+
+    const auto data_capacity = archetype.data_capacity();
+    for (const auto &kv : archetype.descriptor().offset_map()) {
+      auto &component = get_component(kv.key());
+      const auto type_size = kv.key().type_id().type_size();
+      component.entity_cnt += memory.entity_cnt;
+      component.allocated_bytes += type_size * data_capacity;
+      component.used_bytes += type_size * memory.entity_cnt;
+    }
+    report.archetype_array.Push(std::move(memory));
+  }
+
+  for (const auto &kv : sparse_set_map_) {
+    const auto &sparse_set = kv.val();
+    auto &component = get_component(sparse_set.component_id());
+    component.entity_cnt += sparse_set.size();
+    component.allocated_bytes += sparse_set.allocated_bytes();
+    component.used_bytes += sparse_set.used_bytes();
+    report.allocated_bytes += sparse_set.allocated_bytes();
+    report.used_bytes += sparse_set.used_bytes();
+  }
+
+  report.bookkeeping_bytes =
+      entity_route_array_.capacity() * sizeof(Route) +
+      available_entity_id_.capacity() * sizeof(EntityId) +
+      archetype_array_.capacity() * sizeof(Archetype);
+  report.allocated_bytes += report.bookkeeping_bytes;
+  report.used_bytes += size_ * sizeof(Route);
+  return report;
+}
+
+bool EntityManager::CloneInto(EntityManager &dst) const {
+  MIRAGE_PROFILE_ZONE("EntityManager::CloneInto");
+  auto is_cloneable = [](const ComponentId &component_id) {
+    return component_id.is_bytewise_serializable() ||
+           component_id.is_cloneable();
+  };
+  for (const auto &archetype : archetype_array_) {
+    for (const auto &entry : archetype.descriptor().offset_map()) {
+      if (!is_cloneable(entry.key())) {
+        return false;
+      }
+    }
+  }
+  for (const auto &kv : sparse_set_map_) {
+    if (!is_cloneable(kv.val().component_id())) {
+      return false;
+    }
+  }
+
+  bool is_layout_changed =
+      dst.archetype_array_.size() != archetype_array_.size();
+  dst.archetype_array_.set_size(
+      std::min(dst.archetype_array_.size(), archetype_array_.size()));
+  for (size_t i = 0; i < archetype_array_.size(); ++i) {
+    const auto &descriptor = archetype_array_[i].descriptor();
+    if (i == dst.archetype_array_.size()) {
+      dst.archetype_array_.Emplace(SharedDescriptor::New(descriptor.Clone()));
+      dst.archetype_array_.Tail().BindChangeTick(dst.change_tick_.raw_ptr());
+    } else if (!descriptor.IsSameLayout(
+                   dst.archetype_array_[i].descriptor())) {
+      dst.archetype_array_[i] =
+          Archetype(SharedDescriptor::New(descriptor.Clone()));
+      dst.archetype_array_[i].BindChangeTick(dst.change_tick_.raw_ptr());
+      is_layout_changed = true;
+    }
+    archetype_array_[i].CloneInto(dst.archetype_array_[i]);
+  }
+  if (is_layout_changed) {
+    dst.archetype_route_map_ = {};
+    for (const auto &kv : archetype_route_map_) {
+      dst.archetype_route_map_.Insert(kv.key().Clone(), kv.val());
+    }
+  }
+  dst.available_archetype_id_ = available_archetype_id_;
+
+  dst.available_entity_id_ = available_entity_id_;
+  dst.entity_route_array_ = entity_route_array_;
+  dst.size_ = size_;
+
+  // Sets the destination has but this manager does not are left empty.
+  for (auto &kv : dst.sparse_set_map_) {
+    if (!sparse_set_map_.TryFind(kv.key())) {
+      kv.val().Clear();
+    }
+  }
+  for (const auto &kv : sparse_set_map_) {
+    kv.val().CloneInto(dst.GetOrCreateSparseSet(kv.val().component_id()));
+  }
+
+  dst.relation_index_ = RelationIndex();
+  for (const auto &archetype : dst.archetype_array_) {
+    const auto &relation_array = archetype.descriptor().relation_array();
+    if (relation_array.empty()) {
+      continue;
+    }
+    for (const auto &chunk : archetype.chunk_array()) {
+      for (uint16_t i = 0; i < chunk.size(); ++i) {
+        const auto view = chunk[i];
+        for (const auto &relation : relation_array) {
+          dst.relation_index_.Add(
+              relation, view.entity_id(),
+              *relation.relation_target(view.TryGet(relation)));
+        }
+      }
+    }
+  }
+  *dst.change_tick_ = *change_tick_;
+  return true;
+}
+
+Tick EntityManager::change_tick() const { return *change_tick_; }
+
+void EntityManager::set_change_tick(const Tick change_tick) {
+  *change_tick_ = change_tick;
+}
+
+ArchetypeId EntityManager::FindOrCreateArchetype(
+    TypeSet &&type_set, ComponentIdArray &&component_id_array) {
+  if (const auto it = archetype_route_map_.TryFind(type_set)) {
+    return it->val();
+  }
+
+  const ArchetypeId archetype_id(archetype_array_.size(), 0);
+  archetype_array_.Emplace(SharedDescriptor::New(
+      ArchetypeDescriptor(archetype_id, std::move(component_id_array))));
+  archetype_array_.Tail().BindChangeTick(change_tick_.raw_ptr());
+  archetype_route_map_.Insert(std::move(type_set), archetype_id);
+  return archetype_id;
+}
+
+EntityId EntityManager::AllocateEntityId() {
+  if (!available_entity_id_.empty()) {
+    const auto entity_id = available_entity_id_.Pop();
+    return {entity_id.index(), entity_id.generation() + 1};
+  }
+  entity_route_array_.Emplace();
+  return {entity_route_array_.size() - 1, 0};
+}
+
+ComponentSparseSet &EntityManager::GetOrCreateSparseSet(
+    const ComponentId &component_id) {
+  auto it = sparse_set_map_.TryFind(component_id.type_id());
+  if (!it) {
+    ComponentSparseSet sparse_set(component_id);
+    sparse_set.BindChangeTick(change_tick_.raw_ptr());
+    sparse_set_map_.Insert(component_id.type_id(), std::move(sparse_set));
+    it = sparse_set_map_.TryFind(component_id.type_id());
+  }
+  return it->val();
+}
+
+void EntityManager::DestroyWithoutCleanup(const EntityId &entity_id) {
+  MIRAGE_DCHECK(Contains(entity_id));
+  auto &route = entity_route_array_[entity_id.index()];
+  auto &archetype = archetype_array_[route.archetype_id.index()];
+
+  const auto &relation_array = archetype.descriptor().relation_array();
+  if (!relation_array.empty()) {
+    const auto view = std::as_const(archetype)[route.entity_index];
+    for (const auto &relation : relation_array) {
+      const auto *target = relation.relation_target(view.TryGet(relation));
+      relation_index_.Remove(relation, entity_id, *target);
+    }
+  }
+
+  for (auto &kv : sparse_set_map_) {
+    kv.val().Remove(entity_id);
+  }
+  archetype.Remove(route.entity_index);
+  route.archetype_id.Reset();
+  available_entity_id_.Push(entity_id);
+  --size_;
+}
+
+void EntityManager::CleanupRelations(const Array<EntityId> &target_array) {
+  Array<RelationIndex::Pair> pair_array;
+  for (const auto &target : target_array) {
+    for (auto &pair : relation_index_.TakeTarget(target)) {
+      if (Contains(pair.source)) {
+        pair_array.Push(std::move(pair));
+      }
+    }
+  }
+  if (pair_array.empty()) {
+    return;
+  }
+
+  // Sources sharing an archetype and a relation kind move to the same
+  // archetype, so sort them next to each other and resolve it once per run.
+  auto archetype_index = [this](const EntityId &entity_id) {
+    return entity_route_array_[entity_id.index()].archetype_id.index();
+  };
+  std::ranges::sort(pair_array, [&](const auto &lhs, const auto &rhs) {
+    const auto lhs_index = archetype_index(lhs.source);
+    const auto rhs_index = archetype_index(rhs.source);
+    if (lhs_index != rhs_index) {
+      return lhs_index < rhs_index;
+    }
+    return lhs.relation < rhs.relation;
+  });
+
+  ArchetypeId src_id, dst_id;
+  const ComponentId *relation = nullptr;
+  for (const auto &pair : pair_array) {
+    auto &route = entity_route_array_[pair.source.index()];
+    if (!(route.archetype_id == src_id) || *relation != pair.relation) {
+      src_id = route.archetype_id;
+      relation = &pair.relation;
+
+      const auto &descriptor = archetype_array_[src_id.index()].descriptor();
+      auto type_set = descriptor.type_set().Clone();
+      type_set.RemoveTypeId(relation->type_id());
+      ComponentIdArray component_id_array;
+      for (const auto &entry : descriptor.offset_map()) {
+        if (entry.key() != *relation) {
+          component_id_array.Push(entry.key());
+        }
+      }
+      for (const auto &tag : descriptor.tag_array()) {
+        component_id_array.Push(tag);
+      }
+      dst_id = FindOrCreateArchetype(std::move(type_set),
+                                     std::move(component_id_array));
+    }
+
+    auto &src = archetype_array_[src_id.index()];
+    auto &dst = archetype_array_[dst_id.index()];
+    const auto index = dst.Push(src[route.entity_index]);
+    src.Remove(route.entity_index);
+    route.archetype_id = dst_id;
+    route.entity_index = index;
+  }
+}
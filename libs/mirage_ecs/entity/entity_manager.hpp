@@ -1,23 +1,35 @@
 #ifndef MIRAGE_ECS_ENTITY_ENTITY_MANAGER
 #define MIRAGE_ECS_ENTITY_ENTITY_MANAGER
 
+#include "mirage_base/auto_ptr/owned.hpp"
 #include "mirage_base/container/array.hpp"
 #include "mirage_base/container/hash_map.hpp"
+#include "mirage_base/io/byte_stream.hpp"
 #include "mirage_ecs/component/component_bundle.hpp"
+#include "mirage_ecs/component/component_registry.hpp"
+#include "mirage_ecs/component/relation.hpp"
 #include "mirage_ecs/define/export.hpp"
 #include "mirage_ecs/entity/archetype.hpp"
+#include "mirage_ecs/entity/component_sparse_set.hpp"
 #include "mirage_ecs/entity/generation_id.hpp"
+#include "mirage_ecs/entity/memory_report.hpp"
+#include "mirage_ecs/entity/relation_index.hpp"
+#include "mirage_ecs/entity/snapshot_baseline.hpp"
+#include "mirage_ecs/util/tick.hpp"
 #include "mirage_ecs/util/type_set.hpp"
 
 namespace mirage::ecs {
 
 class EntityManager {
+  using TypeId = base::TypeId;
+  using SharedDescriptor = base::SharedLocal<ArchetypeDescriptor>;
+
   template <typename T>
   using Array = base::Array<T>;
 
  public:
-  class View;
-  class ConstView;
+  using View = Archetype::View;
+  using ConstView = Archetype::ConstView;
 
   MIRAGE_ECS EntityManager() = default;
   MIRAGE_ECS ~EntityManager() = default;
@@ -28,13 +40,147 @@ class EntityManager {
   MIRAGE_ECS EntityManager(EntityManager &&other) noexcept = default;
   MIRAGE_ECS EntityManager &operator=(EntityManager &&other) noexcept = default;
 
-  EntityId Create(ComponentBundle &bundle);
-  void Destroy(const EntityId &entity_id);
+  // Returns an invalid id and leaves the bundle untouched when a relation
+  // targets an entity that is not alive.
+  MIRAGE_ECS EntityId Create(ComponentBundle &bundle);
+  // Relation pairs pointing at a destroyed entity are removed from their
+  // sources.
+  MIRAGE_ECS void Destroy(const EntityId &entity_id);
+  // Like `Destroy`, but the relation cleanup runs once for the whole batch.
+  MIRAGE_ECS void DestroyMany(const Array<EntityId> &entity_id_array);
 
   MIRAGE_ECS View Get(const EntityId &entity_id);
   [[nodiscard]] MIRAGE_ECS ConstView Get(const EntityId &entity_id) const;
 
+  [[nodiscard]] MIRAGE_ECS bool Contains(const EntityId &entity_id) const;
+
+  // Sparse-set components can be added and removed without moving the rest
+  // of the entity to another archetype.
+  template <IsComponent T>
+    requires(StorageTypeOf<T>() == StorageType::kSparseSet)
+  void AddComponent(const EntityId &entity_id, T component);
+  template <IsComponent T>
+    requires(StorageTypeOf<T>() == StorageType::kSparseSet)
+  bool RemoveComponent(const EntityId &entity_id);
+  MIRAGE_ECS void AddSparseComponent(const EntityId &entity_id,
+                                     const ComponentId &component_id,
+                                     BoxComponent &&component);
+  MIRAGE_ECS bool RemoveSparseComponent(const EntityId &entity_id,
+                                        const ComponentId &component_id);
+
+  // Component lookups that look through both archetype tables and sparse
+  // sets. The mutable ones count as writes for change detection.
+  template <IsComponent T>
+  T *TryGetComponent(const EntityId &entity_id);
+  template <IsComponent T>
+  const T *TryGetComponent(const EntityId &entity_id) const;
+  MIRAGE_ECS void *TryGetComponent(const EntityId &entity_id,
+                                   const ComponentId &component_id);
+  [[nodiscard]] MIRAGE_ECS const void *TryGetComponent(
+      const EntityId &entity_id, const ComponentId &component_id) const;
+  [[nodiscard]] MIRAGE_ECS bool HasComponent(const EntityId &entity_id,
+                                             const TypeId &type_id) const;
+  // Whether the entity has every component of `with` and none of `without`,
+  // whichever storage they live in.
+  [[nodiscard]] MIRAGE_ECS bool Matches(const EntityId &entity_id,
+                                        const TypeSet &with,
+                                        const TypeSet &without) const;
+
+  [[nodiscard]] MIRAGE_ECS const ComponentSparseSet *TryGetSparseSet(
+      const TypeId &type_id) const;
+
+  // Entities pointing at `target` through the relation kind `R`.
+  template <typename R>
+  const Array<EntityId> *TryGetSources(const EntityId &target) const;
+  [[nodiscard]] MIRAGE_ECS const Array<EntityId> *TryGetSources(
+      const ComponentId &relation, const EntityId &target) const;
+
+  [[nodiscard]] MIRAGE_ECS size_t size() const;
+  // Archetypes are never dropped, so some of them may be empty.
+  [[nodiscard]] MIRAGE_ECS const Array<Archetype> &archetype_array() const;
+
+  // Where the memory of the entity storage goes, per archetype and per
+  // component type. Walks every chunk, so it is meant for tooling.
+  [[nodiscard]] MIRAGE_ECS EntityMemory MemoryReport() const;
+
+  // Write every entity with its components, keeping their ids. Table rows
+  // are written chunk by chunk as they lie in memory; components that are not
+  // bytewise serializable go through their serialize hooks. Fails without
+  // writing anything if a component has neither.
+  MIRAGE_ECS bool SaveSnapshot(base::ByteWriter &writer) const;
+  // Restore a snapshot into this empty manager, looking component types up by
+  // name in `registry`. Loaded components count as added at the current
+  // change tick. On failure the manager holds part of the snapshot and should
+  // be dropped.
+  MIRAGE_ECS bool LoadSnapshot(base::ByteReader &reader,
+                               const ComponentRegistry &registry);
+
+  // Write what changed since `baseline` for a receiver to apply with
+  // `ApplyDelta`; `baseline` then holds the entities as written. Only chunks
+  // whose rows or columns were written since the last delta are visited, and
+  // their rows are XOR-ed per column against the baseline, so spawns, moves
+  // and writes cost about the bytes they change. Columns that are not
+  // bytewise are resent for touched chunks, sparse sets whenever they differ.
+  // Chunks written at the tick of the last delta are visited again, so the
+  // tick should move on between deltas. The first delta of a baseline
+  // replaces every entity of the receiver.
+  // Fails without writing anything if a component can't be serialized.
+  MIRAGE_ECS bool SaveDelta(SnapshotBaseline &baseline,
+                            base::ByteWriter &writer) const;
+  // Apply a delta made against the sequence `baseline` is at, looking new
+  // component types up by name in `registry`. The manager must not be changed
+  // otherwise between deltas. Deltas growing it past `max_entity_cnt` entity
+  // slots are refused. The whole delta is checked before any entity is
+  // touched, so on failure the entities are left as they were. The baseline
+  // may not be, and replication has to restart from fresh baselines.
+  MIRAGE_ECS bool ApplyDelta(SnapshotBaseline &baseline,
+                             base::ByteReader &reader, size_t max_entity_cnt,
+                             const ComponentRegistry &registry);
+
+  // Make `dst` an exact copy of this manager, e.g. to roll back to. Archetypes
+  // keep their index, so a destination that was cloned into before reuses
+  // its chunks and only has their bytes overwritten. Fails without touching
+  // `dst` if a component is neither bytewise nor cloneable.
+  MIRAGE_ECS bool CloneInto(EntityManager &dst) const;
+
+  [[nodiscard]] MIRAGE_ECS Tick change_tick() const;
+  // Constant time: archetypes and sparse sets read the tick through a
+  // pointer instead of keeping copies.
+  MIRAGE_ECS void set_change_tick(Tick change_tick);
+
  private:
+  MIRAGE_ECS ArchetypeId FindOrCreateArchetype(
+      TypeSet &&type_set, ComponentIdArray &&component_id_array);
+  MIRAGE_ECS EntityId AllocateEntityId();
+  MIRAGE_ECS ComponentSparseSet &GetOrCreateSparseSet(
+      const ComponentId &component_id);
+
+  MIRAGE_ECS void DestroyWithoutCleanup(const EntityId &entity_id);
+  MIRAGE_ECS void CleanupRelations(const Array<EntityId> &target_array);
+
+  MIRAGE_ECS bool LoadArchetypeSnapshot(
+      base::ByteReader &reader, const Array<ComponentId> &component_array);
+  MIRAGE_ECS bool LoadSparseSetSnapshot(
+      base::ByteReader &reader, const Array<ComponentId> &component_array);
+
+  // Whether a record was written, which unchanged archetypes skip.
+  MIRAGE_ECS bool SaveArchetypeDelta(SnapshotBaseline &baseline, size_t index,
+                                     bool is_new, Tick dirty_tick,
+                                     base::ByteWriter &writer) const;
+  // `ApplyDelta` past the header.
+  MIRAGE_ECS bool ApplyDeltaRecords(SnapshotBaseline &baseline,
+                                    base::ByteReader &reader,
+                                    size_t max_entity_cnt,
+                                    const ComponentRegistry &registry);
+  MIRAGE_ECS bool LoadArchetypeLayout(SnapshotBaseline &baseline,
+                                      base::ByteReader &reader);
+  // Drop the routes and relations of rows about to be overwritten, and add
+  // them back once they are.
+  MIRAGE_ECS void UnregisterRows(Archetype &archetype, size_t begin,
+                                 size_t end);
+  MIRAGE_ECS void RegisterRows(const ArchetypeId &archetype_id, size_t begin,
+                               size_t end);
+
   Array<ArchetypeId> available_archetype_id_;
   Array<Archetype> archetype_array_;
   base::HashMap<TypeSet, ArchetypeId> archetype_route_map_;
@@ -45,22 +191,45 @@ class EntityManager {
   };
   Array<EntityId> available_entity_id_;
   Array<Route> entity_route_array_;
-};
+  size_t size_{0};
 
-class EntityManager::View {
- public:
-  // TODO
- private:
-  Archetype::View archetype_view_;
-};
+  RelationIndex relation_index_;
+  base::HashMap<TypeId, ComponentSparseSet> sparse_set_map_;
 
-class EntityManager::ConstView {
- public:
-  // TODO
- private:
-  Archetype::ConstView archetype_view_;
+  // On the heap so that it stays put when the manager is moved.
+  base::Owned<Tick> change_tick_{base::Owned<Tick>::New(kInitTick)};
 };
 
+template <IsComponent T>
+  requires(StorageTypeOf<T>() == StorageType::kSparseSet)
+void EntityManager::AddComponent(const EntityId &entity_id, T component) {
+  AddSparseComponent(entity_id, ComponentId::Of<T>(),
+                     BoxComponent(std::move(component)));
+}
+
+template <IsComponent T>
+  requires(StorageTypeOf<T>() == StorageType::kSparseSet)
+bool EntityManager::RemoveComponent(const EntityId &entity_id) {
+  return RemoveSparseComponent(entity_id, ComponentId::Of<T>());
+}
+
+template <IsComponent T>
+T *EntityManager::TryGetComponent(const EntityId &entity_id) {
+  return static_cast<T *>(TryGetComponent(entity_id, ComponentId::Of<T>()));
+}
+
+template <IsComponent T>
+const T *EntityManager::TryGetComponent(const EntityId &entity_id) const {
+  return static_cast<const T *>(
+      TryGetComponent(entity_id, ComponentId::Of<T>()));
+}
+
+template <typename R>
+const base::Array<EntityId> *EntityManager::TryGetSources(
+    const EntityId &target) const {
+  return TryGetSources(ComponentId::Of<Relation<R>>(), target);
+}
+
 }  // namespace mirage::ecs
 
 #endif  // MIRAGE_ECS_ENTITY_ENTITY_MANAGER
@@ -0,0 +1,865 @@
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "mirage_base/container/hash_set.hpp"
+#include "mirage_base/io/byte_delta.hpp"
+#include "mirage_base/memory/aligned_buffer.hpp"
+#include "mirage_base/profile/profiler.hpp"
+#include "mirage_ecs/entity/entity_manager.hpp"
+#include "mirage_ecs/entity/snapshot_io.hpp"
+
+using namespace mirage::base;
+using namespace mirage::ecs;
+using namespace mirage::ecs::snapshot_io;
+
+// Delta layout, in native byte order:
+//
+//   "MDLT", u32 version, u64 base sequence, u8 reset
+//   u32 new component count, per component: name, u64 size, u8 bytewise
+//   u64 entity slot count, u64 kept free id count, u64 new free id count,
+//   new free ids
+//   u32 archetype count, per archetype in increasing index:
+//     u32 index, u8 new
+//     if new: u32 column count, per column: u32 component
+//             u32 tag count, per tag: u32 component
+//     u64 row count, u32 range count, per range: u64 first row, u64 row count
+//     u64 length of the rows, then per range:
+//       u8 moved, if set the runs of the entity ids
+//       per column: u8 changed, if set the runs of the column, or per row
+//       u64 length and serialized component for hooked columns
+//   u32 sparse set count, per set: u32 component, then the set as in a
+//   snapshot
+//
+// Components and archetypes are referred to by their index in the baseline,
+// which new ones are appended to. Runs XOR a range of rows against what the
+// baseline holds for them, zeros and invalid ids past its last row. Hooked
+// columns are sent whole. A reset drops every entity and the baseline first.
+
+namespace {
+
+constexpr char kMagic[4] = {'M', 'D', 'L', 'T'};
+constexpr uint32_t kVersion = 1;
+
+struct RowRange {
+  size_t begin;
+  size_t cnt;
+};
+
+struct ArchetypeRecord {
+  size_t index{0};
+  size_t row_cnt{0};
+  Array<RowRange> range_array;
+  // Entity ids of the ranges once applied, range after range.
+  Array<EntityId> id_array;
+  ByteReader row_reader;
+};
+
+// Whether a hooked component deserializes, tried out in `scratch` and
+// dropped again.
+bool CheckHooked(const ComponentId& component_id, const uint8_t* ptr,
+                 const uint64_t length, AlignedBuffer& scratch) {
+  if (!ptr) {
+    return false;
+  }
+  ByteReader component_reader(ptr, length);
+  if (!component_id.deserialize(component_reader, scratch.ptr())) {
+    return false;
+  }
+  component_id.destruct(scratch.ptr());
+  return component_reader.is_ok();
+}
+
+// Whether the rows of a record can be applied whole, so that applying them
+// never stops halfway through a range. The entity ids the ranges end up with
+// are decoded into `id_array`.
+bool CheckRows(ByteReader reader, const Archetype& archetype,
+               const Array<ComponentId>& column_array,
+               const Array<RowRange>& range_array, Array<EntityId>& id_array) {
+  const auto old_row_cnt = archetype.size();
+  Array<uint8_t> id_bytes;
+  uint64_t length = 0;
+  for (const auto& range : range_array) {
+    // Appended rows start out without an entity or hooked components.
+    const bool is_grown = range.begin + range.cnt > old_row_cnt;
+    const bool is_moved = reader.Read<uint8_t>() != 0;
+    if (is_grown && !is_moved) {
+      return false;
+    }
+    id_bytes.ResizeUninitialized(range.cnt * sizeof(EntityId));
+    for (size_t i = 0; i < range.cnt; ++i) {
+      const auto row = range.begin + i;
+      const auto entity_id = row < old_row_cnt
+                                 ? archetype[archetype.IndexAt(row)].entity_id()
+                                 : EntityId();
+      std::memcpy(id_bytes.data() + i * sizeof(EntityId), &entity_id,
+                  sizeof(EntityId));
+    }
+    if (is_moved &&
+        !ByteDelta::ApplyRuns(reader, id_bytes.data(), id_bytes.size())) {
+      return false;
+    }
+    for (size_t i = 0; i < range.cnt; ++i) {
+      id_array.Push(ReadEntityId(id_bytes.data() + i * sizeof(EntityId)));
+    }
+
+    for (const auto& component_id : column_array) {
+      const bool is_changed = reader.Read<uint8_t>() != 0;
+      if (!is_changed) {
+        if (is_grown && !component_id.is_bytewise_serializable()) {
+          return false;
+        }
+        continue;
+      }
+      const auto& type_id = component_id.type_id();
+      if (component_id.is_bytewise_serializable()) {
+        if (!ByteDelta::ApplyRuns(reader, nullptr,
+                                  range.cnt * type_id.type_size())) {
+          return false;
+        }
+        continue;
+      }
+      AlignedBuffer scratch(type_id.type_size(), type_id.type_align());
+      for (size_t i = 0; i < range.cnt; ++i) {
+        const auto* ptr = SkipHooked(reader, length);
+        if (!CheckHooked(component_id, ptr, length, scratch)) {
+          return false;
+        }
+      }
+    }
+  }
+  return reader.is_ok() && reader.remaining() == 0;
+}
+
+// Like `EntityManager::LoadSparseSetSnapshot`, without loading anything.
+template <typename IsAlive>
+bool CheckSparseSet(ByteReader& reader,
+                    const Array<ComponentId>& component_array,
+                    const IsAlive& is_alive) {
+  const auto* component_id = ReadComponent(reader, component_array);
+  const auto entity_cnt = reader.Read<uint64_t>();
+  if (!component_id ||
+      component_id->storage_type() != StorageType::kSparseSet ||
+      entity_cnt > reader.remaining() / sizeof(EntityId)) {
+    return false;
+  }
+  const auto* id_ptr = reader.Skip(entity_cnt * sizeof(EntityId));
+  const auto& type_id = component_id->type_id();
+  const bool is_bytewise = component_id->is_bytewise_serializable();
+  AlignedBuffer scratch;
+  if (!is_bytewise) {
+    scratch = AlignedBuffer(type_id.type_size(), type_id.type_align());
+  }
+  HashSet<size_t> index_set;
+  uint64_t length = 0;
+  for (uint64_t i = 0; i < entity_cnt; ++i) {
+    const auto entity_id = ReadEntityId(id_ptr + i * sizeof(EntityId));
+    if (!is_alive(entity_id) ||
+        index_set.Insert(entity_id.index()).is_valid()) {
+      return false;
+    }
+    if (is_bytewise) {
+      reader.Skip(type_id.type_size());
+    } else if (!CheckHooked(*component_id, SkipHooked(reader, length), length,
+                            scratch)) {
+      return false;
+    }
+  }
+  return reader.is_ok();
+}
+
+}  // namespace
+
+bool EntityManager::SaveDelta(SnapshotBaseline& baseline,
+                              ByteWriter& writer) const {
+  MIRAGE_PROFILE_ZONE("EntityManager::SaveDelta");
+  for (const auto& archetype : archetype_array_) {
+    if (archetype.size() == 0) {
+      continue;
+    }
+    for (const auto& kv : archetype.descriptor().offset_map()) {
+      if (!kv.key().is_serializable()) {
+        return false;
+      }
+    }
+  }
+  for (const auto& kv : sparse_set_map_) {
+    const auto& component_id = kv.val().component_id();
+    if (kv.val().size() != 0 && !component_id.is_tag() &&
+        !component_id.is_serializable()) {
+      return false;
+    }
+  }
+
+  // Rolling back may leave the manager with fewer archetypes or entity slots
+  // than were sent, or other archetypes under their indices.
+  bool is_reset = baseline.sequence_ == 0 ||
+                  baseline.is_sent_array_.size() > archetype_array_.size() ||
+                  baseline.slot_cnt_ > entity_route_array_.size();
+  for (const auto& state : baseline.archetype_array_) {
+    const auto index = state.archetype_id.index();
+    is_reset = is_reset || index >= archetype_array_.size() ||
+               !(archetype_array_[index].descriptor().type_set() ==
+                 state.type_set);
+  }
+  if (is_reset) {
+    const auto sequence = baseline.sequence_;
+    baseline = SnapshotBaseline();
+    baseline.sequence_ = sequence;
+  }
+  baseline.is_sent_array_.set_size(archetype_array_.size());
+  // It is set back by rolling back, past writes that were sent.
+  const auto dirty_tick =
+      *change_tick_ < baseline.tick_ ? kInitTick : baseline.tick_;
+
+  const auto old_component_cnt = baseline.component_array_.size();
+  auto add_component = [&](const ComponentId& component_id) {
+    const auto type_id = component_id.type_id();
+    if (!baseline.component_index_map_.TryFind(type_id)) {
+      baseline.component_index_map_.Insert(
+          type_id, static_cast<uint32_t>(baseline.component_array_.size()));
+      baseline.component_array_.Push(component_id);
+    }
+  };
+  for (size_t i = 0; i < archetype_array_.size(); ++i) {
+    if (baseline.is_sent_array_[i] || archetype_array_[i].size() == 0) {
+      continue;
+    }
+    const auto& descriptor = archetype_array_[i].descriptor();
+    for (const auto& kv : descriptor.offset_map()) {
+      add_component(kv.key());
+    }
+    for (const auto& tag : descriptor.tag_array()) {
+      add_component(tag);
+    }
+  }
+  for (const auto& kv : sparse_set_map_) {
+    if (kv.val().size() != 0) {
+      add_component(kv.val().component_id());
+    }
+  }
+
+  writer.WriteBytes(kMagic, sizeof(kMagic));
+  writer.Write(kVersion);
+  writer.Write(static_cast<uint64_t>(baseline.sequence_));
+  writer.Write(static_cast<uint8_t>(is_reset));
+  writer.Write(static_cast<uint32_t>(baseline.component_array_.size() -
+                                     old_component_cnt));
+  for (size_t i = old_component_cnt; i < baseline.component_array_.size();
+       ++i) {
+    WriteComponent(writer, baseline.component_array_[i]);
+  }
+
+  // Ids are freed and taken at the tail, so the list mostly keeps a prefix.
+  auto& free_array = baseline.free_array_;
+  size_t kept_cnt = 0;
+  while (kept_cnt < free_array.size() &&
+         kept_cnt < available_entity_id_.size() &&
+         free_array[kept_cnt] == available_entity_id_[kept_cnt]) {
+    ++kept_cnt;
+  }
+  writer.Write(static_cast<uint64_t>(entity_route_array_.size()));
+  writer.Write(static_cast<uint64_t>(kept_cnt));
+  writer.Write(static_cast<uint64_t>(available_entity_id_.size() - kept_cnt));
+  writer.WriteBytes(available_entity_id_.data() + kept_cnt,
+                    (available_entity_id_.size() - kept_cnt) *
+                        sizeof(EntityId));
+  baseline.slot_cnt_ = entity_route_array_.size();
+  free_array.set_size(kept_cnt);
+  for (size_t i = kept_cnt; i < available_entity_id_.size(); ++i) {
+    free_array.Push(available_entity_id_[i]);
+  }
+
+  const auto archetype_cnt_offset = writer.size();
+  writer.Write<uint32_t>(0);
+  uint32_t archetype_cnt = 0;
+  const auto sent_cnt = baseline.archetype_array_.size();
+  for (size_t i = 0; i < sent_cnt; ++i) {
+    if (SaveArchetypeDelta(baseline, i, false, dirty_tick, writer)) {
+      ++archetype_cnt;
+    }
+  }
+  for (size_t i = 0; i < archetype_array_.size(); ++i) {
+    const auto& archetype = archetype_array_[i];
+    if (baseline.is_sent_array_[i] || archetype.size() == 0) {
+      continue;
+    }
+    baseline.is_sent_array_[i] = true;
+    baseline.archetype_array_.Emplace();
+    auto& state = baseline.archetype_array_.Tail();
+    const auto& descriptor = archetype.descriptor();
+    state.archetype_id = descriptor.id();
+    state.type_set = descriptor.type_set().Clone();
+    for (const auto& kv : descriptor.offset_map()) {
+      state.column_array.Push(kv.key());
+      state.bytes_array.Emplace();
+    }
+    SaveArchetypeDelta(baseline, baseline.archetype_array_.size() - 1, true,
+                       dirty_tick, writer);
+    ++archetype_cnt;
+  }
+  writer.WriteAt(archetype_cnt_offset, archetype_cnt);
+
+  // Sparse sets are compared whole with the bytes last sent.
+  const auto sparse_set_cnt_offset = writer.size();
+  writer.Write<uint32_t>(0);
+  uint32_t sparse_set_cnt = 0;
+  for (const auto& kv : sparse_set_map_) {
+    const auto& sparse_set = kv.val();
+    auto it = baseline.sparse_set_map_.TryFind(kv.key());
+    if (!it && sparse_set.size() == 0) {
+      continue;
+    }
+    ByteWriter set_writer;
+    WriteSparseSet(set_writer, sparse_set);
+    if (it && it->val() == set_writer.bytes()) {
+      continue;
+    }
+    writer.Write(baseline.component_index_map_[kv.key()]);
+    writer.WriteBytes(set_writer.bytes().data(), set_writer.size());
+    ++sparse_set_cnt;
+    if (it) {
+      it->val() = set_writer.TakeBytes();
+    } else {
+      baseline.sparse_set_map_.Insert(kv.key(), set_writer.TakeBytes());
+    }
+  }
+  // Sets the manager no longer has are sent empty.
+  for (auto& kv : baseline.sparse_set_map_) {
+    if (sparse_set_map_.TryFind(kv.key())) {
+      continue;
+    }
+    ByteWriter set_writer;
+    set_writer.Write<uint64_t>(0);
+    if (kv.val() == set_writer.bytes()) {
+      continue;
+    }
+    writer.Write(baseline.component_index_map_[kv.key()]);
+    writer.WriteBytes(set_writer.bytes().data(), set_writer.size());
+    ++sparse_set_cnt;
+    kv.val() = set_writer.TakeBytes();
+  }
+  writer.WriteAt(sparse_set_cnt_offset, sparse_set_cnt);
+
+  ++baseline.sequence_;
+  baseline.tick_ = *change_tick_;
+  return true;
+}
+
+bool EntityManager::SaveArchetypeDelta(SnapshotBaseline& baseline,
+                                       const size_t index, const bool is_new,
+                                       const Tick dirty_tick,
+                                       ByteWriter& writer) const {
+  auto& state = baseline.archetype_array_[index];
+  const auto& archetype = archetype_array_[state.archetype_id.index()];
+  const auto& descriptor = archetype.descriptor();
+  const auto& chunk_array = archetype.chunk_array();
+  const auto old_row_cnt = state.entity_array.size();
+  auto component_index = [&](const ComponentId& component_id) {
+    return baseline.component_index_map_[component_id.type_id()];
+  };
+
+  // Chunks hold the rows from their index times the capacity of the first,
+  // see `Archetype::RowAt`. Untouched chunks are skipped without a look at
+  // their rows.
+  const size_t row_capacity =
+      chunk_array.empty() ? 0 : chunk_array[0].capacity();
+  // `IsColumnChanged` is strict, but writes at `dirty_tick` may have come
+  // after the baseline was taken.
+  auto is_dirty = [&](const ArchetypeDataBuffer& chunk,
+                      const ComponentId& component_id) {
+    return dirty_tick == kInitTick ||
+           chunk.IsColumnChanged(component_id, dirty_tick - 1);
+  };
+  auto is_touched = [&](const ArchetypeDataBuffer& chunk,
+                        const size_t begin) {
+    if (begin + chunk.size() > old_row_cnt) {
+      return true;
+    }
+    auto is_chunk_dirty = [&](const ComponentId& component_id) {
+      return is_dirty(chunk, component_id);
+    };
+    return std::ranges::any_of(state.column_array, is_chunk_dirty) ||
+           std::ranges::any_of(descriptor.tag_array(), is_chunk_dirty);
+  };
+  Array<size_t> chunk_index_array;
+  for (size_t i = 0; i < chunk_array.size(); ++i) {
+    if (chunk_array[i].size() != 0 &&
+        is_touched(chunk_array[i], i * row_capacity)) {
+      chunk_index_array.Push(i);
+    }
+  }
+  if (!is_new && archetype.size() == old_row_cnt &&
+      chunk_index_array.empty()) {
+    return false;
+  }
+
+  writer.Write(static_cast<uint32_t>(index));
+  writer.Write(static_cast<uint8_t>(is_new));
+  if (is_new) {
+    writer.Write(static_cast<uint32_t>(state.column_array.size()));
+    for (const auto& component_id : state.column_array) {
+      writer.Write(component_index(component_id));
+    }
+    writer.Write(static_cast<uint32_t>(descriptor.tag_array().size()));
+    for (const auto& tag : descriptor.tag_array()) {
+      writer.Write(component_index(tag));
+    }
+  }
+  writer.Write(static_cast<uint64_t>(archetype.size()));
+  writer.Write(static_cast<uint32_t>(chunk_index_array.size()));
+  for (const auto chunk_index : chunk_index_array) {
+    writer.Write(static_cast<uint64_t>(chunk_index * row_capacity));
+    writer.Write(static_cast<uint64_t>(chunk_array[chunk_index].size()));
+  }
+  const auto length_offset = writer.size();
+  writer.Write<uint64_t>(0);
+
+  state.entity_array.set_size(archetype.size());
+  for (size_t i = 0; i < state.column_array.size(); ++i) {
+    const auto& component_id = state.column_array[i];
+    if (component_id.is_bytewise_serializable()) {
+      state.bytes_array[i].set_size(archetype.size() *
+                                    component_id.type_id().type_size());
+    }
+  }
+
+  const auto row_size = descriptor.size();
+  Array<uint8_t> column_bytes;
+  for (const auto chunk_index : chunk_index_array) {
+    const auto& chunk = chunk_array[chunk_index];
+    const auto begin = chunk_index * row_capacity;
+    const size_t cnt = chunk.size();
+    const auto* id_ptr =
+        reinterpret_cast<const uint8_t*>(chunk.entity_id_data());
+    auto* base_id_ptr =
+        reinterpret_cast<uint8_t*>(state.entity_array.data() + begin);
+    const auto id_size = cnt * sizeof(EntityId);
+    const bool is_moved = std::memcmp(base_id_ptr, id_ptr, id_size) != 0;
+    writer.Write(static_cast<uint8_t>(is_moved));
+    if (is_moved) {
+      ByteDelta::EncodeRuns(base_id_ptr, id_ptr, id_size, writer);
+      std::memcpy(base_id_ptr, id_ptr, id_size);
+    }
+
+    const auto* row_ptr =
+        reinterpret_cast<const uint8_t*>(chunk.buffer().ptr());
+    for (size_t i = 0; i < state.column_array.size(); ++i) {
+      const auto& component_id = state.column_array[i];
+      if (!is_moved && !is_dirty(chunk, component_id)) {
+        writer.Write<uint8_t>(0);
+        continue;
+      }
+      if (!component_id.is_bytewise_serializable()) {
+        writer.Write<uint8_t>(1);
+        for (uint16_t row = 0; row < chunk.size(); ++row) {
+          WriteHooked(writer, component_id, chunk[row].TryGet(component_id));
+        }
+        continue;
+      }
+      const auto type_size = component_id.type_id().type_size();
+      const auto offset = descriptor.offset_map()[component_id];
+      column_bytes.ResizeUninitialized(cnt * type_size);
+      for (size_t row = 0; row < cnt; ++row) {
+        std::memcpy(column_bytes.data() + row * type_size,
+                    row_ptr + row * row_size + offset, type_size);
+      }
+      auto* base_ptr = state.bytes_array[i].data() + begin * type_size;
+      if (std::memcmp(base_ptr, column_bytes.data(), column_bytes.size()) ==
+          0) {
+        writer.Write<uint8_t>(0);
+        continue;
+      }
+      writer.Write<uint8_t>(1);
+      ByteDelta::EncodeRuns(base_ptr, column_bytes.data(), column_bytes.size(),
+                            writer);
+      std::memcpy(base_ptr, column_bytes.data(), column_bytes.size());
+    }
+  }
+  writer.WriteAt(length_offset, static_cast<uint64_t>(writer.size() -
+                                                      length_offset -
+                                                      sizeof(uint64_t)));
+  return true;
+}
+
+bool EntityManager::ApplyDelta(SnapshotBaseline& baseline, ByteReader& reader,
+                               const size_t max_entity_cnt,
+                               const ComponentRegistry& registry) {
+  MIRAGE_PROFILE_ZONE("EntityManager::ApplyDelta");
+  char magic[sizeof(kMagic)];
+  reader.ReadBytes(magic, sizeof(magic));
+  if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      reader.Read<uint32_t>() != kVersion ||
+      reader.Read<uint64_t>() != baseline.sequence_) {
+    return false;
+  }
+  const bool is_reset = reader.Read<uint8_t>() != 0;
+  if (!reader.is_ok()) {
+    return false;
+  }
+  if (!is_reset) {
+    return ApplyDeltaRecords(baseline, reader, max_entity_cnt, registry);
+  }
+
+  // A reset replaces every entity, so it is built aside and only swapped in
+  // once it applied, like `World::LoadSnapshot` does.
+  SnapshotBaseline reset_baseline;
+  reset_baseline.sequence_ = baseline.sequence_;
+  EntityManager entity_manager;
+  entity_manager.set_change_tick(*change_tick_);
+  if (!entity_manager.ApplyDeltaRecords(reset_baseline, reader,
+                                        max_entity_cnt, registry)) {
+    return false;
+  }
+  baseline = std::move(reset_baseline);
+  *this = std::move(entity_manager);
+  return true;
+}
+
+bool EntityManager::ApplyDeltaRecords(SnapshotBaseline& baseline,
+                                      ByteReader& reader,
+                                      const size_t max_entity_cnt,
+                                      const ComponentRegistry& registry) {
+  if (!ReadComponents(reader, reader.Read<uint32_t>(), registry,
+                      baseline.component_array_)) {
+    return false;
+  }
+
+  // Slots are never given back, and every one holds a live entity or a free
+  // id once the delta is applied.
+  const auto old_slot_cnt = entity_route_array_.size();
+  const auto slot_cnt = reader.Read<uint64_t>();
+  const auto kept_cnt = reader.Read<uint64_t>();
+  const auto new_free_cnt = reader.Read<uint64_t>();
+  if (!reader.is_ok() || slot_cnt > max_entity_cnt ||
+      slot_cnt < old_slot_cnt || kept_cnt > available_entity_id_.size() ||
+      new_free_cnt > slot_cnt - kept_cnt ||
+      new_free_cnt > reader.remaining() / sizeof(EntityId)) {
+    return false;
+  }
+  const auto* free_ptr = reader.Skip(new_free_cnt * sizeof(EntityId));
+
+  Array<ArchetypeRecord> record_array;
+  size_t row_total = size_;
+  const auto archetype_cnt = reader.Read<uint32_t>();
+  for (uint32_t i = 0; reader.is_ok() && i < archetype_cnt; ++i) {
+    const auto index = reader.Read<uint32_t>();
+    const bool is_new = reader.Read<uint8_t>() != 0;
+    const auto state_cnt = baseline.archetype_array_.size();
+    if (!reader.is_ok() || index > state_cnt ||
+        is_new != (index == state_cnt) ||
+        (!record_array.empty() && index <= record_array.Tail().index)) {
+      return false;
+    }
+    if (is_new && !LoadArchetypeLayout(baseline, reader)) {
+      return false;
+    }
+    const auto& state = baseline.archetype_array_[index];
+    const auto& archetype = archetype_array_[state.archetype_id.index()];
+    const auto old_row_cnt = archetype.size();
+
+    ArchetypeRecord record;
+    record.index = index;
+    record.row_cnt = reader.Read<uint64_t>();
+    const auto range_cnt = reader.Read<uint32_t>();
+    if (!reader.is_ok() || record.row_cnt > slot_cnt ||
+        range_cnt > reader.remaining() / (2 * sizeof(uint64_t))) {
+      return false;
+    }
+    // Sorted, disjoint and covering every appended row.
+    size_t end = 0;
+    for (uint32_t j = 0; j < range_cnt; ++j) {
+      const auto begin = reader.Read<uint64_t>();
+      const auto cnt = reader.Read<uint64_t>();
+      if (begin < end || cnt == 0 || begin > record.row_cnt ||
+          cnt > record.row_cnt - begin ||
+          std::max(end, old_row_cnt) < begin) {
+        return false;
+      }
+      end = begin + cnt;
+      record.range_array.Push({.begin = begin, .cnt = cnt});
+    }
+    if (std::max(end, old_row_cnt) < record.row_cnt) {
+      return false;
+    }
+    row_total = row_total - old_row_cnt + record.row_cnt;
+    if (row_total > slot_cnt) {
+      return false;
+    }
+
+    const auto length = reader.Read<uint64_t>();
+    const auto* row_ptr = reader.Skip(length);
+    record.row_reader = ByteReader(row_ptr, length);
+    if (!reader.is_ok() ||
+        !CheckRows(record.row_reader, archetype, state.column_array,
+                   record.range_array, record.id_array)) {
+      return false;
+    }
+    record_array.Emplace(std::move(record));
+  }
+  if (!reader.is_ok() || row_total + kept_cnt + new_free_cnt != slot_cnt) {
+    return false;
+  }
+
+  // Slots the delta may hand out again: those of rewritten and dropped rows
+  // and the free ids past the kept ones.
+  HashSet<size_t> released_set;
+  for (const auto& record : record_array) {
+    const auto& archetype =
+        archetype_array_[baseline.archetype_array_[record.index]
+                             .archetype_id.index()];
+    const auto old_row_cnt = archetype.size();
+    auto release = [&](const size_t begin, const size_t end) {
+      for (size_t row = begin; row < end; ++row) {
+        released_set.Insert(
+            archetype[archetype.IndexAt(row)].entity_id().index());
+      }
+    };
+    for (const auto& range : record.range_array) {
+      release(range.begin, std::min(range.begin + range.cnt, old_row_cnt));
+    }
+    release(std::min(record.row_cnt, old_row_cnt), old_row_cnt);
+  }
+  for (size_t i = kept_cnt; i < available_entity_id_.size(); ++i) {
+    released_set.Insert(available_entity_id_[i].index());
+  }
+  // Every rewritten row and new free id takes one of them, or a new slot.
+  // Free slots map to an invalid id, as no entity is alive in them.
+  HashMap<size_t, EntityId> taken_map;
+  auto take = [&](const size_t index, const EntityId& entity_id) {
+    return index < slot_cnt &&
+           (index >= old_slot_cnt || released_set.TryFind(index)) &&
+           !taken_map.Insert(index, entity_id).is_valid();
+  };
+  for (const auto& record : record_array) {
+    for (const auto& entity_id : record.id_array) {
+      if (!entity_id.is_valid() || !take(entity_id.index(), entity_id)) {
+        return false;
+      }
+    }
+  }
+  for (uint64_t i = 0; i < new_free_cnt; ++i) {
+    if (!take(ReadEntityId(free_ptr + i * sizeof(EntityId)).index(),
+              EntityId())) {
+      return false;
+    }
+  }
+
+  // Sparse sets are replaced whole, and may only hold entities alive once the
+  // rows are applied.
+  auto is_alive = [&](const EntityId& entity_id) {
+    if (const auto it = taken_map.TryFind(entity_id.index())) {
+      return it->val() == entity_id;
+    }
+    return Contains(entity_id) && !released_set.TryFind(entity_id.index());
+  };
+  auto sparse_reader = reader;
+  const auto sparse_set_cnt = sparse_reader.Read<uint32_t>();
+  for (uint32_t i = 0; sparse_reader.is_ok() && i < sparse_set_cnt; ++i) {
+    if (!CheckSparseSet(sparse_reader, baseline.component_array_, is_alive)) {
+      return false;
+    }
+  }
+  if (!sparse_reader.is_ok() || sparse_reader.remaining() != 0) {
+    return false;
+  }
+
+  // The whole delta checked out, so from here on nothing fails and no row
+  // is left half applied.
+  entity_route_array_.set_size(slot_cnt);
+  available_entity_id_.set_size(kept_cnt);
+  for (uint64_t i = 0; i < new_free_cnt; ++i) {
+    available_entity_id_.Push(ReadEntityId(free_ptr + i * sizeof(EntityId)));
+  }
+  for (const auto& record : record_array) {
+    const auto& state = baseline.archetype_array_[record.index];
+    auto& archetype = archetype_array_[state.archetype_id.index()];
+    const auto old_row_cnt = archetype.size();
+    for (const auto& range : record.range_array) {
+      UnregisterRows(archetype, range.begin,
+                     std::min(range.begin + range.cnt, old_row_cnt));
+    }
+    UnregisterRows(archetype, std::min(record.row_cnt, old_row_cnt),
+                   old_row_cnt);
+  }
+
+  Array<EntityId> id_array;
+  Array<Archetype::Index> index_array;
+  Array<uint8_t> column_bytes;
+  for (auto& record : record_array) {
+    const auto& state = baseline.archetype_array_[record.index];
+    auto& archetype = archetype_array_[state.archetype_id.index()];
+    const auto old_row_cnt = archetype.size();
+    while (archetype.size() > record.row_cnt) {
+      archetype.Remove(archetype.IndexAt(archetype.size() - 1));
+    }
+    // Appended rows are zeroed and without an entity, like the baseline has
+    // them, until the runs fill them in.
+    if (archetype.size() < record.row_cnt) {
+      const auto cnt = record.row_cnt - archetype.size();
+      id_array.Clear();
+      id_array.set_size(cnt);
+      index_array.ResizeUninitialized(cnt);
+      size_t placed_cnt = 0;
+      while (placed_cnt < cnt) {
+        const auto rows = archetype.PushUninitialized(
+            id_array.data() + placed_cnt, cnt - placed_cnt,
+            index_array.data() + placed_cnt);
+        std::memset(rows.ptr, 0, rows.cnt * archetype.descriptor().size());
+        placed_cnt += rows.cnt;
+      }
+    }
+    size_ = size_ - old_row_cnt + record.row_cnt;
+
+    auto& row_reader = record.row_reader;
+    const auto* decoded_id_ptr = record.id_array.data();
+    for (const auto& range : record.range_array) {
+      // The ids were decoded while checking the rows.
+      if (row_reader.Read<uint8_t>() != 0) {
+        ByteDelta::ApplyRuns(row_reader, nullptr,
+                             range.cnt * sizeof(EntityId));
+        for (size_t i = 0; i < range.cnt; ++i) {
+          archetype.RowAt(range.begin + i).entity_id() = decoded_id_ptr[i];
+        }
+      }
+      decoded_id_ptr += range.cnt;
+      for (const auto& component_id : state.column_array) {
+        if (row_reader.Read<uint8_t>() == 0) {
+          continue;
+        }
+        if (!component_id.is_bytewise_serializable()) {
+          for (size_t i = 0; i < range.cnt; ++i) {
+            const auto row = range.begin + i;
+            auto* component = archetype.RowAt(row).TryGetMut(component_id);
+            if (row < old_row_cnt) {
+              component_id.destruct(component);
+            }
+            uint64_t length = 0;
+            const auto* ptr = SkipHooked(row_reader, length);
+            ByteReader component_reader(ptr, length);
+            [[maybe_unused]] const bool is_deserialized =
+                component_id.deserialize(component_reader, component);
+            MIRAGE_DCHECK(is_deserialized);
+          }
+          continue;
+        }
+        const auto type_size = component_id.type_id().type_size();
+        column_bytes.ResizeUninitialized(range.cnt * type_size);
+        for (size_t i = 0; i < range.cnt; ++i) {
+          std::memcpy(column_bytes.data() + i * type_size,
+                      archetype.RowAt(range.begin + i).TryGet(component_id),
+                      type_size);
+        }
+        ByteDelta::ApplyRuns(row_reader, column_bytes.data(),
+                             column_bytes.size());
+        for (size_t i = 0; i < range.cnt; ++i) {
+          std::memcpy(archetype.RowAt(range.begin + i).TryGetMut(component_id),
+                      column_bytes.data() + i * type_size, type_size);
+        }
+      }
+    }
+  }
+
+  for (const auto& record : record_array) {
+    const auto& archetype_id =
+        baseline.archetype_array_[record.index].archetype_id;
+    for (const auto& range : record.range_array) {
+      RegisterRows(archetype_id, range.begin, range.begin + range.cnt);
+    }
+  }
+
+  reader.Read<uint32_t>();
+  for (uint32_t i = 0; i < sparse_set_cnt; ++i) {
+    auto peek_reader = reader;
+    const auto* component_id =
+        ReadComponent(peek_reader, baseline.component_array_);
+    if (const auto it = sparse_set_map_.TryFind(component_id->type_id())) {
+      it->val().Clear();
+    }
+    [[maybe_unused]] const bool is_loaded =
+        LoadSparseSetSnapshot(reader, baseline.component_array_);
+    MIRAGE_DCHECK(is_loaded);
+  }
+  MIRAGE_DCHECK(reader.is_ok() && reader.remaining() == 0);
+  ++baseline.sequence_;
+  return true;
+}
+
+bool EntityManager::LoadArchetypeLayout(SnapshotBaseline& baseline,
+                                        ByteReader& reader) {
+  const auto& component_array = baseline.component_array_;
+  SnapshotBaseline::ArchetypeState state;
+  TypeSet type_set;
+  ComponentIdArray component_id_array;
+  const auto column_cnt = reader.Read<uint32_t>();
+  for (uint32_t i = 0; i < column_cnt; ++i) {
+    const auto* component_id = ReadComponent(reader, component_array);
+    if (!component_id) {
+      return false;
+    }
+    state.column_array.Push(*component_id);
+    type_set.AddTypeId(component_id->type_id());
+    component_id_array.Push(*component_id);
+  }
+  const auto tag_cnt = reader.Read<uint32_t>();
+  for (uint32_t i = 0; i < tag_cnt; ++i) {
+    const auto* component_id = ReadComponent(reader, component_array);
+    if (!component_id) {
+      return false;
+    }
+    type_set.AddTypeId(component_id->type_id());
+    component_id_array.Push(*component_id);
+  }
+
+  // Archetypes of the receiver only come from deltas, so a new one in the
+  // delta is new here too.
+  const auto archetype_cnt = archetype_array_.size();
+  state.archetype_id = FindOrCreateArchetype(std::move(type_set),
+                                             std::move(component_id_array));
+  const auto& offset_map =
+      archetype_array_[state.archetype_id.index()].descriptor().offset_map();
+  if (archetype_array_.size() == archetype_cnt ||
+      offset_map.size() != column_cnt) {
+    return false;
+  }
+  for (const auto& component_id : state.column_array) {
+    if (!offset_map.TryFind(component_id)) {
+      return false;
+    }
+  }
+  baseline.archetype_array_.Emplace(std::move(state));
+  return true;
+}
+
+void EntityManager::UnregisterRows(Archetype& archetype, const size_t begin,
+                                   const size_t end) {
+  const auto& relation_array = archetype.descriptor().relation_array();
+  for (size_t row = begin; row < end; ++row) {
+    const auto view = archetype.RowAt(row);
+    const auto& entity_id = view.entity_id();
+    for (const auto& relation : relation_array) {
+      const auto* target = relation.relation_target(view.TryGet(relation));
+      relation_index_.Remove(relation, entity_id, *target);
+    }
+    entity_route_array_[entity_id.index()].archetype_id.Reset();
+  }
+}
+
+void EntityManager::RegisterRows(const ArchetypeId& archetype_id,
+                                 const size_t begin, const size_t end) {
+  auto& archetype = archetype_array_[archetype_id.index()];
+  const auto& relation_array = archetype.descriptor().relation_array();
+  for (size_t row = begin; row < end; ++row) {
+    const auto view = archetype.RowAt(row);
+    const auto& entity_id = view.entity_id();
+    // Ids were checked to be valid and unique before any row was touched.
+    auto& route = entity_route_array_[entity_id.index()];
+    MIRAGE_DCHECK(!route.archetype_id.is_valid());
+    route.archetype_id = archetype_id;
+    route.entity_index = archetype.IndexAt(row);
+    for (const auto& relation : relation_array) {
+      const auto* target = relation.relation_target(view.TryGet(relation));
+      relation_index_.Add(relation, entity_id, *target);
+    }
+  }
+}
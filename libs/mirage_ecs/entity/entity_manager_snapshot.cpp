@@ -0,0 +1,381 @@
+#include <cstring>
+#include <utility>
+
+#include "mirage_base/define/check.hpp"
+#include "mirage_base/profile/profiler.hpp"
+#include "mirage_ecs/entity/entity_manager.hpp"
+#include "mirage_ecs/entity/snapshot_io.hpp"
+
+using namespace mirage::base;
+using namespace mirage::ecs;
+using namespace mirage::ecs::snapshot_io;
+
+// Snapshot layout, in native byte order:
+//
+//   "MSNP", u32 version
+//   u32 component count, per component: name, u64 size, u8 bytewise
+//   u64 entity slot count, u64 free id count, free ids
+//   u32 archetype count, per archetype:
+//     u32 column count, per column: u32 component, u64 offset
+//     u32 tag count, per tag: u32 component
+//     u64 row size, u64 row count
+//     entity ids of the rows, then the rows as they lie in the chunks
+//     per row, per hooked column: u64 length, serialized component
+//   u32 sparse set count, per set:
+//     u32 component, u64 entity count, entity ids
+//     per entity: the component bytes, or u64 length and serialized component
+//
+// Components are referred to by their index in the component table. Rows of
+// a hooked column carry unspecified bytes and are rebuilt by the hooks.
+
+namespace {
+
+constexpr char kMagic[4] = {'M', 'S', 'N', 'P'};
+constexpr uint32_t kVersion = 1;
+
+}  // namespace
+
+bool EntityManager::SaveSnapshot(ByteWriter& writer) const {
+  MIRAGE_PROFILE_ZONE("EntityManager::SaveSnapshot");
+  Array<ComponentId> component_array;
+  HashMap<TypeId, uint32_t> component_index_map;
+  auto add_component = [&](const ComponentId& component_id) {
+    const auto type_id = component_id.type_id();
+    if (component_index_map.TryFind(type_id) == component_index_map.end()) {
+      component_index_map.Insert(
+          type_id, static_cast<uint32_t>(component_array.size()));
+      component_array.Push(component_id);
+    }
+  };
+  auto component_index = [&](const ComponentId& component_id) {
+    return component_index_map.TryFind(component_id.type_id())->val();
+  };
+
+  uint32_t archetype_cnt = 0;
+  for (const auto& archetype : archetype_array_) {
+    if (archetype.size() == 0) {
+      continue;
+    }
+    ++archetype_cnt;
+    for (const auto& kv : archetype.descriptor().offset_map()) {
+      add_component(kv.key());
+    }
+    for (const auto& tag : archetype.descriptor().tag_array()) {
+      add_component(tag);
+    }
+  }
+  uint32_t sparse_set_cnt = 0;
+  for (const auto& kv : sparse_set_map_) {
+    if (kv.val().size() != 0) {
+      ++sparse_set_cnt;
+      add_component(kv.val().component_id());
+    }
+  }
+  for (const auto& component_id : component_array) {
+    if (!component_id.is_tag() && !component_id.is_serializable()) {
+      return false;
+    }
+  }
+
+  writer.WriteBytes(kMagic, sizeof(kMagic));
+  writer.Write(kVersion);
+  writer.Write(static_cast<uint32_t>(component_array.size()));
+  for (const auto& component_id : component_array) {
+    WriteComponent(writer, component_id);
+  }
+
+  writer.Write(static_cast<uint64_t>(entity_route_array_.size()));
+  writer.Write(static_cast<uint64_t>(available_entity_id_.size()));
+  writer.WriteBytes(available_entity_id_.data(),
+                    available_entity_id_.size() * sizeof(EntityId));
+
+  writer.Write(archetype_cnt);
+  Array<ComponentId> hooked_array;
+  for (const auto& archetype : archetype_array_) {
+    if (archetype.size() == 0) {
+      continue;
+    }
+    const auto& descriptor = archetype.descriptor();
+    hooked_array.Clear();
+    writer.Write(static_cast<uint32_t>(descriptor.offset_map().size()));
+    for (const auto& kv : descriptor.offset_map()) {
+      writer.Write(component_index(kv.key()));
+      writer.Write(static_cast<uint64_t>(kv.val()));
+      if (!kv.key().is_bytewise_serializable()) {
+        hooked_array.Push(kv.key());
+      }
+    }
+    writer.Write(static_cast<uint32_t>(descriptor.tag_array().size()));
+    for (const auto& tag : descriptor.tag_array()) {
+      writer.Write(component_index(tag));
+    }
+
+    writer.Write(static_cast<uint64_t>(descriptor.size()));
+    writer.Write(static_cast<uint64_t>(archetype.size()));
+    // Every chunk is written with two bulk copies, whatever its components.
+    for (const auto& chunk : archetype.chunk_array()) {
+      writer.WriteBytes(chunk.entity_id_data(),
+                        chunk.size() * sizeof(EntityId));
+    }
+    for (const auto& chunk : archetype.chunk_array()) {
+      writer.WriteBytes(chunk.buffer().ptr(), chunk.size() * descriptor.size());
+    }
+    if (hooked_array.empty()) {
+      continue;
+    }
+    for (const auto& chunk : archetype.chunk_array()) {
+      for (uint16_t i = 0; i < chunk.size(); ++i) {
+        const auto view = chunk[i];
+        for (const auto& component_id : hooked_array) {
+          WriteHooked(writer, component_id, view.TryGet(component_id));
+        }
+      }
+    }
+  }
+
+  writer.Write(sparse_set_cnt);
+  for (const auto& kv : sparse_set_map_) {
+    const auto& sparse_set = kv.val();
+    if (sparse_set.size() == 0) {
+      continue;
+    }
+    writer.Write(component_index(sparse_set.component_id()));
+    WriteSparseSet(writer, sparse_set);
+  }
+  return true;
+}
+
+bool EntityManager::LoadSnapshot(ByteReader& reader,
+                                 const ComponentRegistry& registry) {
+  MIRAGE_PROFILE_ZONE("EntityManager::LoadSnapshot");
+  MIRAGE_DCHECK(entity_route_array_.empty());
+  char magic[sizeof(kMagic)];
+  reader.ReadBytes(magic, sizeof(magic));
+  if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      reader.Read<uint32_t>() != kVersion) {
+    return false;
+  }
+
+  Array<ComponentId> component_array;
+  if (!ReadComponents(reader, reader.Read<uint32_t>(), registry,
+                      component_array)) {
+    return false;
+  }
+
+  // Every slot holds a live entity or a free id, both written in full.
+  const auto slot_cnt = reader.Read<uint64_t>();
+  const auto free_cnt = reader.Read<uint64_t>();
+  if (!reader.is_ok() || free_cnt > slot_cnt ||
+      slot_cnt > reader.remaining() / sizeof(EntityId)) {
+    return false;
+  }
+  const auto* free_ptr = reader.Skip(free_cnt * sizeof(EntityId));
+  entity_route_array_.Reserve(slot_cnt);
+  for (uint64_t i = 0; i < slot_cnt; ++i) {
+    entity_route_array_.Emplace();
+  }
+  available_entity_id_.Reserve(free_cnt);
+  for (uint64_t i = 0; i < free_cnt; ++i) {
+    const auto entity_id = ReadEntityId(free_ptr + i * sizeof(EntityId));
+    if (entity_id.index() >= slot_cnt) {
+      return false;
+    }
+    available_entity_id_.Push(entity_id);
+  }
+
+  const auto archetype_cnt = reader.Read<uint32_t>();
+  for (uint32_t i = 0; reader.is_ok() && i < archetype_cnt; ++i) {
+    if (!LoadArchetypeSnapshot(reader, component_array)) {
+      return false;
+    }
+  }
+  const auto sparse_set_cnt = reader.Read<uint32_t>();
+  for (uint32_t i = 0; reader.is_ok() && i < sparse_set_cnt; ++i) {
+    if (!LoadSparseSetSnapshot(reader, component_array)) {
+      return false;
+    }
+  }
+  return reader.is_ok() && size_ + free_cnt == slot_cnt;
+}
+
+bool EntityManager::LoadArchetypeSnapshot(
+    ByteReader& reader, const Array<ComponentId>& component_array) {
+  struct Column {
+    ComponentId component_id;
+    size_t src_offset;
+    size_t dst_offset;
+  };
+  Array<Column> column_array;
+  Array<size_t> hooked_array;
+  TypeSet type_set;
+  ComponentIdArray component_id_array;
+
+  const auto column_cnt = reader.Read<uint32_t>();
+  for (uint32_t i = 0; i < column_cnt; ++i) {
+    const auto* component_id = ReadComponent(reader, component_array);
+    const auto offset = reader.Read<uint64_t>();
+    if (!component_id) {
+      return false;
+    }
+    if (!component_id->is_bytewise_serializable()) {
+      hooked_array.Push(column_array.size());
+    }
+    column_array.Push({.component_id = *component_id,
+                       .src_offset = offset,
+                       .dst_offset = 0});
+    type_set.AddTypeId(component_id->type_id());
+    component_id_array.Push(*component_id);
+  }
+  const auto tag_cnt = reader.Read<uint32_t>();
+  for (uint32_t i = 0; i < tag_cnt; ++i) {
+    const auto* component_id = ReadComponent(reader, component_array);
+    if (!component_id) {
+      return false;
+    }
+    type_set.AddTypeId(component_id->type_id());
+    component_id_array.Push(*component_id);
+  }
+
+  const auto row_size = reader.Read<uint64_t>();
+  const auto row_cnt = reader.Read<uint64_t>();
+  if (!reader.is_ok() || row_cnt == 0 ||
+      row_cnt > reader.remaining() / sizeof(EntityId)) {
+    return false;
+  }
+  const auto* id_ptr = reader.Skip(row_cnt * sizeof(EntityId));
+  if (row_size != 0 && row_cnt > reader.remaining() / row_size) {
+    return false;
+  }
+  const auto* row_ptr = reader.Skip(row_cnt * row_size);
+  for (const auto& column : column_array) {
+    if (column.src_offset + column.component_id.type_id().type_size() >
+        row_size) {
+      return false;
+    }
+  }
+
+  // Serialized components are checked before any row is pushed, so a failed
+  // load never leaves a row with an unconstructed component behind.
+  if (!hooked_array.empty()) {
+    auto scan = reader;
+    uint64_t length = 0;
+    for (uint64_t i = 0; i < row_cnt * hooked_array.size(); ++i) {
+      if (!SkipHooked(scan, length)) {
+        return false;
+      }
+    }
+  }
+
+  const auto archetype_id = FindOrCreateArchetype(
+      std::move(type_set), std::move(component_id_array));
+  auto& archetype = archetype_array_[archetype_id.index()];
+  const auto& descriptor = archetype.descriptor();
+  if (archetype.size() != 0 ||
+      descriptor.offset_map().size() != column_array.size()) {
+    return false;
+  }
+  bool is_same_layout = row_size == descriptor.size();
+  for (auto& column : column_array) {
+    const auto it = descriptor.offset_map().TryFind(column.component_id);
+    if (!it) {
+      return false;
+    }
+    column.dst_offset = it->val();
+    is_same_layout = is_same_layout && column.src_offset == column.dst_offset;
+  }
+
+  Array<EntityId> id_array;
+  id_array.Reserve(row_cnt);
+  for (uint64_t i = 0; i < row_cnt; ++i) {
+    auto entity_id = ReadEntityId(id_ptr + i * sizeof(EntityId));
+    if (entity_id.index() >= entity_route_array_.size()) {
+      return false;
+    }
+    auto& route = entity_route_array_[entity_id.index()];
+    if (route.archetype_id.is_valid()) {
+      return false;
+    }
+    route.archetype_id = archetype_id;
+    id_array.Push(std::move(entity_id));
+  }
+
+  Array<Archetype::Index> index_array;
+  index_array.ResizeUninitialized(row_cnt);
+  const auto dst_row_size = descriptor.size();
+  size_t placed_cnt = 0;
+  while (placed_cnt < row_cnt) {
+    const auto rows =
+        archetype.PushUninitialized(id_array.data() + placed_cnt,
+                                    row_cnt - placed_cnt,
+                                    index_array.data() + placed_cnt);
+    const auto* src_ptr = row_ptr + placed_cnt * row_size;
+    if (is_same_layout) {
+      std::memcpy(rows.ptr, src_ptr, rows.cnt * row_size);
+    } else {
+      for (const auto& column : column_array) {
+        if (!column.component_id.is_bytewise_serializable()) {
+          continue;
+        }
+        const auto type_size = column.component_id.type_id().type_size();
+        for (size_t i = 0; i < rows.cnt; ++i) {
+          std::memcpy(rows.ptr + i * dst_row_size + column.dst_offset,
+                      src_ptr + i * row_size + column.src_offset, type_size);
+        }
+      }
+    }
+    for (size_t i = 0; i < rows.cnt && !hooked_array.empty(); ++i) {
+      for (const auto column_index : hooked_array) {
+        const auto& column = column_array[column_index];
+        uint64_t length = 0;
+        const auto* ptr = SkipHooked(reader, length);
+        ByteReader component_reader(ptr, length);
+        column.component_id.deserialize(
+            component_reader,
+            rows.ptr + i * dst_row_size + column.dst_offset);
+      }
+    }
+    placed_cnt += rows.cnt;
+  }
+
+  for (uint64_t i = 0; i < row_cnt; ++i) {
+    entity_route_array_[id_array[i].index()].entity_index = index_array[i];
+  }
+  size_ += row_cnt;
+  for (const auto& relation : descriptor.relation_array()) {
+    for (uint64_t i = 0; i < row_cnt; ++i) {
+      const auto view = std::as_const(archetype)[index_array[i]];
+      relation_index_.Add(relation, id_array[i],
+                          *relation.relation_target(view.TryGet(relation)));
+    }
+  }
+  return true;
+}
+
+bool EntityManager::LoadSparseSetSnapshot(
+    ByteReader& reader, const Array<ComponentId>& component_array) {
+  const auto* component_id = ReadComponent(reader, component_array);
+  const auto entity_cnt = reader.Read<uint64_t>();
+  if (!component_id ||
+      component_id->storage_type() != StorageType::kSparseSet ||
+      entity_cnt > reader.remaining() / sizeof(EntityId)) {
+    return false;
+  }
+  const auto* id_ptr = reader.Skip(entity_cnt * sizeof(EntityId));
+  auto& sparse_set = GetOrCreateSparseSet(*component_id);
+  const bool is_bytewise = component_id->is_bytewise_serializable();
+  const auto type_size = component_id->type_id().type_size();
+  for (uint64_t i = 0; i < entity_cnt; ++i) {
+    const auto entity_id = ReadEntityId(id_ptr + i * sizeof(EntityId));
+    uint64_t length = type_size;
+    const auto* ptr = is_bytewise ? reader.Skip(type_size)
+                                  : SkipHooked(reader, length);
+    if (!reader.is_ok() || !Contains(entity_id) ||
+        sparse_set.Contains(entity_id)) {
+      return false;
+    }
+    ByteReader component_reader(ptr, length);
+    component_id->deserialize(component_reader,
+                              sparse_set.PushUninitialized(entity_id));
+  }
+  return true;
+}
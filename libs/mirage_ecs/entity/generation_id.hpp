@@ -3,7 +3,10 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <type_traits>
 
+#include "mirage_base/util/hash.hpp"
+#include "mirage_base/util/relocate.hpp"
 #include "mirage_ecs/define/export.hpp"
 
 namespace mirage::ecs {
@@ -48,4 +51,17 @@ using ArchetypeId = GenerationId;
 
 }  // namespace mirage::ecs
 
+// The destructor only resets the fields, so the bytes can be moved as is.
+template <>
+struct mirage::base::IsTriviallyRelocatable<mirage::ecs::GenerationId>
+    : std::true_type {};
+
+// Ids are hashed with their generation, so a reused index is another key.
+template <>
+struct mirage::base::Hash<mirage::ecs::GenerationId> {
+  size_t operator()(const mirage::ecs::GenerationId &id) const {
+    return id.index() ^ (id.generation() << (sizeof(size_t) * 4));
+  }
+};
+
 #endif  // MIRAGE_ECS_ENTITY_GENERATION_ID
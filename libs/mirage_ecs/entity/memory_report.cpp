@@ -0,0 +1,45 @@
+#include "mirage_ecs/entity/memory_report.hpp"
+
+#include "mirage_base/util/format.hpp"
+
+using namespace mirage;
+using namespace mirage::ecs;
+
+size_t ArchetypeMemory::allocated_bytes() const {
+  return data_bytes + sparse_bytes + dense_bytes;
+}
+
+size_t ArchetypeMemory::used_bytes() const {
+  return data_used_bytes + sparse_used_bytes + dense_used_bytes;
+}
+
+std::string EntityMemory::DumpTable() const {
+  std::string out;
+  base::AppendFormat(out, "%-10s %10s %8s %8s %12s %12s %8s\n",
+                     "archetype", "entities", "chunks", "partial",
+                     "allocated", "used", "holes");
+  for (const auto& archetype : archetype_array) {
+    base::AppendFormat(out, "%-10zu %10zu %8zu %8zu %12zu %12zu %8zu\n",
+                       archetype.archetype_id.index(), archetype.entity_cnt,
+                       archetype.chunk_cnt, archetype.partial_chunk_cnt,
+                       archetype.allocated_bytes(), archetype.used_bytes(),
+                       archetype.sparse_hole_cnt);
+  }
+
+  base::AppendFormat(out, "\n%-48s %6s %10s %12s %12s\n", "component", "sparse",
+                     "entities", "allocated", "used");
+  for (const auto& component : component_array) {
+    base::AppendFormat(out, "%-48s %6s %10zu %12zu %12zu\n",
+                       component.type_id.type_name(),
+                       component.storage_type == StorageType::kSparseSet
+                           ? "yes"
+                           : "no",
+                       component.entity_cnt, component.allocated_bytes,
+                       component.used_bytes);
+  }
+
+  base::AppendFormat(
+      out, "\nentities %zu, allocated %zu, used %zu, bookkeeping %zu\n",
+      entity_cnt, allocated_bytes, used_bytes, bookkeeping_bytes);
+  return out;
+}
@@ -0,0 +1,64 @@
+#ifndef MIRAGE_ECS_ENTITY_MEMORY_REPORT
+#define MIRAGE_ECS_ENTITY_MEMORY_REPORT
+
+#include <cstddef>
+#include <string>
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_base/util/type_id.hpp"
+#include "mirage_ecs/define/export.hpp"
+#include "mirage_ecs/entity/generation_id.hpp"
+#include "mirage_ecs/util/marker.hpp"
+
+namespace mirage::ecs {
+
+// Memory held by the entity storage, see `EntityManager::MemoryReport`.
+//
+// Allocated bytes count whole buffers, used bytes only the live entries, so
+// the difference is capacity that is reserved but holds nothing.
+struct MIRAGE_ECS ArchetypeMemory {
+  ArchetypeId archetype_id;
+  size_t entity_cnt{0};
+  size_t chunk_cnt{0};
+  // Data chunks with free slots. Removal fills the hole from the tail, so
+  // usually only the last chunk is partial.
+  size_t partial_chunk_cnt{0};
+
+  size_t data_bytes{0};
+  size_t data_used_bytes{0};
+  size_t sparse_bytes{0};
+  size_t sparse_used_bytes{0};
+  // Free sparse slots, left behind by removed entities or not used yet.
+  size_t sparse_hole_cnt{0};
+  size_t dense_bytes{0};
+  size_t dense_used_bytes{0};
+
+  [[nodiscard]] size_t allocated_bytes() const;
+  [[nodiscard]] size_t used_bytes() const;
+};
+
+// One component type summed over every archetype, or its sparse set.
+struct MIRAGE_ECS ComponentMemory {
+  base::TypeId type_id;
+  StorageType storage_type{StorageType::kTable};
+  size_t entity_cnt{0};
+  size_t allocated_bytes{0};
+  size_t used_bytes{0};
+};
+
+struct MIRAGE_ECS EntityMemory {
+  base::Array<ArchetypeMemory> archetype_array;
+  base::Array<ComponentMemory> component_array;
+  // Entity routes and free lists of the entity manager itself.
+  size_t bookkeeping_bytes{0};
+
+  size_t entity_cnt{0};
+  size_t allocated_bytes{0};
+  size_t used_bytes{0};
+
+  [[nodiscard]] std::string DumpTable() const;
+};
+
+}  // namespace mirage::ecs
+
+#endif  // MIRAGE_ECS_ENTITY_MEMORY_REPORT
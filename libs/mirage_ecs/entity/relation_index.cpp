@@ -0,0 +1,79 @@
+#include "mirage_ecs/entity/relation_index.hpp"
+
+#include "mirage_base/define/check.hpp"
+
+using namespace mirage::base;
+using namespace mirage::ecs;
+
+void RelationIndex::Add(const ComponentId& relation, const EntityId& source,
+                        const EntityId& target) {
+  MIRAGE_DCHECK(target.is_valid());
+  auto& source_list_array = target_map_[target];
+  for (auto& source_list : source_list_array) {
+    if (source_list.relation == relation) {
+      source_list.source_array.Push(source);
+      return;
+    }
+  }
+  source_list_array.Push(SourceList{.relation = relation, .source_array = {}});
+  source_list_array.Tail().source_array.Push(source);
+}
+
+void RelationIndex::Remove(const ComponentId& relation, const EntityId& source,
+                           const EntityId& target) {
+  const auto it = target_map_.TryFind(target);
+  if (!it) {
+    return;
+  }
+  auto& source_list_array = it->val();
+  for (size_t i = 0; i < source_list_array.size(); ++i) {
+    auto& source_array = source_list_array[i].source_array;
+    if (source_list_array[i].relation != relation) {
+      continue;
+    }
+    for (size_t j = 0; j < source_array.size(); ++j) {
+      if (source_array[j] == source) {
+        source_array.SwapRemove(j);
+        break;
+      }
+    }
+    if (source_array.empty()) {
+      source_list_array.SwapRemove(i);
+    }
+    break;
+  }
+  if (source_list_array.empty()) {
+    target_map_.Remove(target);
+  }
+}
+
+const Array<EntityId>* RelationIndex::TryGetSources(
+    const ComponentId& relation, const EntityId& target) const {
+  const auto it = target_map_.TryFind(target);
+  if (!it) {
+    return nullptr;
+  }
+  for (const auto& source_list : it->val()) {
+    if (source_list.relation == relation) {
+      return &source_list.source_array;
+    }
+  }
+  return nullptr;
+}
+
+Array<RelationIndex::Pair> RelationIndex::TakeTarget(const EntityId& target) {
+  Array<Pair> pair_array;
+  const auto it = target_map_.TryFind(target);
+  if (!it) {
+    return pair_array;
+  }
+  for (const auto& source_list : it->val()) {
+    for (const auto& source : source_list.source_array) {
+      pair_array.Push(Pair{.relation = source_list.relation, .source = source});
+    }
+  }
+  target_map_.Remove(target);
+  return pair_array;
+}
+
+size_t RelationIndex::size() const { return target_map_.size(); }
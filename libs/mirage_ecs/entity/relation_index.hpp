@@ -0,0 +1,59 @@
+#ifndef MIRAGE_ECS_ENTITY_RELATION_INDEX
+#define MIRAGE_ECS_ENTITY_RELATION_INDEX
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_base/container/hash_map.hpp"
+#include "mirage_ecs/component/component_handler.hpp"
+#include "mirage_ecs/define/export.hpp"
+#include "mirage_ecs/entity/generation_id.hpp"
+
+namespace mirage::ecs {
+
+// Reverse index of relation pairs, from a target to the entities pointing at
+// it through each relation kind. Targets are keyed by their full id, so a
+// stale target never aliases the live entity that reused its index.
+class RelationIndex {
+  template <typename T>
+  using Array = base::Array<T>;
+
+ public:
+  struct Pair {
+    ComponentId relation;
+    EntityId source;
+  };
+
+  MIRAGE_ECS RelationIndex() = default;
+  MIRAGE_ECS ~RelationIndex() = default;
+
+  RelationIndex(const RelationIndex &) = delete;
+  RelationIndex &operator=(const RelationIndex &) = delete;
+
+  MIRAGE_ECS RelationIndex(RelationIndex &&) noexcept = default;
+  MIRAGE_ECS RelationIndex &operator=(RelationIndex &&) noexcept = default;
+
+  MIRAGE_ECS void Add(const ComponentId &relation, const EntityId &source,
+                      const EntityId &target);
+  MIRAGE_ECS void Remove(const ComponentId &relation, const EntityId &source,
+                         const EntityId &target);
+
+  [[nodiscard]] MIRAGE_ECS const Array<EntityId> *TryGetSources(
+      const ComponentId &relation, const EntityId &target) const;
+
+  // Drop every pair pointing at `target` and return them.
+  MIRAGE_ECS Array<Pair> TakeTarget(const EntityId &target);
+
+  // Number of entities that are the target of at least one pair.
+  [[nodiscard]] MIRAGE_ECS size_t size() const;
+
+ private:
+  struct SourceList {
+    ComponentId relation;
+    Array<EntityId> source_array;
+  };
+
+  base::HashMap<EntityId, Array<SourceList>> target_map_;
+};
+
+}  // namespace mirage::ecs
+
+#endif  // MIRAGE_ECS_ENTITY_RELATION_INDEX
@@ -0,0 +1,73 @@
+#ifndef MIRAGE_ECS_ENTITY_SNAPSHOT_BASELINE
+#define MIRAGE_ECS_ENTITY_SNAPSHOT_BASELINE
+
+#include <cstdint>
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_base/container/hash_map.hpp"
+#include "mirage_base/util/type_id.hpp"
+#include "mirage_ecs/component/component_handler.hpp"
+#include "mirage_ecs/entity/generation_id.hpp"
+#include "mirage_ecs/util/tick.hpp"
+#include "mirage_ecs/util/type_set.hpp"
+
+namespace mirage::ecs {
+
+// What one end of a replication link knows the other end holds, the base of
+// the next snapshot delta. The sender and the receiver keep one each, see
+// `EntityManager::SaveDelta`. Fresh baselines make the next delta carry every
+// entity.
+class SnapshotBaseline {
+  template <typename T>
+  using Array = base::Array<T>;
+
+ public:
+  SnapshotBaseline() = default;
+  ~SnapshotBaseline() = default;
+
+  SnapshotBaseline(const SnapshotBaseline &) = delete;
+  SnapshotBaseline &operator=(const SnapshotBaseline &) = delete;
+
+  SnapshotBaseline(SnapshotBaseline &&) noexcept = default;
+  SnapshotBaseline &operator=(SnapshotBaseline &&) noexcept = default;
+
+  // Deltas saved or applied against it so far.
+  [[nodiscard]] uint64_t sequence() const { return sequence_; }
+
+ private:
+  friend class EntityManager;
+
+  // An archetype with rows sent, referred to by its index in
+  // `archetype_array_`.
+  struct ArchetypeState {
+    // The archetype on this end.
+    ArchetypeId archetype_id;
+    TypeSet type_set;
+    // Columns in the order both ends walk them.
+    Array<ComponentId> column_array;
+    // Sender only, the rows the receiver holds. Hooked columns are resent
+    // whole and keep no bytes.
+    Array<EntityId> entity_array;
+    Array<Array<uint8_t>> bytes_array;
+  };
+
+  uint64_t sequence_{0};
+  // Writes stamped at this tick or later may not have been sent yet.
+  Tick tick_{kInitTick};
+
+  // Components by their index in the deltas, the sender also maps them back.
+  Array<ComponentId> component_array_;
+  base::HashMap<base::TypeId, uint32_t> component_index_map_;
+
+  Array<ArchetypeState> archetype_array_;
+  // Sender only, whether each of its archetypes is in `archetype_array_`.
+  Array<bool> is_sent_array_;
+  size_t slot_cnt_{0};
+  Array<EntityId> free_array_;
+  // Sender only, sparse sets as last sent.
+  base::HashMap<base::TypeId, Array<uint8_t>> sparse_set_map_;
+};
+
+}  // namespace mirage::ecs
+
+#endif  // MIRAGE_ECS_ENTITY_SNAPSHOT_BASELINE
@@ -0,0 +1,105 @@
+#ifndef MIRAGE_ECS_ENTITY_SNAPSHOT_IO
+#define MIRAGE_ECS_ENTITY_SNAPSHOT_IO
+
+#include <cstdint>
+#include <cstring>
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_base/io/byte_stream.hpp"
+#include "mirage_ecs/component/component_handler.hpp"
+#include "mirage_ecs/component/component_registry.hpp"
+#include "mirage_ecs/entity/component_sparse_set.hpp"
+#include "mirage_ecs/entity/generation_id.hpp"
+
+// Encoding helpers shared by snapshots and snapshot deltas, not part of the
+// public interface.
+namespace mirage::ecs::snapshot_io {
+
+static_assert(sizeof(EntityId) == 2 * sizeof(size_t));
+
+inline EntityId ReadEntityId(const uint8_t* ptr) {
+  EntityId entity_id;
+  std::memcpy(static_cast<void*>(&entity_id), ptr, sizeof(EntityId));
+  return entity_id;
+}
+
+inline void WriteHooked(base::ByteWriter& writer,
+                        const ComponentId& component_id,
+                        const void* component) {
+  const auto length_offset = writer.size();
+  writer.Write<uint64_t>(0);
+  component_id.serialize(component, writer);
+  writer.WriteAt(length_offset, static_cast<uint64_t>(writer.size() -
+                                                      length_offset -
+                                                      sizeof(uint64_t)));
+}
+
+// Name, u64 size, u8 bytewise.
+inline void WriteComponent(base::ByteWriter& writer,
+                           const ComponentId& component_id) {
+  const auto type_id = component_id.type_id();
+  writer.WriteString(type_id.type_name());
+  writer.Write(static_cast<uint64_t>(type_id.type_size()));
+  writer.Write(static_cast<uint8_t>(component_id.is_bytewise_serializable()));
+}
+
+// Read `cnt` components written by `WriteComponent` into `component_array`.
+// Their layout must not have changed since they were written.
+inline bool ReadComponents(base::ByteReader& reader, const uint32_t cnt,
+                           const ComponentRegistry& registry,
+                           base::Array<ComponentId>& component_array) {
+  for (uint32_t i = 0; i < cnt; ++i) {
+    const auto type_name = reader.ReadString();
+    const auto type_size = reader.Read<uint64_t>();
+    const bool is_bytewise = reader.Read<uint8_t>() != 0;
+    const auto* component_id = registry.TryFind(type_name);
+    if (!reader.is_ok() || !component_id ||
+        component_id->type_id().type_size() != type_size ||
+        component_id->is_bytewise_serializable() != is_bytewise ||
+        (!component_id->is_tag() && !component_id->is_serializable())) {
+      return false;
+    }
+    component_array.Push(*component_id);
+  }
+  return true;
+}
+
+// The serialized component behind a length prefix, null on failure.
+inline const uint8_t* SkipHooked(base::ByteReader& reader, uint64_t& length) {
+  length = reader.Read<uint64_t>();
+  const auto* ptr = reader.Skip(length);
+  return reader.is_ok() ? ptr : nullptr;
+}
+
+inline const ComponentId* ReadComponent(
+    base::ByteReader& reader, const base::Array<ComponentId>& component_array) {
+  const auto index = reader.Read<uint32_t>();
+  if (!reader.is_ok() || index >= component_array.size()) {
+    return nullptr;
+  }
+  return &component_array[index];
+}
+
+// u64 entity count, entity ids, then per entity the component bytes, or u64
+// length and serialized component.
+inline void WriteSparseSet(base::ByteWriter& writer,
+                           const ComponentSparseSet& sparse_set) {
+  const auto& component_id = sparse_set.component_id();
+  const auto& entity_array = sparse_set.entity_array();
+  writer.Write(static_cast<uint64_t>(entity_array.size()));
+  writer.WriteBytes(entity_array.data(),
+                    entity_array.size() * sizeof(EntityId));
+  const bool is_bytewise = component_id.is_bytewise_serializable();
+  for (const auto& entity_id : entity_array) {
+    const auto* component = sparse_set.TryGet(entity_id);
+    if (is_bytewise) {
+      component_id.serialize(component, writer);
+    } else {
+      WriteHooked(writer, component_id, component);
+    }
+  }
+}
+
+}  // namespace mirage::ecs::snapshot_io
+
+#endif  // MIRAGE_ECS_ENTITY_SNAPSHOT_IO
@@ -0,0 +1,167 @@
+#include "mirage_ecs/framework/hierarchy.hpp"
+
+#include "mirage_base/define/check.hpp"
+#include "mirage_ecs/framework/world.hpp"
+
+using namespace mirage;
+using namespace mirage::ecs;
+
+void Hierarchy::Update(const EntityManager& entity_manager) {
+  const auto transform_id = ComponentId::Of<Transform>();
+  const auto& archetype_array = entity_manager.archetype_array();
+
+  // Spawns, despawns and moves stamp the row tick of their chunks. Only a
+  // despawn that empties a chunk may leave no chunk behind to stamp, but it
+  // changes the count.
+  size_t entity_cnt = 0;
+  bool is_moved = false;
+  for (const auto& archetype : archetype_array) {
+    if (!archetype.descriptor().type_set().With(transform_id.type_id())) {
+      continue;
+    }
+    entity_cnt += archetype.size();
+    for (const auto& chunk : archetype.chunk_array()) {
+      is_moved = is_moved || chunk.row_tick() > last_update_tick_;
+    }
+  }
+
+  if (is_moved || entity_cnt != entity_array_.size()) {
+    Rebuild(entity_manager);
+  } else {
+    for (const auto& archetype : archetype_array) {
+      for (const auto& chunk : archetype.chunk_array()) {
+        if (!chunk.IsColumnChanged(transform_id, last_update_tick_)) {
+          continue;
+        }
+        for (uint16_t row = 0; row < chunk.size(); ++row) {
+          // Without moves every row was placed by the last rebuild.
+          const auto it = slot_map_.TryFind(chunk.entity_id_data()[row]);
+          MIRAGE_DCHECK(it);
+          const auto slot = it->val();
+          dirty_[slot] = 1;
+          subtree_array_[slot_subtree_[slot]].is_dirty = true;
+        }
+      }
+    }
+  }
+
+  const auto change_tick = entity_manager.change_tick();
+  last_update_tick_ = change_tick == kInitTick ? kInitTick : change_tick - 1;
+}
+
+void Hierarchy::Propagate(const EntityManager& entity_manager) {
+  Update(entity_manager);
+  for (size_t i = 0; i < subtree_array_.size(); ++i) {
+    PropagateSubtree(entity_manager, i);
+  }
+}
+
+void Hierarchy::PropagateSubtree(const EntityManager& entity_manager,
+                                 const size_t subtree_index) {
+  auto& subtree = subtree_array_[subtree_index];
+  if (!subtree.is_dirty) {
+    return;
+  }
+
+  // Parents always sit before their children, and a dirty parent marks its
+  // children dirty on the way down.
+  for (auto slot = subtree.begin; slot < subtree.end; ++slot) {
+    const auto& local =
+        *entity_manager.TryGetComponent<Transform>(entity_array_[slot]);
+    const auto parent = parent_slot_[slot];
+    if (parent == kInvalidSlot) {
+      if (dirty_[slot]) {
+        global_[slot] = local;
+      }
+    } else if (dirty_[slot] || dirty_[parent]) {
+      global_[slot] = global_[parent] * local;
+      dirty_[slot] = 1;
+    }
+  }
+  for (auto slot = subtree.begin; slot < subtree.end; ++slot) {
+    dirty_[slot] = 0;
+  }
+  subtree.is_dirty = false;
+}
+
+const Transform* Hierarchy::TryGetGlobal(const EntityId& entity) const {
+  const auto it = slot_map_.TryFind(entity);
+  if (!it) {
+    return nullptr;
+  }
+  return &global_[it->val()];
+}
+
+const base::Array<Hierarchy::Subtree>& Hierarchy::subtree_array() const {
+  return subtree_array_;
+}
+
+size_t Hierarchy::size() const { return entity_array_.size(); }
+
+void Hierarchy::Rebuild(const EntityManager& entity_manager) {
+  const auto transform_type_id = base::TypeId::Of<Transform>();
+  auto has_transform = [&](const EntityId& entity) {
+    return entity_manager.TryGetComponent<Transform>(entity) != nullptr;
+  };
+
+  // Entities whose parent has no transform are roots as well.
+  Array<EntityId> root_array;
+  for (const auto& archetype : entity_manager.archetype_array()) {
+    if (!archetype.descriptor().type_set().With(transform_type_id)) {
+      continue;
+    }
+    for (const auto& chunk : archetype.chunk_array()) {
+      for (uint16_t row = 0; row < chunk.size(); ++row) {
+        const auto* child_of = chunk[row].TryGet<Relation<ChildOf>>();
+        if (!child_of || !has_transform(child_of->target)) {
+          root_array.Push(chunk.entity_id_data()[row]);
+        }
+      }
+    }
+  }
+
+  slot_map_ = {};
+  entity_array_.Clear();
+  parent_slot_.Clear();
+  slot_subtree_.Clear();
+  global_.Clear();
+  dirty_.Clear();
+  subtree_array_.Clear();
+
+  auto push = [&](const EntityId& entity, const size_t parent) {
+    slot_map_.Insert(entity, entity_array_.size());
+    entity_array_.Push(entity);
+    parent_slot_.Push(parent);
+    slot_subtree_.Push(subtree_array_.size());
+    global_.Emplace();
+    dirty_.Push(1);
+  };
+
+  for (const auto& root : root_array) {
+    // Breadth-first walk, the slot arrays double as the queue.
+    Subtree subtree;
+    subtree.begin = entity_array_.size();
+    subtree.is_dirty = true;
+    push(root, kInvalidSlot);
+    for (auto head = subtree.begin; head < entity_array_.size(); ++head) {
+      const auto* child_array =
+          entity_manager.TryGetSources<ChildOf>(entity_array_[head]);
+      if (!child_array) {
+        continue;
+      }
+      for (const auto& child : *child_array) {
+        if (has_transform(child)) {
+          push(child, head);
+        }
+      }
+    }
+    subtree.end = entity_array_.size();
+    subtree_array_.Push(subtree);
+  }
+}
+
+void HierarchyPlugin::Build(World& world) { world.InitResource<Hierarchy>(); }
+
+void mirage::ecs::PropagateTransform(World& world) {
+  world.GetResource<Hierarchy>().Propagate(world.entity_manager());
+}
@@ -0,0 +1,98 @@
+#ifndef MIRAGE_ECS_FRAMEWORK_HIERARCHY
+#define MIRAGE_ECS_FRAMEWORK_HIERARCHY
+
+#include <cstdint>
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_base/container/hash_map.hpp"
+#include "mirage_ecs/component/relation.hpp"
+#include "mirage_ecs/define/export.hpp"
+#include "mirage_ecs/entity/entity_manager.hpp"
+#include "mirage_ecs/entity/generation_id.hpp"
+#include "mirage_ecs/framework/plugin.hpp"
+#include "mirage_ecs/framework/transform.hpp"
+#include "mirage_ecs/util/marker.hpp"
+#include "mirage_ecs/util/tick.hpp"
+
+namespace mirage::ecs {
+
+// Relation kind linking a child to its parent, spawned with
+// `Relation<ChildOf>(parent)`. Children of a despawned parent lose the
+// relation and become roots.
+struct ChildOf {};
+
+// World transforms of the entities with a `Transform` component, which is
+// relative to the parent.
+//
+// Nodes are stored in slots. Every root owns a contiguous range of slots, and
+// inside the range the nodes are sorted breadth-first, so a parent always comes
+// before its children and the world transforms can be updated in one linear
+// pass. The layout is rebuilt from the components when rows were spawned,
+// despawned or moved since the last update.
+class Hierarchy {
+  template <typename T>
+  using Array = base::Array<T>;
+
+ public:
+  MIRAGE_RESOURCE;
+
+  constexpr static size_t kInvalidSlot = SIZE_MAX;
+
+  struct Subtree {
+    size_t begin{0};
+    size_t end{0};
+    bool is_dirty{false};
+  };
+
+  MIRAGE_ECS Hierarchy() = default;
+  MIRAGE_ECS ~Hierarchy() = default;
+
+  Hierarchy(const Hierarchy &) = delete;
+  Hierarchy &operator=(const Hierarchy &) = delete;
+
+  MIRAGE_ECS Hierarchy(Hierarchy &&) noexcept = default;
+  MIRAGE_ECS Hierarchy &operator=(Hierarchy &&) noexcept = default;
+
+  // Catch up with `entity_manager` and mark the subtrees holding a chunk whose
+  // transforms changed since the last update.
+  MIRAGE_ECS void Update(const EntityManager &entity_manager);
+  MIRAGE_ECS void Propagate(const EntityManager &entity_manager);
+  // Subtrees never share slots, so after `Update` they can be propagated from
+  // different threads.
+  MIRAGE_ECS void PropagateSubtree(const EntityManager &entity_manager,
+                                   size_t subtree_index);
+
+  // The world transform as of the last `Propagate`.
+  [[nodiscard]] MIRAGE_ECS const Transform *TryGetGlobal(
+      const EntityId &entity) const;
+
+  [[nodiscard]] MIRAGE_ECS const Array<Subtree> &subtree_array() const;
+  [[nodiscard]] MIRAGE_ECS size_t size() const;
+
+ private:
+  MIRAGE_ECS void Rebuild(const EntityManager &entity_manager);
+
+  base::HashMap<EntityId, size_t> slot_map_;
+
+  Array<EntityId> entity_array_;
+  Array<size_t> parent_slot_;
+  Array<size_t> slot_subtree_;
+  Array<Transform> global_;
+  // Slots of the chunks found changed by the current update.
+  Array<uint8_t> dirty_;
+
+  Array<Subtree> subtree_array_;
+  // The last tick fully observed, see `System::Run`.
+  Tick last_update_tick_{kInitTick};
+};
+
+class MIRAGE_ECS HierarchyPlugin final : public Plugin {
+ public:
+  void Build(World &world) override;
+};
+
+MIRAGE_ECS void PropagateTransform(World &world);
+
+}  // namespace mirage::ecs
+
+#endif  // MIRAGE_ECS_FRAMEWORK_HIERARCHY
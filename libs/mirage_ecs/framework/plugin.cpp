@@ -1 +1 @@
-#include "mirage_ecs/framework/plugin.hpp"
\ No newline at end of file
+#include "mirage_ecs/framework/plugin.hpp"
@@ -1,4 +1,28 @@
 #ifndef MIRAGE_ECS_FRAMEWORK_PLUGIN
 #define MIRAGE_ECS_FRAMEWORK_PLUGIN
 
+#include <concepts>
+
+#include "mirage_ecs/define/export.hpp"
+
+namespace mirage::ecs {
+
+class World;
+
+class MIRAGE_ECS Plugin {
+ public:
+  Plugin() = default;
+  virtual ~Plugin() = default;
+
+  Plugin(const Plugin &) = delete;
+  Plugin &operator=(const Plugin &) = delete;
+
+  virtual void Build(World &world) = 0;
+};
+
+template <typename T>
+concept IsPlugin = std::derived_from<T, Plugin>;
+
+}  // namespace mirage::ecs
+
 #endif  // MIRAGE_ECS_FRAMEWORK_PLUGIN
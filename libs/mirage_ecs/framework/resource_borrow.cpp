@@ -0,0 +1,55 @@
+#include "mirage_ecs/framework/resource_borrow.hpp"
+
+#include "mirage_base/define/check.hpp"
+
+using namespace mirage::ecs;
+
+ResourceBorrow::ResourceBorrow(
+    [[maybe_unused]] ResourceBorrow&& other) noexcept {
+  MIRAGE_DCHECK(other.state_.load(std::memory_order_relaxed) == 0);
+}
+
+ResourceBorrow& ResourceBorrow::operator=(
+    [[maybe_unused]] ResourceBorrow&& other) noexcept {
+  MIRAGE_DCHECK(state_.load(std::memory_order_relaxed) == 0);
+  MIRAGE_DCHECK(other.state_.load(std::memory_order_relaxed) == 0);
+  return *this;
+}
+
+bool ResourceBorrow::TryBorrowRead() {
+  // Readers never wait for each other, so optimistically count in and back
+  // out again if a writer holds the resource.
+  const auto state = state_.fetch_add(1, std::memory_order_acquire);
+  if ((state & kWriter) != 0) {
+    state_.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+void ResourceBorrow::ReleaseRead() {
+  [[maybe_unused]] const auto state =
+      state_.fetch_sub(1, std::memory_order_release);
+  MIRAGE_DCHECK((state & ~kWriter) != 0);
+}
+
+bool ResourceBorrow::TryBorrowWrite() {
+  uint32_t expected = 0;
+  return state_.compare_exchange_strong(expected, kWriter,
+                                        std::memory_order_acquire,
+                                        std::memory_order_relaxed);
+}
+
+void ResourceBorrow::ReleaseWrite() {
+  [[maybe_unused]] const auto state =
+      state_.fetch_and(~kWriter, std::memory_order_release);
+  MIRAGE_DCHECK((state & kWriter) != 0);
+}
+
+uint32_t ResourceBorrow::reader_cnt() const {
+  return state_.load(std::memory_order_relaxed) & ~kWriter;
+}
+
+bool ResourceBorrow::is_writing() const {
+  return (state_.load(std::memory_order_relaxed) & kWriter) != 0;
+}
@@ -0,0 +1,43 @@
+#ifndef MIRAGE_ECS_FRAMEWORK_RESOURCE_BORROW
+#define MIRAGE_ECS_FRAMEWORK_RESOURCE_BORROW
+
+#include <atomic>
+#include <cstdint>
+
+#include "mirage_ecs/define/export.hpp"
+
+namespace mirage::ecs {
+
+// Borrow state of one resource: a count of readers plus a writer flag. Many
+// systems may read a resource at once, a writer needs it alone. Borrowing
+// never blocks, a failed borrow means the systems were scheduled wrong.
+class ResourceBorrow {
+ public:
+  ResourceBorrow() = default;
+  MIRAGE_ECS ~ResourceBorrow() = default;
+
+  ResourceBorrow(const ResourceBorrow &) = delete;
+  ResourceBorrow &operator=(const ResourceBorrow &) = delete;
+
+  // Only a resource nobody borrows may be moved.
+  MIRAGE_ECS ResourceBorrow(ResourceBorrow &&other) noexcept;
+  MIRAGE_ECS ResourceBorrow &operator=(ResourceBorrow &&other) noexcept;
+
+  MIRAGE_ECS bool TryBorrowRead();
+  MIRAGE_ECS void ReleaseRead();
+
+  MIRAGE_ECS bool TryBorrowWrite();
+  MIRAGE_ECS void ReleaseWrite();
+
+  [[nodiscard]] MIRAGE_ECS uint32_t reader_cnt() const;
+  [[nodiscard]] MIRAGE_ECS bool is_writing() const;
+
+ private:
+  constexpr static uint32_t kWriter = 1U << 31;
+
+  std::atomic<uint32_t> state_{0};
+};
+
+}  // namespace mirage::ecs
+
+#endif  // MIRAGE_ECS_FRAMEWORK_RESOURCE_BORROW
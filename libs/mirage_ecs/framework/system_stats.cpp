@@ -0,0 +1,131 @@
+#include "mirage_ecs/framework/system_stats.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+
+#include "mirage_base/util/format.hpp"
+
+using namespace mirage;
+using namespace mirage::ecs;
+
+using Sample = SystemStats::Sample;
+using Summary = SystemStats::Summary;
+
+void SystemStats::Record(const size_t system_id, const char *name,
+                         const Sample &sample) {
+  base::ScopedLockGuard guard(lock_);
+  const auto iter = entry_index_map_.TryFind(system_id);
+  size_t entry_index = entry_array_.size();
+  if (iter == entry_index_map_.end()) {
+    entry_index_map_.Insert(system_id, entry_index);
+    entry_array_.Emplace(Entry{.name = name, .sample_array = {}});
+  } else {
+    entry_index = iter->val();
+  }
+
+  auto &entry = entry_array_[entry_index];
+  if (entry.sample_array.size() < kWindowSize) {
+    entry.sample_array.Push(sample);
+  } else {
+    entry.sample_array[entry.run_cnt % kWindowSize] = sample;
+  }
+  ++entry.run_cnt;
+}
+
+base::Array<Summary> SystemStats::Summarize() const {
+  base::ScopedLockGuard guard(lock_);
+  Array<Summary> summary_array;
+  summary_array.Reserve(entry_array_.size());
+  for (const auto &entry : entry_array_) {
+    Summary summary{.name = entry.name,
+                    .run_cnt = entry.run_cnt,
+                    .sample_cnt = entry.sample_array.size()};
+    uint64_t total_run_ns = 0;
+    size_t total_entity_cnt = 0;
+    size_t total_chunk_cnt = 0;
+    size_t total_structural_change_cnt = 0;
+    for (const auto &sample : entry.sample_array) {
+      total_run_ns += sample.run_ns;
+      summary.max_run_ns = std::max(summary.max_run_ns, sample.run_ns);
+      total_entity_cnt += sample.entity_cnt;
+      total_chunk_cnt += sample.chunk_cnt;
+      total_structural_change_cnt += sample.structural_change_cnt;
+    }
+    if (summary.sample_cnt != 0) {
+      const auto sample_cnt = static_cast<double>(summary.sample_cnt);
+      summary.mean_run_ns = total_run_ns / summary.sample_cnt;
+      summary.mean_entity_cnt =
+          static_cast<double>(total_entity_cnt) / sample_cnt;
+      summary.mean_chunk_cnt =
+          static_cast<double>(total_chunk_cnt) / sample_cnt;
+      summary.mean_structural_change_cnt =
+          static_cast<double>(total_structural_change_cnt) / sample_cnt;
+    }
+    summary_array.Push(summary);
+  }
+  return summary_array;
+}
+
+base::Array<Sample> SystemStats::Window(const size_t system_id) const {
+  base::ScopedLockGuard guard(lock_);
+  Array<Sample> sample_array;
+  const auto iter = entry_index_map_.TryFind(system_id);
+  if (iter == entry_index_map_.end()) {
+    return sample_array;
+  }
+
+  const auto &entry = entry_array_[iter->val()];
+  const auto sample_cnt = entry.sample_array.size();
+  // Before the window is full the oldest sample is the first one.
+  const auto oldest =
+      sample_cnt < kWindowSize ? 0 : entry.run_cnt % kWindowSize;
+  sample_array.Reserve(sample_cnt);
+  for (size_t i = 0; i < sample_cnt; ++i) {
+    sample_array.Push(entry.sample_array[(oldest + i) % sample_cnt]);
+  }
+  return sample_array;
+}
+
+std::string SystemStats::DumpTable() const {
+  std::string out;
+  base::AppendFormat(out, "%-48s %10s %12s %12s %12s %10s %10s\n", "name",
+                     "runs", "mean_us", "max_us", "entities", "chunks",
+                     "changes");
+  for (const auto &summary : Summarize()) {
+    base::AppendFormat(
+        out, "%-48s %10" PRIu64 " %12.3f %12.3f %12.1f %10.1f %10.1f\n",
+        summary.name, summary.run_cnt,
+        static_cast<double>(summary.mean_run_ns) / 1000.0,
+        static_cast<double>(summary.max_run_ns) / 1000.0,
+        summary.mean_entity_cnt, summary.mean_chunk_cnt,
+        summary.mean_structural_change_cnt);
+  }
+  return out;
+}
+
+std::string SystemStats::DumpJson() const {
+  std::string out = "[";
+  const auto summary_array = Summarize();
+  for (size_t i = 0; i < summary_array.size(); ++i) {
+    const auto &summary = summary_array[i];
+    out += i == 0 ? "{\"name\":\"" : ",{\"name\":\"";
+    base::AppendJsonEscaped(out, summary.name);
+    base::AppendFormat(out,
+                       "\",\"run_cnt\":%" PRIu64 ",\"sample_cnt\":%zu"
+                       ",\"mean_run_ns\":%" PRIu64 ",\"max_run_ns\":%" PRIu64
+                       ",\"mean_entity_cnt\":%.3f,\"mean_chunk_cnt\":%.3f"
+                       ",\"mean_structural_change_cnt\":%.3f}",
+                       summary.run_cnt, summary.sample_cnt,
+                       summary.mean_run_ns, summary.max_run_ns,
+                       summary.mean_entity_cnt, summary.mean_chunk_cnt,
+                       summary.mean_structural_change_cnt);
+  }
+  out += "]";
+  return out;
+}
+
+void SystemStats::Reset() {
+  base::ScopedLockGuard guard(lock_);
+  entry_array_.Clear();
+  entry_index_map_ = base::HashMap<size_t, size_t>();
+}
@@ -0,0 +1,86 @@
+#ifndef MIRAGE_ECS_FRAMEWORK_SYSTEM_STATS
+#define MIRAGE_ECS_FRAMEWORK_SYSTEM_STATS
+
+#include <cstdint>
+#include <string>
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_base/container/hash_map.hpp"
+#include "mirage_base/sync/lock.hpp"
+#include "mirage_ecs/define/export.hpp"
+#include "mirage_ecs/util/marker.hpp"
+
+namespace mirage::ecs {
+
+// Runtime statistics of the systems run on a world.
+//
+// Only collected while the resource exists, so add it with
+// `World::InitResource<SystemStats>()` to opt in. Every system keeps a rolling
+// window of its last `kWindowSize` runs. Systems may run in parallel, so
+// recording locks.
+class SystemStats {
+  template <typename T>
+  using Array = base::Array<T>;
+
+ public:
+  MIRAGE_RESOURCE;
+
+  constexpr static size_t kWindowSize = 64;
+
+  struct Sample {
+    uint64_t run_ns{0};
+    size_t entity_cnt{0};
+    size_t chunk_cnt{0};
+    size_t structural_change_cnt{0};
+  };
+
+  // Aggregated over the samples in the window.
+  struct Summary {
+    const char *name{nullptr};
+    uint64_t run_cnt{0};
+    size_t sample_cnt{0};
+    uint64_t mean_run_ns{0};
+    uint64_t max_run_ns{0};
+    double mean_entity_cnt{0.0};
+    double mean_chunk_cnt{0.0};
+    double mean_structural_change_cnt{0.0};
+  };
+
+  MIRAGE_ECS SystemStats() = default;
+  MIRAGE_ECS ~SystemStats() = default;
+
+  SystemStats(const SystemStats &) = delete;
+  SystemStats &operator=(const SystemStats &) = delete;
+
+  MIRAGE_ECS SystemStats(SystemStats &&) noexcept = default;
+  MIRAGE_ECS SystemStats &operator=(SystemStats &&) noexcept = default;
+
+  // The name must outlive the resource, see `System::name`.
+  MIRAGE_ECS void Record(size_t system_id, const char *name,
+                         const Sample &sample);
+
+  // Systems in the order they first ran.
+  [[nodiscard]] MIRAGE_ECS Array<Summary> Summarize() const;
+  // The window of a system from oldest to newest, empty if it never ran.
+  [[nodiscard]] MIRAGE_ECS Array<Sample> Window(size_t system_id) const;
+  [[nodiscard]] MIRAGE_ECS std::string DumpTable() const;
+  [[nodiscard]] MIRAGE_ECS std::string DumpJson() const;
+
+  MIRAGE_ECS void Reset();
+
+ private:
+  struct Entry {
+    const char *name{nullptr};
+    uint64_t run_cnt{0};
+    // Ring of samples, `run_cnt % kWindowSize` is the next one to overwrite.
+    Array<Sample> sample_array;
+  };
+
+  base::Lock lock_;
+  Array<Entry> entry_array_;
+  base::HashMap<size_t, size_t> entry_index_map_;
+};
+
+}  // namespace mirage::ecs
+
+#endif  // MIRAGE_ECS_FRAMEWORK_SYSTEM_STATS
@@ -0,0 +1,45 @@
+#include "mirage_ecs/framework/transform.hpp"
+
+using namespace mirage::ecs;
+
+Transform Transform::Identity() { return {}; }
+
+Transform Transform::FromTranslation(const float x, const float y,
+                                     const float z) {
+  Transform transform;
+  transform.matrix[12] = x;
+  transform.matrix[13] = y;
+  transform.matrix[14] = z;
+  return transform;
+}
+
+Transform Transform::FromScale(const float x, const float y, const float z) {
+  Transform transform;
+  transform.matrix[0] = x;
+  transform.matrix[5] = y;
+  transform.matrix[10] = z;
+  return transform;
+}
+
+Transform Transform::operator*(const Transform& other) const {
+  Transform rv;
+  for (auto col = 0; col < 4; ++col) {
+    for (auto row = 0; row < 4; ++row) {
+      float sum = 0;
+      for (auto k = 0; k < 4; ++k) {
+        sum += matrix[k * 4 + row] * other.matrix[col * 4 + k];
+      }
+      rv.matrix[col * 4 + row] = sum;
+    }
+  }
+  return rv;
+}
+
+bool Transform::operator==(const Transform& other) const {
+  for (auto i = 0; i < 16; ++i) {
+    if (matrix[i] != other.matrix[i]) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,26 @@
+#ifndef MIRAGE_ECS_FRAMEWORK_TRANSFORM
+#define MIRAGE_ECS_FRAMEWORK_TRANSFORM
+
+#include "mirage_ecs/define/export.hpp"
+#include "mirage_ecs/util/marker.hpp"
+
+namespace mirage::ecs {
+
+// Column-major 4x4 affine matrix. As a component it is the transform of an
+// entity relative to its parent.
+struct MIRAGE_ECS Transform {
+  MIRAGE_COMPONENT;
+
+  float matrix[16]{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+
+  static Transform Identity();
+  static Transform FromTranslation(float x, float y, float z);
+  static Transform FromScale(float x, float y, float z);
+
+  Transform operator*(const Transform &other) const;
+  bool operator==(const Transform &other) const;
+};
+
+}  // namespace mirage::ecs
+
+#endif  // MIRAGE_ECS_FRAMEWORK_TRANSFORM
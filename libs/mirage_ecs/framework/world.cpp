@@ -1 +1,146 @@
 #include "mirage_ecs/framework/world.hpp"
+
+#include <atomic>
+
+#include "mirage_base/container/hash_map.hpp"
+#include "mirage_base/io/byte_stream.hpp"
+#include "mirage_base/io/mapped_file.hpp"
+#include "mirage_base/sync/lock.hpp"
+
+using namespace mirage::base;
+using namespace mirage::ecs;
+
+namespace {
+
+std::atomic<size_t> next_world_id{0};
+
+struct ResourceIndexRegistry {
+  Lock lock;
+  HashMap<TypeId, size_t> index_map;
+};
+
+ResourceIndexRegistry& GetResourceIndexRegistry() {
+  static ResourceIndexRegistry registry;
+  return registry;
+}
+
+}  // namespace
+
+size_t mirage::ecs::AllocateResourceIndex(const TypeId type_id) {
+  auto& registry = GetResourceIndexRegistry();
+  ScopedLockGuard guard(registry.lock);
+  const auto iter = registry.index_map.TryFind(type_id);
+  if (iter != registry.index_map.end()) {
+    return iter->val();
+  }
+  const size_t index = registry.index_map.size();
+  registry.index_map.Insert(type_id, index);
+  return index;
+}
+
+World::World()
+    : id_(next_world_id.fetch_add(1, std::memory_order_relaxed)),
+      main_thread_id_(std::this_thread::get_id()) {
+  IncreaseChangeTick();
+}
+
+EntityManager& World::entity_manager() { return entity_manager_; }
+
+const EntityManager& World::entity_manager() const { return entity_manager_; }
+
+Tick World::IncreaseChangeTick() {
+  ++change_tick_;
+  entity_manager_.set_change_tick(change_tick_);
+  return change_tick_;
+}
+
+Tick World::change_tick() const { return change_tick_; }
+
+bool World::CloneInto(World& dst) const {
+  MIRAGE_DCHECK(this != &dst);
+  if (!entity_manager_.CloneInto(dst.entity_manager_)) {
+    return false;
+  }
+  dst.change_tick_ = change_tick_;
+  return true;
+}
+
+bool World::SaveSnapshot(ByteWriter& writer) const {
+  return entity_manager_.SaveSnapshot(writer);
+}
+
+bool World::SaveSnapshot(const char* path) const {
+  ByteWriter writer;
+  return SaveSnapshot(writer) && writer.WriteToFile(path);
+}
+
+bool World::LoadSnapshot(ByteReader& reader,
+                         const ComponentRegistry& registry) {
+  EntityManager entity_manager;
+  entity_manager.set_change_tick(change_tick_);
+  if (!entity_manager.LoadSnapshot(reader, registry)) {
+    return false;
+  }
+  entity_manager_ = std::move(entity_manager);
+  return true;
+}
+
+bool World::LoadSnapshot(const char* path, const ComponentRegistry& registry) {
+  const auto file = MappedFile::Open(path);
+  if (!file.is_valid()) {
+    return false;
+  }
+  ByteReader reader(file.data(), file.size());
+  return LoadSnapshot(reader, registry);
+}
+
+Array<uint8_t> World::SaveSnapshotDelta(SnapshotBaseline& baseline) const {
+  ByteWriter writer;
+  if (!entity_manager_.SaveDelta(baseline, writer)) {
+    return {};
+  }
+  return writer.TakeBytes();
+}
+
+bool World::ApplySnapshotDelta(SnapshotBaseline& baseline, const uint8_t* delta,
+                               const size_t delta_size,
+                               const size_t max_entity_cnt,
+                               const ComponentRegistry& registry) {
+  ByteReader reader(delta, delta_size);
+  return entity_manager_.ApplyDelta(baseline, reader, max_entity_cnt,
+                                    registry);
+}
+
+ResourceBorrow* World::BorrowResource(const size_t index,
+                                      const bool is_write) {
+  auto* slot = resource_array_.TryGet(index);
+  if (!slot || !*slot || !(*slot)->resource.is_valid()) {
+    return nullptr;
+  }
+  auto& borrow = (*slot)->borrow;
+  MIRAGE_DCHECK((*slot)->is_send || is_main_thread());
+  [[maybe_unused]] const bool is_borrowed =
+      is_write ? borrow.TryBorrowWrite() : borrow.TryBorrowRead();
+  MIRAGE_DCHECK(is_borrowed);
+  return is_borrowed ? &borrow : nullptr;
+}
+
+bool World::is_main_thread() const {
+  return std::this_thread::get_id() == main_thread_id_;
+}
+
+size_t World::id() const { return id_; }
+
+size_t World::resource_version() const { return resource_version_; }
+
+World::ResourceSlot& World::GetResourceSlot(const size_t index) {
+  if (index >= resource_array_.size()) {
+    resource_array_.set_size(index + 1);
+  }
+  auto& slot = resource_array_[index];
+  if (!slot) {
+    slot = Owned<ResourceSlot>::New();
+  }
+  ++resource_version_;
+  return *slot;
+}
@@ -1,23 +1,42 @@
 #ifndef MIRAGE_ECS_FRAMEWORK_WORLD
 #define MIRAGE_ECS_FRAMEWORK_WORLD
 
+#include <thread>
+
+#include "mirage_base/auto_ptr/owned.hpp"
+#include "mirage_base/container/array.hpp"
+#include "mirage_base/define/check.hpp"
+#include "mirage_base/io/byte_stream.hpp"
 #include "mirage_base/util/type_id.hpp"
 #include "mirage_base/wrap/optional.hpp"
 #include "mirage_ecs/entity/entity_manager.hpp"
+#include "mirage_ecs/framework/plugin.hpp"
+#include "mirage_ecs/framework/resource_borrow.hpp"
 #include "mirage_ecs/util/marker.hpp"
+#include "mirage_ecs/util/tick.hpp"
 
 namespace mirage::ecs {
 
-class World {
-  using TypeId = base::TypeId;
+// Index of the resource type, allocated on first use. Every shared library
+// asking for the same type gets the same index.
+MIRAGE_ECS size_t AllocateResourceIndex(base::TypeId type_id);
+
+// Every resource type gets a dense index the first time it is used, so worlds
+// keep their resources in a flat array instead of a hash map. Lookups never
+// lock, resources just must not be added or replaced while systems run.
+template <IsResource T>
+size_t ResourceIndexOf() {
+  // Only a cache, each shared library may hold its own copy of it.
+  static const size_t index = AllocateResourceIndex(base::TypeId::Of<T>());
+  return index;
+}
 
+class World {
   template <typename T>
   using Optional = base::Optional<T>;
 
  public:
-  using ResourceMap = base::HashMap<TypeId, BoxResource>;
-
-  World() = default;
+  MIRAGE_ECS World();
   ~World() = default;
 
   template <IsResource T, typename... Args>
@@ -32,9 +51,77 @@ class World {
   template <IsResource T>
   T& GetResource();
 
+  template <IsPlugin T, typename... Args>
+  void AddPlugin(Args&&... args);
+
+  MIRAGE_ECS EntityManager& entity_manager();
+  [[nodiscard]] MIRAGE_ECS const EntityManager& entity_manager() const;
+
+  // Advance the world tick, usually once per frame. Component writes are
+  // stamped with the current tick for change detection.
+  MIRAGE_ECS Tick IncreaseChangeTick();
+  [[nodiscard]] MIRAGE_ECS Tick change_tick() const;
+
+  // Copy the entities and the change tick into `dst`, see
+  // `EntityManager::CloneInto`. Resources are not cloned, so state a rollback
+  // has to restore belongs in components.
+  MIRAGE_ECS bool CloneInto(World& dst) const;
+
+  // Write the entities to a snapshot, see `EntityManager::SaveSnapshot`.
+  // Resources are not part of it.
+  [[nodiscard]] MIRAGE_ECS bool SaveSnapshot(base::ByteWriter& writer) const;
+  [[nodiscard]] MIRAGE_ECS bool SaveSnapshot(const char* path) const;
+  // Replace the entities with a snapshot. A file at `path` is mapped instead
+  // of read. The world is left as it was on failure.
+  MIRAGE_ECS bool LoadSnapshot(base::ByteReader& reader,
+                               const ComponentRegistry& registry);
+  MIRAGE_ECS bool LoadSnapshot(const char* path,
+                               const ComponentRegistry& registry);
+
+  // Snapshot deltas for replication, see `EntityManager::SaveDelta`. Each
+  // end keeps a baseline of what the other holds, which saving and applying
+  // advance. Saving returns an empty array on failure, applying refuses
+  // deltas growing the entities past `max_entity_cnt` slots. A failed apply
+  // leaves the entities as they were, but replication has to restart from
+  // fresh baselines.
+  MIRAGE_ECS base::Array<uint8_t> SaveSnapshotDelta(
+      SnapshotBaseline& baseline) const;
+  MIRAGE_ECS bool ApplySnapshotDelta(SnapshotBaseline& baseline,
+                                     const uint8_t* delta, size_t delta_size,
+                                     size_t max_entity_cnt,
+                                     const ComponentRegistry& registry);
+
+  // Borrow a resource for a system, null if it does not exist. Fails a debug
+  // check if the borrow conflicts with a running system, or if a non-send
+  // resource is borrowed off the main thread.
+  MIRAGE_ECS ResourceBorrow* BorrowResource(size_t index, bool is_write);
+  [[nodiscard]] MIRAGE_ECS bool is_main_thread() const;
+
+  // Unique among the worlds of the process.
+  [[nodiscard]] MIRAGE_ECS size_t id() const;
+  // Changes whenever a resource is added or replaced. Resource pointers cached
+  // by systems are only valid for one version.
+  [[nodiscard]] MIRAGE_ECS size_t resource_version() const;
+
  private:
-  ResourceMap resource_map_;
+  struct ResourceSlot {
+    BoxResource resource;
+    ResourceBorrow borrow;
+    bool is_send{true};
+  };
+
+  template <IsResource T>
+  T& EmplaceResource(BoxResource&& resource);
+  MIRAGE_ECS ResourceSlot& GetResourceSlot(size_t index);
+
+  size_t id_;
+  std::thread::id main_thread_id_;
+  // Slots stay put while the array grows, so references to resources hold
+  // until they are replaced. Null for indices of other resource types.
+  base::Array<base::Owned<ResourceSlot>> resource_array_;
+  size_t resource_version_{0};
   EntityManager entity_manager_;
+  Tick change_tick_{kInitTick};
 };
 
 template <IsResource T, typename... Args>
@@ -44,31 +131,27 @@ T& World::InitResource(Args&&... args) {
     return *resource_ptr;
   }
 
-  resource_map_.Insert(TypeId::Of<T>(),
-                       BoxResource(T(std::forward<Args>(args)...)));
-  return *resource_ptr;
+  return EmplaceResource<T>(BoxResource(T(std::forward<Args>(args)...)));
 }
 
 template <IsResource T, typename... Args>
 base::Optional<T> World::SetResource(Args&&... args) {
-  Optional<base::HashKeyVal<TypeId, BoxResource>> optional_kv =
-      resource_map_.Insert(TypeId::Of<T>(),
-                           BoxResource(T(std::forward<Args>(args)...)));
-  if (optional_kv.is_valid()) {
+  auto old = std::move(GetResourceSlot(ResourceIndexOf<T>()).resource);
+  EmplaceResource<T>(BoxResource(T(std::forward<Args>(args)...)));
+  if (!old.is_valid()) {
     return Optional<T>::None();
   }
-  auto kv = optional_kv.Unwrap();
-  T* resource = static_cast<T*>(kv.val().raw_ptr());
-  return Optional<T>::New(std::move(*resource));
+  return Optional<T>::New(old.template Unwrap<T>());
 }
 
 template <IsResource T>
 T* World::TryGetResource() {
-  ResourceMap::Iterator iter = resource_map_.TryFind(TypeId::Of<T>());
-  if (iter == resource_map_.end()) {
+  auto* slot = resource_array_.TryGet(ResourceIndexOf<T>());
+  if (!slot || !*slot || !(*slot)->resource.is_valid()) {
     return nullptr;
   }
-  return static_cast<T*>(iter->val().raw_ptr());
+  MIRAGE_DCHECK((*slot)->is_send || is_main_thread());
+  return static_cast<T*>((*slot)->resource.raw_ptr());
 }
 
 template <IsResource T>
@@ -76,6 +159,21 @@ T& World::GetResource() {
   return *TryGetResource<T>();
 }
 
+template <IsResource T>
+T& World::EmplaceResource(BoxResource&& resource) {
+  auto& slot = GetResourceSlot(ResourceIndexOf<T>());
+  MIRAGE_DCHECK(slot.borrow.reader_cnt() == 0 && !slot.borrow.is_writing());
+  slot.resource = std::move(resource);
+  slot.is_send = IsSendResource<T>();
+  return *static_cast<T*>(slot.resource.raw_ptr());
+}
+
+template <IsPlugin T, typename... Args>
+void World::AddPlugin(Args&&... args) {
+  T plugin(std::forward<Args>(args)...);
+  plugin.Build(*this);
+}
+
 }  // namespace mirage::ecs
 
 #endif  // MIRAGE_ECS_FRAMEWORK_WORLD
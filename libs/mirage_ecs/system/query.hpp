@@ -40,8 +40,32 @@ struct Without : QueryParamsTag_Without {
   using TypeList = base::TypeList<Ts...>;
 };
 
+// --- Changed ---
+
+struct QueryParamsTag_Changed : QueryParamsTag {};
+
+template <IsComponent... Ts>
+struct Changed : QueryParamsTag_Changed {
+  using TypeList = base::TypeList<Ts...>;
+};
+
+// --- Added ---
+
+struct QueryParamsTag_Added : QueryParamsTag {};
+
+template <IsComponent... Ts>
+struct Added : QueryParamsTag_Added {
+  using TypeList = base::TypeList<Ts...>;
+};
+
 // ----------
 
+template <typename ParamsTag>
+  requires IsQueryParam<ParamsTag>
+consteval auto QueryParamsTypeList() {
+  return base::TypeList();
+}
+
 template <typename ParamsTag, typename T, typename... Ts>
   requires IsQueryParam<ParamsTag> && IsQueryParam<T> && IsQueryParam<Ts...>
 consteval auto QueryParamsTypeList() {
@@ -52,12 +76,6 @@ consteval auto QueryParamsTypeList() {
   }
 }
 
-template <typename ParamsTag>
-  requires IsQueryParam<ParamsTag>
-consteval auto QueryParamsTypeList() {
-  return base::TypeList();
-}
-
 template <typename... Ts>
   requires IsQueryParam<Ts...>
 class Query {
@@ -68,6 +86,12 @@ class Query {
       decltype(QueryParamsTypeList<QueryParamsTag_With, Ts...>());
   using WithoutTypeList =
       decltype(QueryParamsTypeList<QueryParamsTag_Without, Ts...>());
+  // Chunks are skipped unless `ArchetypeDataBuffer::IsColumnChanged` or
+  // `IsColumnAdded` holds for these since the last run of the system.
+  using ChangedTypeList =
+      decltype(QueryParamsTypeList<QueryParamsTag_Changed, Ts...>());
+  using AddedTypeList =
+      decltype(QueryParamsTypeList<QueryParamsTag_Added, Ts...>());
 
   class Iterator;
   class ConstIterator;
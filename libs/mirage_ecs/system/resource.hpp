@@ -17,14 +17,39 @@ struct SystemArgs_Res {};
 template <typename T>
 concept IsSystemArgs_Res = std::derived_from<T, SystemArgs_Res>;
 
+// A resource borrowed by a system, `Res<const T>` for shared reads and
+// `Res<T>` for exclusive writes. Debug builds track the borrow for its
+// lifetime, so it can't be copied.
 template <typename T>
-  requires IsResource<T>
+  requires IsResource<std::remove_const_t<T>>
 class Res : SystemArgs_Res {
  public:
   Res() = default;
-  ~Res() = default;
+  ~Res() { Release(); }
+
+  Res(const Res&) = delete;
+  Res& operator=(const Res&) = delete;
+
+  Res(Res&& other) noexcept : raw_ptr_(other.raw_ptr_) {
+#if defined(MIRAGE_BUILD_DEBUG)
+    borrow_ = other.borrow_;
+    other.borrow_ = nullptr;
+#endif
+  }
+
+  Res& operator=(Res&& other) noexcept {
+    if (this != &other) {
+      this->~Res();
+      new (this) Res(std::move(other));
+    }
+    return *this;
+  }
 
   explicit Res(T* raw_ptr) : raw_ptr_(raw_ptr) {}
+#if defined(MIRAGE_BUILD_DEBUG)
+  Res(T* raw_ptr, ResourceBorrow* borrow)
+      : raw_ptr_(raw_ptr), borrow_(borrow) {}
+#endif
 
   T& operator*() const { return *raw_ptr_; }
   T* operator->() const { return raw_ptr_; }
@@ -32,22 +57,51 @@ class Res : SystemArgs_Res {
   [[nodiscard]] T* raw_ptr() const { return raw_ptr_; }
 
  private:
-  T* raw_ptr_;
+  void Release() {
+#if defined(MIRAGE_BUILD_DEBUG)
+    if (borrow_ == nullptr) {
+      return;
+    }
+    if constexpr (std::is_const_v<T>) {
+      borrow_->ReleaseRead();
+    } else {
+      borrow_->ReleaseWrite();
+    }
+    borrow_ = nullptr;
+#endif
+  }
+
+  T* raw_ptr_{nullptr};
+#if defined(MIRAGE_BUILD_DEBUG)
+  ResourceBorrow* borrow_{nullptr};
+#endif
 };
 
 template <typename T>
-  requires IsResource<T>
+  requires IsResource<std::remove_const_t<T>>
 struct Extract<Res<T>> {
-  static Res<T> From(World& world,
-                     [[maybe_unused]] base::Owned<SystemContext>& context) {
-    T* raw_ptr = nullptr;
-    if constexpr (std::is_const_v<T>) {
-      raw_ptr = world.TryGetResource<std::remove_const<T>>();
-    } else {
-      raw_ptr = world.TryGetResource<T>();
+  using Resource = std::remove_const_t<T>;
+
+  static void DeclareAccess(SystemContext& context) {
+    context.AddResourceAccess(ResourceIndexOf<Resource>(),
+                              !std::is_const_v<T>,
+                              IsSendResource<Resource>());
+  }
+
+  static Res<T> From(World& world, base::Owned<SystemContext>& context) {
+    const auto index = ResourceIndexOf<Resource>();
+    void*& cached =
+        context->CachedResource(world.id(), world.resource_version(), index);
+    if (cached == nullptr) {
+      cached = world.TryGetResource<Resource>();
     }
-    MIRAGE_DCHECK(raw_ptr);
-    return Res<T>(raw_ptr);
+    MIRAGE_DCHECK(cached);
+#if defined(MIRAGE_BUILD_DEBUG)
+    return Res<T>(static_cast<T*>(cached),
+                  world.BorrowResource(index, !std::is_const_v<T>));
+#else
+    return Res<T>(static_cast<T*>(cached));
+#endif
   }
 };
 
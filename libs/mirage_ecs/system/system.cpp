@@ -1,14 +1,58 @@
 #include "mirage_ecs/system/system.hpp"
 
+#include <atomic>
+
 #include "mirage_base/define/check.hpp"
+#include "mirage_base/profile/profiler.hpp"
+#include "mirage_ecs/framework/system_stats.hpp"
+#include "mirage_ecs/framework/world.hpp"
 #include "mirage_ecs/system/system_context.hpp"
 
 using namespace mirage::ecs;
 
-void System::Run(World& world) { system_func_(world, context_); }
+namespace {
+
+std::atomic<size_t> next_system_id{0};
+
+}  // namespace
+
+void System::Run(World& world) {
+  MIRAGE_PROFILE_ZONE(name_);
+  // Only time the run when someone is collecting.
+  auto* stats = world.TryGetResource<SystemStats>();
+  context_->ResetRunCounters();
+  const uint64_t begin_ns = stats ? base::Profiler::Now() : 0;
+  if (!task_.is_pending()) {
+    task_ = system_func_(world, context_);
+  }
+  task_.Poll(world, context_);
+  if (stats) {
+    const auto& counters = context_->run_counters();
+    stats->Record(id_, name_,
+                  {.run_ns = base::Profiler::Now() - begin_ns,
+                   .entity_cnt = counters.entity_cnt,
+                   .chunk_cnt = counters.chunk_cnt,
+                   .structural_change_cnt = counters.structural_change_cnt});
+  }
+  // Systems running later in the same tick may still write, so only the
+  // previous tick is fully observed.
+  context_->set_last_run_tick(world.change_tick() - 1);
+}
+
+const SystemContext& System::context() const { return *context_; }
+
+const char* System::name() const { return name_; }
+
+size_t System::id() const { return id_; }
+
+bool System::is_pending() const { return task_.is_pending(); }
 
-System::System(SystemFunc&& system_func, base::Owned<SystemContext>&& context)
-    : system_func_(std::move(system_func)), context_(std::move(context)) {
+System::System(SystemFunc&& system_func, base::Owned<SystemContext>&& context,
+               const char* name)
+    : system_func_(std::move(system_func)),
+      context_(std::move(context)),
+      name_(name),
+      id_(next_system_id.fetch_add(1, std::memory_order_relaxed)) {
   MIRAGE_DCHECK(system_func_);
   MIRAGE_DCHECK(context_ != nullptr);
 }
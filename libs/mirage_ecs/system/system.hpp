@@ -6,9 +6,11 @@
 
 #include "mirage_base/auto_ptr/owned.hpp"
 #include "mirage_base/util/func_trait.hpp"
+#include "mirage_base/util/type_id.hpp"
 #include "mirage_ecs/define/export.hpp"
 #include "mirage_ecs/system/extract.hpp"
 #include "mirage_ecs/system/system_context.hpp"
+#include "mirage_ecs/system/system_task.hpp"
 
 namespace mirage::ecs {
 
@@ -26,15 +28,17 @@ consteval bool IsArgsExtractable(base::TypeList<Args...>) {
   }
 }
 
-// TODO: Coroutine system
+// Systems either return nothing, or are coroutines returning `SystemTask`
+// that may spread their work over several runs.
 template <typename Func>
-concept IsSystem = std::same_as<base::FuncReturnType<Func>, void> &&
+concept IsSystem = (std::same_as<base::FuncReturnType<Func>, void> ||
+                    std::same_as<base::FuncReturnType<Func>, SystemTask>) &&
                    IsArgsExtractable(base::FuncArgsTypeList<Func>());
 
 class System {
  public:
   using SystemFunc =
-      std::function<void(World&, base::Owned<SystemContext>& context)>;
+      std::function<SystemTask(World&, base::Owned<SystemContext>& context)>;
 
   System() = delete;
   MIRAGE_ECS ~System() = default;
@@ -51,16 +55,41 @@ class System {
                                     base::Owned<SystemContext>::New()) {
     using ArgsTypeList = base::FuncArgsTypeList<Func>;
     constexpr size_t kParamsCount = ArgsTypeList::size();
+    DeclareAccess(*context, ArgsTypeList());
     return System(EraseFuncSignature(std::move(func),
                                      std::make_index_sequence<kParamsCount>{}),
-                  std::move(context));
+                  std::move(context), base::TypeMeta::Of<Func>().type_name());
   }
 
+  // Call the system, or resume its pending task if what the task waits for
+  // is ready.
   MIRAGE_ECS void Run(World& world);
 
+  [[nodiscard]] MIRAGE_ECS const SystemContext& context() const;
+  // Name of the function type, which also names the profiler zone of `Run`.
+  [[nodiscard]] MIRAGE_ECS const char* name() const;
+  // Unique among the systems of the process, keys `SystemStats`.
+  [[nodiscard]] MIRAGE_ECS size_t id() const;
+  // Whether a coroutine system is suspended in the middle of a task.
+  [[nodiscard]] MIRAGE_ECS bool is_pending() const;
+
  private:
   MIRAGE_ECS System(SystemFunc&& system_func,
-                    base::Owned<SystemContext>&& context);
+                    base::Owned<SystemContext>&& context, const char* name);
+
+  // Every argument records what it touches, so a scheduler can tell which
+  // systems may run in parallel.
+  template <typename... Args>
+  static void DeclareAccess(SystemContext& context, base::TypeList<Args...>) {
+    (DeclareArgAccess<Args>(context), ...);
+  }
+
+  template <typename Arg>
+  static void DeclareArgAccess([[maybe_unused]] SystemContext& context) {
+    if constexpr (requires { Extract<Arg>::DeclareAccess(context); }) {
+      Extract<Arg>::DeclareAccess(context);
+    }
+  }
 
   template <typename Func, size_t... Index>
     requires IsSystem<Func>
@@ -70,13 +99,22 @@ class System {
     return [func = std::move(func)](
                [[maybe_unused]] World& world,
                [[maybe_unused]] base::Owned<SystemContext>& context) {
-      func(Extract<base::GetTypeFromList<ArgsTypeList, Index>>::From(
-          world, context)...);
+      if constexpr (std::same_as<base::FuncReturnType<Func>, void>) {
+        func(Extract<base::GetTypeFromList<ArgsTypeList, Index>>::From(
+            world, context)...);
+        return SystemTask();
+      } else {
+        return func(Extract<base::GetTypeFromList<ArgsTypeList, Index>>::From(
+            world, context)...);
+      }
     };
   }
 
   SystemFunc system_func_;
   base::Owned<SystemContext> context_;
+  SystemTask task_;
+  const char* name_;
+  size_t id_;
 };
 
 }  // namespace mirage::ecs
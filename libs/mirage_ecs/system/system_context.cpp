@@ -1,3 +1,78 @@
 #include "mirage_ecs/system/system_context.hpp"
 
+#include "mirage_base/define/check.hpp"
+
 using namespace mirage::ecs;
+
+bool SystemContext::ConflictWith(const SystemContext &other) const {
+  if (is_main_thread_only_ && other.is_main_thread_only_) {
+    return true;
+  }
+  for (const auto &access : resource_access_array_) {
+    for (const auto &other_access : other.resource_access_array_) {
+      if (access.index == other_access.index &&
+          (access.is_write || other_access.is_write)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void SystemContext::AddResourceAccess(const size_t resource_index,
+                                      const bool is_write,
+                                      const bool is_send) {
+  // A system taking the same resource twice must only read it.
+  for ([[maybe_unused]] const auto &access : resource_access_array_) {
+    MIRAGE_DCHECK(access.index != resource_index ||
+                  !(access.is_write || is_write));
+  }
+  resource_access_array_.Push({resource_index, is_write});
+  is_main_thread_only_ = is_main_thread_only_ || !is_send;
+}
+
+const mirage::base::Array<SystemContext::ResourceAccess> &
+SystemContext::resource_access_array() const {
+  return resource_access_array_;
+}
+
+bool SystemContext::is_main_thread_only() const { return is_main_thread_only_; }
+
+Tick SystemContext::last_run_tick() const { return last_run_tick_; }
+
+void SystemContext::set_last_run_tick(const Tick last_run_tick) {
+  last_run_tick_ = last_run_tick;
+}
+
+void *&SystemContext::CachedResource(const size_t world_id,
+                                     const size_t resource_version,
+                                     const size_t resource_index) {
+  if (world_id != cached_world_id_ ||
+      resource_version != cached_resource_version_) {
+    for (auto &ptr : resource_cache_) {
+      ptr = nullptr;
+    }
+    cached_world_id_ = world_id;
+    cached_resource_version_ = resource_version;
+  }
+  if (resource_index >= resource_cache_.size()) {
+    resource_cache_.set_size(resource_index + 1);
+  }
+  return resource_cache_[resource_index];
+}
+
+void SystemContext::CountIteration(const size_t entity_cnt,
+                                   const size_t chunk_cnt) {
+  run_counters_.entity_cnt += entity_cnt;
+  run_counters_.chunk_cnt += chunk_cnt;
+}
+
+void SystemContext::CountStructuralChange(const size_t cnt) {
+  run_counters_.structural_change_cnt += cnt;
+}
+
+const SystemContext::RunCounters &SystemContext::run_counters() const {
+  return run_counters_;
+}
+
+void SystemContext::ResetRunCounters() { run_counters_ = {}; }
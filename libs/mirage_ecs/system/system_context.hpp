@@ -4,6 +4,7 @@
 #include "mirage_base/container/array.hpp"
 #include "mirage_ecs/define/export.hpp"
 #include "mirage_ecs/entity/generation_id.hpp"
+#include "mirage_ecs/util/tick.hpp"
 
 namespace mirage::ecs {
 
@@ -12,10 +13,57 @@ class SystemContext {
   using Array = base::Array<T>;
 
  public:
+  struct ResourceAccess {
+    size_t index;
+    bool is_write;
+  };
+
+  // Work done by the current run. Query iterators count what they visit and
+  // commands count the structural changes they issue.
+  struct RunCounters {
+    size_t entity_cnt{0};
+    size_t chunk_cnt{0};
+    size_t structural_change_cnt{0};
+  };
+
+  // Two systems conflict if one writes a resource the other uses, or if both
+  // have to run on the main thread.
   [[nodiscard]] MIRAGE_ECS bool ConflictWith(const SystemContext &other) const;
 
+  MIRAGE_ECS void AddResourceAccess(size_t resource_index, bool is_write,
+                                    bool is_send);
+  [[nodiscard]] MIRAGE_ECS const Array<ResourceAccess> &resource_access_array()
+      const;
+  // Systems using non-send resources must run on the main thread.
+  [[nodiscard]] MIRAGE_ECS bool is_main_thread_only() const;
+
+  // The last tick fully observed by the system. Changes stamped after it are
+  // visible to `Changed` and `Added`.
+  [[nodiscard]] MIRAGE_ECS Tick last_run_tick() const;
+  MIRAGE_ECS void set_last_run_tick(Tick last_run_tick);
+
+  // Slot of the resource pointer resolved by a `Res` argument, null until it
+  // is filled. All slots are dropped when the system runs on another world or
+  // the resources of the world change.
+  MIRAGE_ECS void *&CachedResource(size_t world_id, size_t resource_version,
+                                   size_t resource_index);
+
+  MIRAGE_ECS void CountIteration(size_t entity_cnt, size_t chunk_cnt);
+  MIRAGE_ECS void CountStructuralChange(size_t cnt = 1);
+  [[nodiscard]] MIRAGE_ECS const RunCounters &run_counters() const;
+  MIRAGE_ECS void ResetRunCounters();
+
  private:
   Array<ArchetypeId> interested_archetype_array_;
+  Array<ResourceAccess> resource_access_array_;
+  bool is_main_thread_only_{false};
+  Tick last_run_tick_{kInitTick};
+
+  Array<void *> resource_cache_;
+  size_t cached_world_id_{SIZE_MAX};
+  size_t cached_resource_version_{0};
+
+  RunCounters run_counters_;
 };
 
 }  // namespace mirage::ecs
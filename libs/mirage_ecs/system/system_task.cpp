@@ -0,0 +1,87 @@
+#include "mirage_ecs/system/system_task.hpp"
+
+#include <new>
+#include <utility>
+
+#include "mirage_base/define/check.hpp"
+
+using namespace mirage;
+using namespace mirage::ecs;
+
+SystemTask::~SystemTask() {
+  if (handle_) {
+    handle_.destroy();
+  }
+}
+
+SystemTask::SystemTask(SystemTask&& other) noexcept
+    : handle_(std::exchange(other.handle_, nullptr)) {}
+
+SystemTask& SystemTask::operator=(SystemTask&& other) noexcept {
+  if (this != &other) {
+    this->~SystemTask();
+    new (this) SystemTask(std::move(other));
+  }
+  return *this;
+}
+
+bool SystemTask::Poll(World& world, base::Owned<SystemContext>& context) {
+  if (!handle_) {
+    return false;
+  }
+  auto& promise = handle_.promise();
+  if (!promise.IsReady(world)) {
+    return true;
+  }
+  promise.BindArgs(&world, &context);
+  promise.world_ = &world;
+  handle_.resume();
+  promise.world_ = nullptr;
+  if (handle_.done()) {
+    handle_.destroy();
+    handle_ = nullptr;
+    return false;
+  }
+  promise.BindArgs(nullptr, nullptr);
+  return true;
+}
+
+bool SystemTask::is_pending() const { return handle_ && !handle_.done(); }
+
+void SystemTask::promise_type::SuspendFor(size_t frame_cnt) {
+  frame_cnt_ = frame_cnt;
+}
+
+void SystemTask::promise_type::SuspendUntil(ReadyFunc&& ready_func) {
+  ready_func_ = std::move(ready_func);
+}
+
+World& SystemTask::promise_type::world() const {
+  MIRAGE_DCHECK(world_ != nullptr);
+  return *world_;
+}
+
+bool SystemTask::promise_type::IsReady(World& world) {
+  if (frame_cnt_ > 0 && --frame_cnt_ > 0) {
+    return false;
+  }
+  if (ready_func_) {
+    if (!ready_func_(world)) {
+      return false;
+    }
+    ready_func_ = nullptr;
+  }
+  return true;
+}
+
+void SystemTask::promise_type::BindArgs(World* world,
+                                        base::Owned<SystemContext>* context) {
+  const bool is_bound = world != nullptr;
+  if (is_bound_ == is_bound) {
+    return;
+  }
+  if (bind_args_) {
+    bind_args_(world, context);
+  }
+  is_bound_ = is_bound;
+}
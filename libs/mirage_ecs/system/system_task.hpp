@@ -0,0 +1,169 @@
+#ifndef MIRAGE_ECS_SYSTEM_SYSTEM_TASK
+#define MIRAGE_ECS_SYSTEM_SYSTEM_TASK
+
+#include <chrono>
+#include <coroutine>
+#include <functional>
+#include <future>
+#include <type_traits>
+
+#include "mirage_base/auto_ptr/owned.hpp"
+#include "mirage_ecs/define/export.hpp"
+#include "mirage_ecs/system/extract.hpp"
+
+namespace mirage::ecs {
+
+class World;
+class SystemContext;
+
+// Return type of a coroutine system, which may suspend and pick up again in a
+// later run of its `System`. Only one task of a system is in flight at a time,
+// and a new one starts on the run after it finishes.
+//
+// Arguments are rebound on every resume: they are released while the task is
+// suspended and extracted again before it continues, so borrows don't span
+// frames and resource pointers are as fresh as those of a plain system. They
+// can't be declared const for that reason.
+class SystemTask {
+ public:
+  class promise_type;
+
+  SystemTask() = default;
+  MIRAGE_ECS ~SystemTask();
+
+  SystemTask(const SystemTask&) = delete;
+  SystemTask& operator=(const SystemTask&) = delete;
+
+  MIRAGE_ECS SystemTask(SystemTask&& other) noexcept;
+  MIRAGE_ECS SystemTask& operator=(SystemTask&& other) noexcept;
+
+  // Resume the task if what it waits for is ready, until it suspends again or
+  // finishes. Returns whether it is still pending.
+  MIRAGE_ECS bool Poll(World& world, base::Owned<SystemContext>& context);
+
+  [[nodiscard]] MIRAGE_ECS bool is_pending() const;
+
+ private:
+  using Handle = std::coroutine_handle<promise_type>;
+
+  explicit SystemTask(Handle handle) : handle_(handle) {}
+
+  Handle handle_;
+};
+
+class SystemTask::promise_type {
+ public:
+  using ReadyFunc = std::function<bool(World&)>;
+
+  promise_type() = default;
+
+  // The parameters are the copies living in the coroutine frame.
+  template <typename... Args>
+  explicit promise_type(Args&... args)
+      : bind_args_([&args...](World* world,
+                              base::Owned<SystemContext>* context) {
+          (BindArg(args, world, context), ...);
+        }) {}
+
+  SystemTask get_return_object() {
+    return SystemTask(Handle::from_promise(*this));
+  }
+  // The first resume comes from `Poll`, which knows the world.
+  std::suspend_always initial_suspend() noexcept { return {}; }
+  std::suspend_always final_suspend() noexcept { return {}; }
+  void return_void() {}
+  void unhandled_exception() { std::terminate(); }
+
+  // Wait for `frame_cnt` more runs of the system.
+  MIRAGE_ECS void SuspendFor(size_t frame_cnt);
+  // Wait for the first run where `ready_func` holds.
+  MIRAGE_ECS void SuspendUntil(ReadyFunc&& ready_func);
+
+  // The world the task runs on, valid while it runs.
+  [[nodiscard]] MIRAGE_ECS World& world() const;
+
+ private:
+  friend class SystemTask;
+
+  template <typename Arg>
+  static void BindArg(Arg& arg, World* world,
+                      base::Owned<SystemContext>* context) {
+    static_assert(!std::is_const_v<Arg>,
+                  "Arguments of a coroutine system are rebound on resume");
+    // Release the old borrow before taking the new one.
+    arg = Arg();
+    if (world != nullptr) {
+      arg = Extract<Arg>::From(*world, *context);
+    }
+  }
+
+  [[nodiscard]] bool IsReady(World& world);
+  void BindArgs(World* world, base::Owned<SystemContext>* context);
+
+  std::function<void(World*, base::Owned<SystemContext>*)> bind_args_;
+  bool is_bound_{true};
+  World* world_{nullptr};
+  size_t frame_cnt_{0};
+  ReadyFunc ready_func_;
+};
+
+// `co_await NextFrame()` continues in the next run of the system.
+struct WaitFrames {
+  explicit WaitFrames(size_t frame_cnt) : frame_cnt(frame_cnt) {}
+
+  [[nodiscard]] bool await_ready() const { return frame_cnt == 0; }
+  void await_suspend(std::coroutine_handle<SystemTask::promise_type> handle) {
+    handle.promise().SuspendFor(frame_cnt);
+  }
+  void await_resume() {}
+
+  size_t frame_cnt;
+};
+
+struct NextFrame : WaitFrames {
+  NextFrame() : WaitFrames(1) {}
+};
+
+// Continues once `ready_func(world)` holds, in the same run if it already
+// does.
+struct WaitUntil {
+  explicit WaitUntil(SystemTask::promise_type::ReadyFunc ready_func)
+      : ready_func(std::move(ready_func)) {}
+
+  [[nodiscard]] bool await_ready() const { return false; }
+  bool await_suspend(std::coroutine_handle<SystemTask::promise_type> handle) {
+    auto& promise = handle.promise();
+    if (ready_func(promise.world())) {
+      return false;
+    }
+    promise.SuspendUntil(std::move(ready_func));
+    return true;
+  }
+  void await_resume() {}
+
+  SystemTask::promise_type::ReadyFunc ready_func;
+};
+
+// Continues with the result of work running elsewhere, e.g. a path search
+// started with `std::async`, once it is done.
+template <typename T>
+struct WaitFuture {
+  explicit WaitFuture(std::future<T>&& future) : future(std::move(future)) {}
+
+  [[nodiscard]] bool await_ready() const { return IsDone(); }
+  void await_suspend(std::coroutine_handle<SystemTask::promise_type> handle) {
+    handle.promise().SuspendUntil([this](World&) { return IsDone(); });
+  }
+  T await_resume() { return future.get(); }
+
+  [[nodiscard]] bool IsDone() const {
+    return future.wait_for(std::chrono::seconds(0)) ==
+           std::future_status::ready;
+  }
+
+  std::future<T> future;
+};
+
+}  // namespace mirage::ecs
+
+#endif  // MIRAGE_ECS_SYSTEM_SYSTEM_TASK
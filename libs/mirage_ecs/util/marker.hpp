@@ -10,11 +10,37 @@
 #define MIRAGE_RESOURCE \
   [[maybe_unused]] static constexpr bool mirage_ecs_is_resource = true
 
+// The resource may only be used on the thread that created the world, e.g.
+// because it wraps a window or a graphics context.
+#define MIRAGE_NON_SEND \
+  [[maybe_unused]] static constexpr bool mirage_ecs_is_send = false
+
+// Store the component in a per-type sparse set instead of archetype tables.
+// Adding or removing it does not move the rest of the entity, which suits
+// components that are toggled often.
+#define MIRAGE_SPARSE_SET_STORAGE                              \
+  [[maybe_unused]] static constexpr ::mirage::ecs::StorageType \
+      mirage_ecs_storage_type = ::mirage::ecs::StorageType::kSparseSet
+
 namespace mirage::ecs {
 
 template <typename T>
 concept IsComponent = T::mirage_ecs_is_component && std::move_constructible<T>;
 
+enum class StorageType {
+  kTable,
+  kSparseSet,
+};
+
+template <IsComponent T>
+consteval StorageType StorageTypeOf() {
+  if constexpr (requires { T::mirage_ecs_storage_type; }) {
+    return T::mirage_ecs_storage_type;
+  } else {
+    return StorageType::kTable;
+  }
+}
+
 template <typename T>
 concept IsComponentRef =
     std::is_reference_v<T> && IsComponent<std::remove_reference_t<T>>;
@@ -22,7 +48,9 @@ concept IsComponentRef =
 template <typename T>
 struct ComponentConstraint : std::bool_constant<IsComponent<T>> {};
 
-using BoxComponent = base::Box<ComponentConstraint>;
+// Components are moved around a lot while bundling, so most of them should fit
+// in place.
+using BoxComponent = base::Box<ComponentConstraint, 64>;
 
 template <typename T>
 concept IsResource = T::mirage_ecs_is_resource && std::move_constructible<T>;
@@ -32,6 +60,15 @@ struct ResourceConstraint : std::bool_constant<IsResource<T>> {};
 
 using BoxResource = base::Box<ResourceConstraint>;
 
+template <IsResource T>
+consteval bool IsSendResource() {
+  if constexpr (requires { T::mirage_ecs_is_send; }) {
+    return T::mirage_ecs_is_send;
+  } else {
+    return true;
+  }
+}
+
 }  // namespace mirage::ecs
 
 #endif  // MIRAGE_ECS_UTIL_MARKER
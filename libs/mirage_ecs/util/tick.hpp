@@ -0,0 +1,58 @@
+#ifndef MIRAGE_ECS_UTIL_TICK
+#define MIRAGE_ECS_UTIL_TICK
+
+#include <cstdint>
+
+#include "mirage_ecs/define/export.hpp"
+
+namespace mirage::ecs {
+
+// World-wide change counter. 64 bits wide, so wrapping around is not a concern.
+using Tick = uint64_t;
+constexpr static inline Tick kInitTick = 0;
+
+class MIRAGE_ECS ComponentTicks {
+ public:
+  ComponentTicks() = default;
+  ~ComponentTicks() = default;
+
+  ComponentTicks(const ComponentTicks &) = default;
+  ComponentTicks &operator=(const ComponentTicks &) = default;
+
+  void MarkAdded(const Tick tick) {
+    added_tick_ = tick;
+    changed_tick_ = tick;
+  }
+
+  void MarkChanged(const Tick tick) {
+    if (tick > changed_tick_) {
+      changed_tick_ = tick;
+    }
+  }
+
+  void Merge(const ComponentTicks &other) {
+    if (other.added_tick_ > added_tick_) {
+      added_tick_ = other.added_tick_;
+    }
+    MarkChanged(other.changed_tick_);
+  }
+
+  [[nodiscard]] bool IsAdded(const Tick last_run_tick) const {
+    return added_tick_ > last_run_tick;
+  }
+
+  [[nodiscard]] bool IsChanged(const Tick last_run_tick) const {
+    return changed_tick_ > last_run_tick;
+  }
+
+  [[nodiscard]] Tick added_tick() const { return added_tick_; }
+  [[nodiscard]] Tick changed_tick() const { return changed_tick_; }
+
+ private:
+  Tick added_tick_{kInitTick};
+  Tick changed_tick_{kInitTick};
+};
+
+}  // namespace mirage::ecs
+
+#endif  // MIRAGE_ECS_UTIL_TICK
@@ -69,6 +69,7 @@ bool TypeSet::With(const TypeSet& set) const {
 
   auto set_type_iter = set_type_array.begin();
   for (const auto& type_id : type_array_) {
+    if (set_type_iter == set_type_array.end()) return true;
     const auto& set_type_id = *set_type_iter;
     if (type_id == set_type_id) ++set_type_iter;
     if (type_id > set_type_id) return false;
@@ -102,7 +103,7 @@ bool TypeSet::Without(const TypeSet& set) const {
 
 bool TypeSet::Without(const TypeId& type_id) const { return !With(type_id); }
 
-const base::Array<base::TypeId>& TypeSet::type_array() const {
+const TypeSet::TypeArray& TypeSet::type_array() const {
   return type_array_;
 }
 
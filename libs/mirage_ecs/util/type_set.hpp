@@ -1,7 +1,7 @@
 #ifndef MIRAGE_ECS_UTIL_TYPE_SET
 #define MIRAGE_ECS_UTIL_TYPE_SET
 
-#include "mirage_base/container/array.hpp"
+#include "mirage_base/container/inline_array.hpp"
 #include "mirage_base/util/type_id.hpp"
 #include "mirage_ecs/define/export.hpp"
 
@@ -12,6 +12,11 @@ class TypeSet {
  public:
   using TypeId = base::TypeId;
 
+  // Most archetypes have a handful of components, so their type sets never
+  // touch the heap.
+  constexpr static size_t kInlineCapacity = 8;
+  using TypeArray = base::InlineArray<TypeId, kInlineCapacity>;
+
   MIRAGE_ECS TypeSet() = default;
   MIRAGE_ECS ~TypeSet() = default;
 
@@ -42,7 +47,7 @@ class TypeSet {
   [[nodiscard]] MIRAGE_ECS bool Without(const TypeSet &set) const;
   [[nodiscard]] MIRAGE_ECS bool Without(const TypeId &type_id) const;
 
-  [[nodiscard]] MIRAGE_ECS const base::Array<TypeId> &type_array() const;
+  [[nodiscard]] MIRAGE_ECS const TypeArray &type_array() const;
   [[nodiscard]] MIRAGE_ECS size_t mask() const;
 
   [[nodiscard]] MIRAGE_ECS size_t size() const;
@@ -50,7 +55,7 @@ class TypeSet {
   MIRAGE_ECS bool operator==(const TypeSet &other) const;
 
  private:
-  base::Array<TypeId> type_array_{};
+  TypeArray type_array_{};
   size_t mask_{0};
 };
 
@@ -25,6 +25,17 @@ struct Derive final : Base {
   ~Derive() override { *derive_destructed += 1; }
 };
 
+struct Other {
+  virtual ~Other() = default;
+
+  int32_t other{0};
+};
+
+// `Base` is not at the start of it.
+struct Multi final : Other, Base {
+  using Base::Base;
+};
+
 }  // namespace
 
 TEST(ObservedTests, LocalConstruct) {
@@ -306,3 +317,39 @@ TEST(ObservedTests, AsyncConvertBaseToDerive) {
   EXPECT_EQ(base_destructed, 0);
   EXPECT_EQ(derive_destructed, 0);
 }
+
+TEST(ObservedTests, ConvertToOffsetBase) {
+  int32_t base_destructed = 0;
+  auto local = ObservedLocal<Multi>::New(&base_destructed);
+  Multi* raw_ptr = local.raw_ptr();
+  auto local_observer = local.NewObserver().Convert<Base>();
+  EXPECT_EQ(local_observer.raw_ptr(), static_cast<Base*>(raw_ptr));
+  ObservedLocal<Base> local_base = std::move(local).TryConvert<Base>();
+  EXPECT_EQ(local_base.raw_ptr(), static_cast<Base*>(raw_ptr));
+
+  auto async = ObservedAsync<Multi>::New(&base_destructed);
+  raw_ptr = async.raw_ptr();
+  auto async_observer = async.NewObserver().TryConvert<Base>();
+  EXPECT_EQ(async_observer.Clone().raw_ptr(), static_cast<Base*>(raw_ptr));
+  ObservedAsync<Base> async_base = std::move(async).Convert<Base>();
+  EXPECT_EQ(&*async_base.Read(), static_cast<Base*>(raw_ptr));
+}
+
+TEST(ObservedTests, AsyncWriteExclusive) {
+  auto observed = ObservedAsync<int32_t>::New(0);
+  auto observer = observed.NewObserver();
+
+  auto async_operation = [&observer] {
+    for (int32_t i = 0; i < 1e4; ++i) {
+      *observer.Write().Unwrap() += 1;
+    }
+  };
+  std::thread async_thread(async_operation);
+  async_operation();
+  async_thread.join();
+  EXPECT_EQ(*observed.Read(), 2e4);
+
+  observed.Reset();
+  EXPECT_FALSE(observer.Read().is_valid());
+  EXPECT_FALSE(observer.Write().is_valid());
+}
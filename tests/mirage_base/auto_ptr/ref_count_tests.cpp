@@ -14,7 +14,7 @@ TEST(RefCountTests, Construct) {
 }
 
 TEST(RefCountTests, ZeroCountBehaviour) {
-  auto checker = [](RefCount* count) {
+  auto checker = [](auto* count) {
     count->TryRelease();
 
     const bool increase = count->TryIncrease();
@@ -34,7 +34,7 @@ TEST(RefCountTests, ZeroCountBehaviour) {
 }
 
 TEST(RefCountTests, ResetBehaviour) {
-  auto checker = [](RefCount* count) {
+  auto checker = [](auto* count) {
     const bool increase = count->TryIncrease();
     EXPECT_TRUE(increase);
     EXPECT_EQ(count->cnt(), 2);
@@ -56,7 +56,7 @@ TEST(RefCountTests, ResetBehaviour) {
 }
 
 TEST(RefCountTests, Increase) {
-  auto checker = [](RefCount* count) {
+  auto checker = [](auto* count) {
     bool rv = count->TryIncrease();
     EXPECT_FALSE(rv);
     EXPECT_EQ(count->cnt(), 0);
@@ -26,6 +26,29 @@ struct Derive final : Base {
   ~Derive() override { *derive_destructed += 1; }
 };
 
+struct Other {
+  virtual ~Other() = default;
+
+  int32_t other{0};
+};
+
+// `Base` is not at the start of it.
+struct Multi final : Other, Base {
+  using Base::Base;
+};
+
+struct Counted : RefCounted<RefCountAsync> {
+  int32_t* destructed{nullptr};
+
+  explicit Counted(int32_t* destructed) : destructed(destructed) {}
+
+  virtual ~Counted() { *destructed += 1; }
+};
+
+struct CountedDerive final : Counted {
+  using Counted::Counted;
+};
+
 }  // namespace
 
 TEST(SharedTests, Construct) {
@@ -128,3 +151,48 @@ TEST(SharedTests, ConvertBaseToDerive) {
   EXPECT_EQ(base_destructed, 0);
   EXPECT_EQ(derive_destructed, 0);
 }
+
+TEST(SharedTests, ConvertToOffsetBase) {
+  int32_t base_destructed = 0;
+  auto multi = SharedLocal<Multi>::New(&base_destructed);
+  Multi* raw_ptr = multi.raw_ptr();
+  ASSERT_NE(static_cast<void*>(static_cast<Base*>(raw_ptr)),
+            static_cast<void*>(raw_ptr));
+
+  SharedLocal<Base> base = std::move(multi).Convert<Base>();
+  EXPECT_EQ(base.raw_ptr(), static_cast<Base*>(raw_ptr));
+  const SharedLocal<Base> clone = base.Clone();
+  EXPECT_EQ(clone.raw_ptr(), static_cast<Base*>(raw_ptr));
+
+  SharedLocal<Other> other = base.TryConvert<Other>();
+  EXPECT_EQ(other.raw_ptr(), static_cast<Other*>(raw_ptr));
+  multi = other.TryConvert<Multi>();
+  EXPECT_EQ(multi.raw_ptr(), raw_ptr);
+  EXPECT_EQ(multi.ref_cnt(), 2);
+}
+
+TEST(SharedTests, Footprint) {
+  // Non-intrusive handles keep the block and the object.
+  EXPECT_EQ(sizeof(SharedLocal<Base>), 2 * sizeof(void*));
+  EXPECT_EQ(sizeof(SharedAsync<Base>), 2 * sizeof(void*));
+  EXPECT_EQ(sizeof(SharedAsync<Counted>), sizeof(void*));
+}
+
+TEST(SharedTests, Intrusive) {
+  int32_t destructed = 0;
+  auto derive = SharedAsync<CountedDerive>::New(&destructed);
+  EXPECT_EQ(derive.ref_cnt(), 1);
+
+  // A raw pointer to a counted object can be shared again.
+  SharedAsync<CountedDerive> again(derive.raw_ptr());
+  EXPECT_EQ(derive->ref_cnt(), 2);
+
+  SharedAsync<Counted> base = std::move(derive).Convert<Counted>();
+  again = base.TryConvert<CountedDerive>();
+  EXPECT_TRUE(base.is_null());
+  EXPECT_EQ(again.ref_cnt(), 1);
+  EXPECT_EQ(destructed, 0);
+
+  again.Reset();
+  EXPECT_EQ(destructed, 1);
+}
@@ -25,6 +25,17 @@ struct Derive final : Base {
   ~Derive() override { *derive_destructed += 1; }
 };
 
+struct Other {
+  virtual ~Other() = default;
+
+  int32_t other{0};
+};
+
+// `Base` is not at the start of it.
+struct Multi final : Other, Base {
+  using Base::Base;
+};
+
 }  // namespace
 
 TEST(WeakTests, Construct) {
@@ -132,3 +143,18 @@ TEST(WeakTests, ConvertBaseToDerive) {
   EXPECT_FALSE(derive.is_null());
   EXPECT_TRUE(base_from_derive.is_null());  // NOLINT: Use after move.
 }
+
+TEST(WeakTests, ConvertToOffsetBase) {
+  int32_t base_destructed = 0;
+  auto multi_shared = SharedLocal<Multi>::New(&base_destructed);
+  Multi* raw_ptr = multi_shared.raw_ptr();
+
+  auto multi = WeakLocal<Multi>(multi_shared);
+  WeakLocal<Base> base = std::move(multi).Convert<Base>();
+  EXPECT_EQ(base.raw_ptr(), static_cast<Base*>(raw_ptr));
+  EXPECT_EQ(base.TryUpgrade().raw_ptr(), static_cast<Base*>(raw_ptr));
+
+  WeakLocal<Other> other = std::move(base).TryConvert<Other>();
+  EXPECT_EQ(other.raw_ptr(), static_cast<Other*>(raw_ptr));
+  EXPECT_EQ(other.Clone().raw_ptr(), static_cast<Other*>(raw_ptr));
+}
@@ -32,6 +32,20 @@ TEST(ArrayTests, Construct) {
   EXPECT_EQ(move_array, copy_array);
 }
 
+TEST(ArrayTests, CopyAssign) {
+  const Array<int32_t> array = {0, 1, 2};
+  Array<int32_t> copy_array = {3, 4, 5, 6};
+  const auto* raw_ptr = copy_array.data();
+  // Storage that is large enough is kept.
+  copy_array = array;
+  EXPECT_EQ(copy_array, array);
+  EXPECT_EQ(copy_array.data(), raw_ptr);
+
+  Array<int32_t> small_array = {7};
+  small_array = copy_array;
+  EXPECT_EQ(small_array, array);
+}
+
 TEST(ArrayTests, DestructAfterMoved) {
   int32_t destruct_cnt = 0;
   {
@@ -160,3 +174,38 @@ TEST(ArrayTests, Swap) {
   expect_array = {1, 0, 2};
   EXPECT_EQ(array, expect_array);
 }
+
+TEST(ArrayTests, RelocateNonTrivial) {
+  EXPECT_TRUE(kIsTriviallyRelocatable<int32_t>);
+  EXPECT_FALSE(kIsTriviallyRelocatable<Owned<Counter>>);
+
+  int32_t destruct_cnt = 0;
+  {
+    Array<Owned<Counter>> array;
+    for (int32_t i = 0; i < 5; ++i) {
+      array.Insert(0, Owned<Counter>::New(&destruct_cnt));
+    }
+    array.Remove(2);
+    EXPECT_EQ(destruct_cnt, 1);
+    EXPECT_EQ(array.size(), 4);
+    for (const auto& counter : array) {
+      EXPECT_FALSE(counter.is_null());
+    }
+  }
+  EXPECT_EQ(destruct_cnt, 5);
+}
+
+TEST(ArrayTests, ReserveAndResizeUninitialized) {
+  Array<int32_t> array;
+  array.ReserveExact(3);
+  EXPECT_EQ(array.capacity(), 3);
+  array.Reserve(4);
+  EXPECT_EQ(array.capacity(), 6);
+
+  array.ResizeUninitialized(5);
+  EXPECT_EQ(array.size(), 5);
+  for (int32_t i = 0; i < 5; ++i) {
+    array.data()[i] = i;
+  }
+  EXPECT_EQ(array, (Array<int32_t>{0, 1, 2, 3, 4}));
+}
@@ -33,6 +33,20 @@ TEST(HashSetTests, ExtendAndRehash) {
   EXPECT_EQ(set.GetBucketSize(), 64);
 }
 
+TEST(HashSetTests, RehashSplitsBucket) {
+  HashSet<int32_t> set;
+  // All four share a bucket; 48 and 16 move out of it, neither at the head.
+  for (const int32_t val : {16, 0, 48, 32}) {
+    set.Insert(val);
+  }
+  set.SetMaxLoadFactor(0.1f);
+  EXPECT_EQ(set.GetBucketSize(), 32);
+  EXPECT_EQ(set.size(), 4);
+  for (const int32_t val : {0, 16, 32, 48}) {
+    EXPECT_NE(set.TryFind(val), set.end());
+  }
+}
+
 struct Mark {
   int32_t val;
   int32_t mark;
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include "mirage_base/auto_ptr/owned.hpp"
+#include "mirage_base/container/inline_array.hpp"
+
+using namespace mirage::base;
+
+namespace {
+
+struct Counter final {
+  int32_t* base_destructed{nullptr};
+
+  explicit Counter(int32_t* base_destructed)
+      : base_destructed(base_destructed) {}
+
+  ~Counter() { *base_destructed += 1; }
+};
+
+}  // namespace
+
+TEST(InlineArrayTests, SpillAndShrink) {
+  InlineArray<int32_t, 4> array = {0, 1, 2};
+  EXPECT_TRUE(array.is_inline());
+  EXPECT_EQ(array.capacity(), 4);
+
+  array.Push(3);
+  EXPECT_TRUE(array.is_inline());
+  array.Push(4);
+  EXPECT_FALSE(array.is_inline());
+  EXPECT_EQ(array.size(), 5);
+  EXPECT_EQ(array.capacity(), 8);
+  for (int32_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(array[i], i);
+  }
+
+  array.Remove(0);
+  array.ShrinkToFit();
+  EXPECT_TRUE(array.is_inline());
+  EXPECT_EQ(array.capacity(), 4);
+  EXPECT_EQ(array, (InlineArray<int32_t, 4>{1, 2, 3, 4}));
+
+  array.Insert(0, 0);
+  EXPECT_FALSE(array.is_inline());
+  EXPECT_EQ(array[0], 0);
+  EXPECT_EQ(array.Tail(), 4);
+}
+
+TEST(InlineArrayTests, Move) {
+  InlineArray<int32_t, 2> inline_array = {0, 1};
+  const InlineArray<int32_t, 2> inline_moved(std::move(inline_array));
+  EXPECT_TRUE(inline_array.empty());  // NOLINT(*-use-after-move)
+  EXPECT_TRUE(inline_moved.is_inline());
+  EXPECT_EQ(inline_moved, (InlineArray<int32_t, 2>{0, 1}));
+
+  InlineArray<int32_t, 2> heap_array = {0, 1, 2};
+  const int32_t* raw_ptr = heap_array.data();
+  const InlineArray<int32_t, 2> heap_moved(std::move(heap_array));
+  EXPECT_TRUE(heap_array.is_inline());  // NOLINT(*-use-after-move)
+  EXPECT_EQ(heap_moved.data(), raw_ptr);
+  EXPECT_EQ(heap_moved.size(), 3);
+}
+
+TEST(InlineArrayTests, Destruct) {
+  int32_t destruct_cnt = 0;
+  {
+    InlineArray<Owned<Counter>, 2> src;
+    src.Emplace(Owned<Counter>::New(&destruct_cnt));
+    InlineArray<Owned<Counter>, 2> dst(std::move(src));
+    dst.Emplace(Owned<Counter>::New(&destruct_cnt));
+    dst.Emplace(Owned<Counter>::New(&destruct_cnt));
+    EXPECT_EQ(destruct_cnt, 0);
+    dst.RemoveTail();
+    EXPECT_EQ(destruct_cnt, 1);
+  }
+  EXPECT_EQ(destruct_cnt, 3);
+}
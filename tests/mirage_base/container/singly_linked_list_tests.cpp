@@ -95,6 +95,16 @@ TEST(SinglyLinkedListTests, Remove) {
   EXPECT_EQ(list.begin(), list.end());
 }
 
+TEST(SinglyLinkedListTests, RemoveAfterKeepsTail) {
+  SinglyLinkedList<int32_t> list = {0, 1, 2};
+  EXPECT_EQ(list.begin().RemoveAfter(), 1);
+
+  auto iter = list.begin();
+  EXPECT_EQ(*iter, 0);
+  EXPECT_EQ(*++iter, 2);
+  EXPECT_EQ(++iter, list.end());
+}
+
 TEST(SinglyLinkedListTests, MoveAndCopy) {
   SinglyLinkedList<int32_t> list = {0, 1};
   SinglyLinkedList<int32_t> move_list(std::move(list));
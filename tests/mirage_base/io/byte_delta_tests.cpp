@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_base/io/byte_delta.hpp"
+
+using namespace mirage::base;
+
+namespace {
+
+constexpr size_t kMaxSize = 1 << 20;
+
+Array<uint8_t> MakeBytes(const size_t size, const uint8_t seed) {
+  Array<uint8_t> bytes;
+  for (size_t i = 0; i < size; ++i) {
+    bytes.Push(static_cast<uint8_t>(i * 31 + seed));
+  }
+  return bytes;
+}
+
+bool IsEqual(const Array<uint8_t>& lhs, const Array<uint8_t>& rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    if (lhs[i] != rhs[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST(ByteDeltaTests, RoundTrip) {
+  const auto base = MakeBytes(4096, 0);
+  auto target = MakeBytes(4096, 0);
+  target[100] = 0xff;
+  target[101] = 0xfe;
+  target[3000] ^= 1;
+
+  const auto delta =
+      ByteDelta::Encode(base.data(), base.size(), target.data(), target.size());
+  // Two short literals on top of the header.
+  EXPECT_LT(delta.size(), 64);
+  Array<uint8_t> applied;
+  ASSERT_TRUE(ByteDelta::Apply(base.data(), base.size(), delta.data(),
+                               delta.size(), kMaxSize, applied));
+  EXPECT_TRUE(IsEqual(applied, target));
+}
+
+TEST(ByteDeltaTests, Resize) {
+  const auto base = MakeBytes(100, 0);
+  Array<uint8_t> applied;
+  for (const size_t size : {0, 50, 100, 300}) {
+    const auto target = MakeBytes(size, 7);
+    const auto delta = ByteDelta::Encode(base.data(), base.size(),
+                                         target.data(), target.size());
+    ASSERT_TRUE(ByteDelta::Apply(base.data(), base.size(), delta.data(),
+                                 delta.size(), kMaxSize, applied));
+    EXPECT_TRUE(IsEqual(applied, target));
+  }
+  // An empty base works like a plain copy.
+  const auto delta =
+      ByteDelta::Encode(nullptr, 0, base.data(), base.size());
+  ASSERT_TRUE(ByteDelta::Apply(nullptr, 0, delta.data(), delta.size(),
+                               kMaxSize, applied));
+  EXPECT_TRUE(IsEqual(applied, base));
+}
+
+TEST(ByteDeltaTests, WrongBase) {
+  const auto base = MakeBytes(256, 0);
+  const auto other = MakeBytes(256, 1);
+  const auto target = MakeBytes(256, 2);
+  auto delta =
+      ByteDelta::Encode(base.data(), base.size(), target.data(), target.size());
+  Array<uint8_t> applied;
+  EXPECT_FALSE(ByteDelta::Apply(other.data(), other.size(), delta.data(),
+                                delta.size(), kMaxSize, applied));
+  EXPECT_FALSE(ByteDelta::Apply(base.data(), base.size(), delta.data(),
+                                delta.size() - 1, kMaxSize, applied));
+}
+
+TEST(ByteDeltaTests, MaxTargetSize) {
+  const auto base = MakeBytes(64, 0);
+  const auto target = MakeBytes(256, 0);
+  const auto delta =
+      ByteDelta::Encode(base.data(), base.size(), target.data(), target.size());
+  Array<uint8_t> applied;
+  EXPECT_FALSE(ByteDelta::Apply(base.data(), base.size(), delta.data(),
+                                delta.size(), 255, applied));
+  EXPECT_TRUE(applied.empty());
+  EXPECT_TRUE(ByteDelta::Apply(base.data(), base.size(), delta.data(),
+                               delta.size(), 256, applied));
+
+  // The target size comes last in the header, forge it.
+  auto forged = ByteDelta::Encode(base.data(), base.size(), base.data(), 0);
+  for (size_t i = forged.size() - sizeof(uint64_t); i < forged.size(); ++i) {
+    forged[i] = 0xff;
+  }
+  EXPECT_FALSE(ByteDelta::Apply(base.data(), base.size(), forged.data(),
+                                forged.size(), kMaxSize, applied));
+}
+
+TEST(ByteDeltaTests, Runs) {
+  auto data = MakeBytes(256, 0);
+  auto target = MakeBytes(256, 0);
+  target[10] = 0;
+  target[200] ^= 0x80;
+
+  ByteWriter writer;
+  ByteDelta::EncodeRuns(data.data(), target.data(), data.size(), writer);
+  ByteReader check(writer.bytes().data(), writer.size());
+  ASSERT_TRUE(ByteDelta::ApplyRuns(check, nullptr, data.size()));
+  ByteReader reader(writer.bytes().data(), writer.size());
+  ASSERT_TRUE(ByteDelta::ApplyRuns(reader, data.data(), data.size()));
+  EXPECT_EQ(reader.remaining(), 0);
+  EXPECT_TRUE(IsEqual(data, target));
+
+  // Runs of a longer span don't fit a shorter one.
+  ByteReader shorter(writer.bytes().data(), writer.size());
+  EXPECT_FALSE(ByteDelta::ApplyRuns(shorter, nullptr, 100));
+}
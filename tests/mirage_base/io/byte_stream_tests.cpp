@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+
+#include "mirage_base/io/byte_stream.hpp"
+#include "mirage_base/io/mapped_file.hpp"
+
+using namespace mirage::base;
+
+TEST(ByteStreamTests, RoundTrip) {
+  ByteWriter writer;
+  writer.Write<uint32_t>(0);
+  writer.WriteString("mirage");
+  writer.Write(3.5);
+  writer.WriteAt<uint32_t>(0, 42);
+  EXPECT_EQ(writer.size(), 4 + (4 + 6) + 8);
+
+  const auto bytes = writer.TakeBytes();
+  ByteReader reader(bytes.data(), bytes.size());
+  EXPECT_EQ(reader.Read<uint32_t>(), 42);
+  EXPECT_EQ(reader.ReadString(), "mirage");
+  EXPECT_EQ(reader.Read<double>(), 3.5);
+  EXPECT_EQ(reader.remaining(), 0);
+  EXPECT_TRUE(reader.is_ok());
+}
+
+TEST(ByteStreamTests, Overrun) {
+  ByteWriter writer;
+  writer.Write<uint16_t>(7);
+  ByteReader reader(writer.bytes().data(), writer.size());
+  // A failed read is zeroed and every later one fails as well.
+  EXPECT_EQ(reader.Read<uint32_t>(), 0);
+  EXPECT_FALSE(reader.is_ok());
+  EXPECT_EQ(reader.Skip(0), nullptr);
+  EXPECT_TRUE(reader.ReadString().empty());
+}
+
+TEST(MappedFileTests, Open) {
+  const auto path = testing::TempDir() + "mapped_file_tests.bin";
+  ByteWriter writer;
+  writer.WriteString("mapped");
+  ASSERT_TRUE(writer.WriteToFile(path.c_str()));
+
+  auto file = MappedFile::Open(path.c_str());
+  ASSERT_TRUE(file.is_valid());
+  ASSERT_EQ(file.size(), writer.size());
+  ByteReader reader(file.data(), file.size());
+  EXPECT_EQ(reader.ReadString(), "mapped");
+
+  const auto moved = std::move(file);
+  EXPECT_TRUE(moved.is_valid());
+  EXPECT_FALSE(file.is_valid());  // NOLINT: Checking the moved-from state
+  EXPECT_FALSE(MappedFile::Open((path + ".missing").c_str()).is_valid());
+  std::remove(path.c_str());
+}
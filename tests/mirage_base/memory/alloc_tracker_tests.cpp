@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_base/container/hash_map.hpp"
+#include "mirage_base/memory/alloc_tracker.hpp"
+
+using namespace mirage::base;
+
+namespace {
+
+const AllocTracker::Snapshot* FindTag(
+    const Array<AllocTracker::Snapshot>& snapshot_array, const char* tag) {
+  for (const auto& snapshot : snapshot_array) {
+    if (std::strcmp(snapshot.tag, tag) == 0) {
+      return &snapshot;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+TEST(AllocTrackerTests, HistogramIndex) {
+  EXPECT_EQ(AllocTracker::HistogramIndex(1), 0);
+  EXPECT_EQ(AllocTracker::HistogramIndex(16), 0);
+  EXPECT_EQ(AllocTracker::HistogramIndex(17), 1);
+  EXPECT_EQ(AllocTracker::HistogramIndex(32), 1);
+  EXPECT_EQ(AllocTracker::HistogramIndex(33), 2);
+  EXPECT_EQ(AllocTracker::HistogramIndex(SIZE_MAX),
+            AllocTracker::kHistogramSize - 1);
+}
+
+TEST(AllocTrackerTests, TagScope) {
+  AllocTracker::MarkFrame();
+  RecordAlloc("test.default", 8);
+  {
+    const AllocTagScope scope("test.scope");
+    RecordAlloc("test.default", 100);
+    // Default tags do not hide the tag of the owner.
+    const AllocTagScope default_scope("test.inner", true);
+    RecordAlloc("test.default", 100);
+    RecordFree("test.default", 100);
+  }
+  {
+    const AllocTagScope default_scope("test.inner", true);
+    RecordAlloc("test.default", 40);
+  }
+
+  const auto delta_array = AllocTracker::MarkFrame();
+  const auto* fallback = FindTag(delta_array, "test.default");
+  ASSERT_NE(fallback, nullptr);
+  EXPECT_EQ(fallback->alloc_cnt, 1);
+  EXPECT_EQ(fallback->size_histogram[0], 1);
+
+  const auto* scope = FindTag(delta_array, "test.scope");
+  ASSERT_NE(scope, nullptr);
+  EXPECT_EQ(scope->alloc_cnt, 2);
+  EXPECT_EQ(scope->alloc_bytes, 200);
+  EXPECT_EQ(scope->free_cnt, 1);
+  EXPECT_EQ(scope->size_histogram[AllocTracker::HistogramIndex(100)], 2);
+
+  const auto* inner = FindTag(delta_array, "test.inner");
+  ASSERT_NE(inner, nullptr);
+  EXPECT_EQ(inner->alloc_bytes, 40);
+  EXPECT_NE(AllocTracker::DumpTable(delta_array).find("test.scope"),
+            std::string::npos);
+}
+
+TEST(AllocTrackerTests, FrameDelta) {
+  RecordAlloc("test.frame", 64);
+  AllocTracker::MarkFrame();
+  const auto delta_array = AllocTracker::MarkFrame();
+  // Nothing was allocated since the previous frame.
+  const auto* frame = FindTag(delta_array, "test.frame");
+  ASSERT_NE(frame, nullptr);
+  EXPECT_EQ(frame->alloc_cnt, 0);
+
+  const auto snapshot_array = AllocTracker::SnapshotAll();
+  const auto* total = FindTag(snapshot_array, "test.frame");
+  ASSERT_NE(total, nullptr);
+  EXPECT_GE(total->alloc_cnt, 1);
+}
+
+#if defined(MIRAGE_BUILD_ALLOC_TRACKING)
+TEST(AllocTrackerTests, Containers) {
+  AllocTracker::MarkFrame();
+  {
+    const AllocTagScope scope("test.array");
+    Array<int32_t> array;
+    array.ReserveExact(4);
+  }
+  {
+    HashMap<int32_t, int32_t> map;
+    map.Insert(1, 1);
+  }
+
+  const auto delta_array = AllocTracker::MarkFrame();
+  const auto* array = FindTag(delta_array, "test.array");
+  ASSERT_NE(array, nullptr);
+  EXPECT_EQ(array->alloc_cnt, 1);
+  EXPECT_EQ(array->alloc_bytes, 4 * sizeof(int32_t));
+  EXPECT_EQ(array->free_bytes, array->alloc_bytes);
+  const auto* entry = FindTag(delta_array, "hash_set.entry");
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(entry->alloc_cnt, 1);
+  EXPECT_EQ(entry->free_cnt, 1);
+  EXPECT_NE(FindTag(delta_array, "hash_set.bucket"), nullptr);
+}
+#endif
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_base/profile/profiler.hpp"
+
+using namespace mirage::base;
+
+TEST(ProfilerTests, NestedZones) {
+  Profiler::Drain();
+  const auto frame = Profiler::frame();
+  {
+    const ProfileZone outer("outer");
+    { const ProfileZone inner("inner"); }
+  }
+  Profiler::MarkFrame();
+  { const ProfileZone next("next"); }
+
+  const auto zone_array = Profiler::Drain();
+  ASSERT_EQ(zone_array.size(), 4);
+  // Zones are recorded when they close.
+  EXPECT_STREQ(zone_array[0].name, "inner");
+  EXPECT_EQ(zone_array[0].depth, 1);
+  EXPECT_STREQ(zone_array[1].name, "outer");
+  EXPECT_EQ(zone_array[1].depth, 0);
+  EXPECT_LE(zone_array[1].begin_ns, zone_array[0].begin_ns);
+  EXPECT_GE(zone_array[1].end_ns, zone_array[0].end_ns);
+  EXPECT_EQ(zone_array[1].frame, frame);
+
+  EXPECT_EQ(zone_array[2].depth, Profiler::kFrameMark);
+  EXPECT_STREQ(zone_array[3].name, "next");
+  EXPECT_EQ(zone_array[3].frame, frame + 1);
+  EXPECT_TRUE(Profiler::Drain().empty());
+}
+
+TEST(ProfilerTests, Threads) {
+  Profiler::Drain();
+  Array<std::thread> thread_array;
+  for (int32_t i = 0; i < 4; ++i) {
+    thread_array.Emplace([] {
+      for (int32_t j = 0; j < 100; ++j) {
+        const ProfileZone zone("worker");
+      }
+    });
+  }
+  for (auto& thread : thread_array) {
+    thread.join();
+  }
+
+  const auto zone_array = Profiler::Drain();
+  ASSERT_EQ(zone_array.size(), 400);
+  for (size_t i = 0; i < 4; ++i) {
+    // Each thread keeps its own ring, drained one after another.
+    EXPECT_NE(zone_array[i * 100].thread_index,
+              zone_array[(i + 1) % 4 * 100].thread_index);
+  }
+}
+
+TEST(ProfilerTests, Dump) {
+  Profiler::Drain();
+  { const ProfileZone zone("quote\"zone"); }
+  Profiler::MarkFrame();
+  const auto zone_array = Profiler::Drain();
+
+  const auto trace = Profiler::DumpChromeTrace(zone_array);
+  EXPECT_NE(trace.find(R"("name":"quote\"zone","ph":"X")"), std::string::npos);
+  EXPECT_NE(trace.find(R"("name":"frame","ph":"i")"), std::string::npos);
+
+  const auto binary = Profiler::DumpBinary(zone_array);
+  ASSERT_GT(binary.size(), 12);
+  EXPECT_EQ(std::memcmp(binary.data(), "MPRF", 4), 0);
+  uint32_t name_cnt = 0;
+  std::memcpy(&name_cnt, binary.data() + 8, sizeof(name_cnt));
+  EXPECT_EQ(name_cnt, 2);
+  // Header, two names, zone count and two 36-byte records.
+  EXPECT_EQ(binary.size(), 12 + (4 + 10) + (4 + 5) + 8 + 2 * 36);
+}
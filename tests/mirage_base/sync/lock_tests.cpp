@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_base/sync/lock.hpp"
+#include "mirage_base/sync/lock_stats.hpp"
+#include "mirage_base/sync/rw_lock.hpp"
+
+using namespace mirage::base;
+
+namespace {
+
+constexpr int32_t kThreadCnt = 4;
+constexpr int32_t kLoopCnt = 1e4;
+
+template <typename F>
+void RunInThreads(F&& func) {
+  Array<std::thread> thread_array;
+  for (int32_t i = 0; i < kThreadCnt; ++i) {
+    thread_array.Emplace(func);
+  }
+  for (auto& thread : thread_array) {
+    thread.join();
+  }
+}
+
+}  // namespace
+
+TEST(LockTests, TryAcquire) {
+  const Lock lock;
+  EXPECT_TRUE(lock.TryAcquire());
+  EXPECT_FALSE(lock.TryAcquire());
+  lock.Release();
+  EXPECT_TRUE(lock.TryAcquire());
+  lock.Release();
+}
+
+TEST(LockTests, Contended) {
+  const Lock lock;
+  int32_t counter = 0;
+  RunInThreads([&] {
+    for (int32_t i = 0; i < kLoopCnt; ++i) {
+      ScopedLockGuard guard(lock);
+      ++counter;
+    }
+  });
+  EXPECT_EQ(counter, kThreadCnt * kLoopCnt);
+}
+
+TEST(RWLockTests, TryReadAndWrite) {
+  const RWLock rw_lock;
+  EXPECT_TRUE(rw_lock.TryRead());
+  EXPECT_TRUE(rw_lock.TryRead());
+  EXPECT_FALSE(rw_lock.TryWrite());
+  rw_lock.UnlockRead();
+  rw_lock.UnlockRead();
+
+  EXPECT_TRUE(rw_lock.TryWrite());
+  EXPECT_FALSE(rw_lock.TryRead());
+  EXPECT_FALSE(rw_lock.TryWrite());
+  rw_lock.UnlockWrite();
+}
+
+TEST(RWLockTests, Contended) {
+  const RWLock rw_lock;
+  int32_t counter = 0;
+  RunInThreads([&] {
+    for (int32_t i = 0; i < kLoopCnt; ++i) {
+      if (i % 4 == 0) {
+        ScopedWriteGuard guard(rw_lock);
+        ++counter;
+      } else {
+        ScopedReadGuard guard(rw_lock);
+        EXPECT_GE(counter, 0);
+      }
+    }
+  });
+  EXPECT_EQ(counter, kThreadCnt * kLoopCnt / 4);
+}
+
+#if defined(MIRAGE_BUILD_LOCK_STATS)
+TEST(LockStatsTests, Record) {
+  const Lock lock("test.lock");
+  const Lock same_name_lock("test.lock");
+  const RWLock rw_lock("test.rw_lock");
+  LockStats::ResetAll();
+
+  RunInThreads([&] {
+    for (int32_t i = 0; i < kLoopCnt; ++i) {
+      ScopedLockGuard guard(i % 2 ? lock : same_name_lock);
+    }
+  });
+  { ScopedReadGuard guard(rw_lock); }
+  { ScopedWriteGuard guard(rw_lock); }
+
+  const auto* stats = LockStats::FindOrCreate("test.lock");
+  EXPECT_EQ(stats->snapshot().acquire_cnt, kThreadCnt * kLoopCnt);
+  EXPECT_EQ(LockStats::FindOrCreate("test.rw_lock")->snapshot().acquire_cnt,
+            2);
+  EXPECT_NE(LockStats::DumpTable().find("test.rw_lock"), std::string::npos);
+  EXPECT_NE(LockStats::DumpJson().find("\"name\":\"test.lock\""),
+            std::string::npos);
+}
+#elif defined(MIRAGE_HAS_FUTEX)
+TEST(LockStatsTests, NoCostWhenDisabled) {
+  EXPECT_EQ(sizeof(Lock), sizeof(uint32_t));
+}
+#endif
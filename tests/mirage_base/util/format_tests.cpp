@@ -0,0 +1,25 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "mirage_base/util/format.hpp"
+
+using namespace mirage::base;
+
+TEST(FormatTests, AppendFormat) {
+  std::string out = "id=";
+  EXPECT_TRUE(AppendFormat(out, "%d, %s", 42, "name"));
+  EXPECT_EQ(out, "id=42, name");
+
+  // Lines longer than the stack buffer are not cut.
+  const std::string long_name(1000, 'x');
+  out.clear();
+  EXPECT_TRUE(AppendFormat(out, "[%s]", long_name.c_str()));
+  EXPECT_EQ(out, "[" + long_name + "]");
+}
+
+TEST(FormatTests, AppendJsonEscaped) {
+  std::string out;
+  AppendJsonEscaped(out, "a\"b\\c\nd\te\x01");
+  EXPECT_EQ(out, "a\\\"b\\\\c\\nd\\te\\u0001");
+}
@@ -149,3 +149,34 @@ TEST(BoxTests, BoxBase) {
   EXPECT_EQ(box_move.type_id(), TypeId::Of<DestructCnt>());
   EXPECT_EQ(destruct_cnt, 0);
 }
+
+TEST(BoxTests, TrivialPayload) {
+  struct Position {
+    double x, y, z;
+  };
+  EXPECT_TRUE(Box<>::AllowSmallObjectOptimize<Position>());
+
+  Box<> box = Position{1, 2, 3};
+  EXPECT_EQ(box.raw_ptr(), box.TryCast<Position>());
+  Box<> box_move = std::move(box);
+  EXPECT_FALSE(box.is_valid());
+  EXPECT_EQ(box.raw_ptr(), nullptr);
+  EXPECT_EQ(box_move.type_id(), TypeId::Of<Position>());
+  EXPECT_EQ(box_move.TryCast<int32_t>(), nullptr);
+  EXPECT_EQ(box_move.TryCast<Position>()->z, 3);
+}
+
+TEST(BoxTests, InlineSize) {
+  using Box64 = Box<AnyConstraint, 64>;
+  EXPECT_TRUE(Box64::AllowSmallObjectOptimize<Vec4>());
+  EXPECT_FALSE(Box64::AllowSmallObjectOptimize<BigAlign>());
+
+  int32_t destruct_cnt = 0;
+  {
+    Box64 box = Vec4{1, 2, 3, 4, DestructCnt{&destruct_cnt}};
+    Box64 box_move = std::move(box);
+    EXPECT_EQ(box_move.TryCast<Vec4>()->w, 4);
+    EXPECT_EQ(destruct_cnt, 0);
+  }
+  EXPECT_EQ(destruct_cnt, 1);
+}
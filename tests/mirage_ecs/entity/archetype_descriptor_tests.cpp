@@ -23,6 +23,10 @@ struct Int64 {
   int64_t value{0};
 };
 
+struct Tag {
+  MIRAGE_COMPONENT;
+};
+
 };  // namespace
 
 TEST(ArchetypeDescriptorTests, LayoutCheck) {
@@ -48,3 +52,16 @@ TEST(ArchetypeDescriptorTests, DuplicateInit) {
   EXPECT_EQ(offset_map[ComponentId::Of<Int32>()], 8);
   EXPECT_EQ(offset_map[ComponentId::Of<Bool>()], 12);
 }
+
+TEST(ArchetypeDescriptorTests, TagHasNoColumn) {
+  const auto desc = ArchetypeDescriptor::New<Int32, Tag>({});
+  EXPECT_EQ(desc.size(), 4);
+  EXPECT_TRUE(desc.type_set().With(base::TypeId::Of<Tag>()));
+  EXPECT_FALSE(desc.offset_map().TryFind(ComponentId::Of<Tag>()));
+  EXPECT_TRUE(desc.HasTag(ComponentId::Of<Tag>()));
+  EXPECT_EQ(desc.tag_array().size(), 1);
+
+  const auto tag_only = ArchetypeDescriptor::New<Tag>({});
+  EXPECT_EQ(tag_only.size(), 0);
+  EXPECT_EQ(tag_only.align(), 1);
+}
@@ -93,8 +93,8 @@ TEST_F(ArchetypeTests, IndexOperatorMutable) {
   auto view = archetype_[index];
 
   // Modify component values
-  view.Get<Bool>().value = false;
-  view.Get<Int32>().value = 100;
+  view.GetMut<Bool>().value = false;
+  view.GetMut<Int32>().value = 100;
 
   // Verify modifications
   auto modified_view = archetype_[index];
@@ -112,7 +112,7 @@ TEST_F(ArchetypeTests, TakeNothing) {
 }
 
 TEST_F(ArchetypeTests, TakeMany) {
-  Array<Archetype::Index> indices;
+  Archetype::IndexArray indices;
   for (uint32_t i = 0; i < 2048; ++i) {
     ComponentBundle bundle;
     bundle.AddMany(Bool{i % 2 == 0}, Int32{static_cast<int32_t>(i)},
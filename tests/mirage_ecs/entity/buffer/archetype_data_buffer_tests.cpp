@@ -32,6 +32,11 @@ struct Counter {
   }
 };
 
+struct Unused {
+  MIRAGE_COMPONENT;
+  int32_t value;
+};
+
 class ArchetypeDataBufferTests : public ::testing::Test {
  protected:
   void TearDown() override {
@@ -152,3 +157,58 @@ TEST_F(ArchetypeDataBufferTests, Reserve) {
   EXPECT_EQ(buffer[0].Get<Counter>().destruct_cnt_, &destruct_cnt_);
   EXPECT_EQ(destruct_cnt_, 0);
 }
+
+TEST_F(ArchetypeDataBufferTests, ChangeTicks) {
+  const auto counter_id = ComponentId::Of<Counter>();
+  EXPECT_FALSE(buffer_.IsColumnAdded(counter_id, kInitTick));
+  EXPECT_FALSE(buffer_.IsColumnChanged(counter_id, kInitTick));
+
+  Tick change_tick = 1;
+  buffer_.BindChangeTick(&change_tick);
+  ComponentBundle bundle;
+  bundle.Add(Counter(&destruct_cnt_));
+  buffer_.Push({1, 0}, bundle);
+  EXPECT_TRUE(buffer_.IsColumnAdded(counter_id, 0));
+  EXPECT_TRUE(buffer_.IsColumnChanged(counter_id, 0));
+  EXPECT_FALSE(buffer_.IsColumnAdded(counter_id, 1));
+  EXPECT_FALSE(buffer_.IsColumnChanged(counter_id, 1));
+
+  // Advancing the bound tick needs no call into the buffer.
+  change_tick = 2;
+  EXPECT_EQ(buffer_.change_tick(), 2);
+  EXPECT_EQ(buffer_[0].Get<Counter>().destruct_cnt_, &destruct_cnt_);
+  EXPECT_FALSE(buffer_.IsColumnChanged(counter_id, 1));
+
+  EXPECT_EQ(buffer_[0].GetMut<Counter>().destruct_cnt_, &destruct_cnt_);
+  EXPECT_TRUE(buffer_.IsColumnChanged(counter_id, 1));
+  EXPECT_FALSE(buffer_.IsColumnAdded(counter_id, 1));
+
+  buffer_.Reserve(4 * ArchetypeDataBuffer::unit_size(*desc_));
+  change_tick = 3;
+  EXPECT_EQ(buffer_.change_tick(), 3);
+  EXPECT_TRUE(buffer_.IsColumnChanged(counter_id, 1));
+  EXPECT_FALSE(buffer_.IsColumnAdded(counter_id, 1));
+  buffer_.BindChangeTick(&kInitTick);
+}
+
+TEST_F(ArchetypeDataBufferTests, ColumnChangedSkip) {
+  const auto counter_id = ComponentId::Of<Counter>();
+  Tick change_tick = 1;
+  buffer_.BindChangeTick(&change_tick);
+  for (EntityId id : {EntityId{0, 0}, EntityId{1, 0}}) {
+    ComponentBundle bundle;
+    bundle.Add(Counter(&destruct_cnt_));
+    buffer_.Push(id, bundle);
+  }
+  change_tick = 2;
+  EXPECT_FALSE(buffer_.IsColumnChanged(counter_id, 1));
+  EXPECT_FALSE(buffer_.IsColumnChanged(ComponentId::Of<Unused>(), 0));
+
+  // Removing a row shifts the others without writing the column.
+  buffer_.RemoveTail();
+  EXPECT_EQ(buffer_.column_ticks()[0].changed_tick(), 1);
+  EXPECT_TRUE(buffer_.IsColumnChanged(counter_id, 1));
+  EXPECT_FALSE(buffer_.IsColumnChanged(counter_id, 2));
+  EXPECT_FALSE(buffer_.IsColumnAdded(counter_id, 1));
+  buffer_.BindChangeTick(&kInitTick);
+}
@@ -0,0 +1,353 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "mirage_base/io/byte_delta.hpp"
+#include "mirage_ecs/component/relation.hpp"
+#include "mirage_ecs/entity/entity_manager.hpp"
+
+using namespace mirage::ecs;
+using namespace mirage::base;
+
+namespace {
+
+struct Position {
+  MIRAGE_COMPONENT;
+  float x{0.0f};
+  float y{0.0f};
+};
+
+struct Name {
+  MIRAGE_COMPONENT;
+
+  explicit Name(std::string value) : value(std::move(value)) {}
+
+  void Serialize(ByteWriter &writer) const { writer.WriteString(value); }
+  static Name Deserialize(ByteReader &reader) {
+    return Name(std::string(reader.ReadString()));
+  }
+
+  std::string value;
+};
+
+struct Poisoned {
+  MIRAGE_COMPONENT;
+  MIRAGE_SPARSE_SET_STORAGE;
+  int32_t damage{0};
+};
+
+struct Frozen {
+  MIRAGE_COMPONENT;
+};
+
+struct Script {
+  MIRAGE_COMPONENT;
+  std::string source;
+};
+
+struct ChildOf {};
+
+ComponentRegistry MakeRegistry() {
+  ComponentRegistry registry;
+  registry.Register<Position, Name, Poisoned, Frozen, Relation<ChildOf>>();
+  return registry;
+}
+
+constexpr size_t kMaxEntityCnt = 1 << 20;
+
+// Send what changed in `manager` to `replica`, returning the delta size.
+size_t Replicate(const EntityManager &manager, SnapshotBaseline &sent,
+                 EntityManager &replica, SnapshotBaseline &received) {
+  ByteWriter writer;
+  EXPECT_TRUE(manager.SaveDelta(sent, writer));
+  ByteReader reader(writer.bytes().data(), writer.size());
+  EXPECT_TRUE(
+      replica.ApplyDelta(received, reader, kMaxEntityCnt, MakeRegistry()));
+  EXPECT_EQ(sent.sequence(), received.sequence());
+  return writer.size();
+}
+
+// A delta appending a row for `entity_id` to the first archetype, which holds
+// `row_cnt` rows of `Position` only, written by hand.
+ByteWriter MakeAppendDelta(const uint64_t sequence, const uint64_t row_cnt,
+                           const EntityId &entity_id) {
+  ByteWriter writer;
+  writer.WriteBytes("MDLT", 4);
+  writer.Write<uint32_t>(1);
+  writer.Write(sequence);
+  writer.Write<uint8_t>(0);
+  writer.Write<uint32_t>(0);
+  writer.Write<uint64_t>(row_cnt + 1);
+  writer.Write<uint64_t>(0);
+  writer.Write<uint64_t>(0);
+  writer.Write<uint32_t>(1);
+  writer.Write<uint32_t>(0);
+  writer.Write<uint8_t>(0);
+  writer.Write<uint64_t>(row_cnt + 1);
+  writer.Write<uint32_t>(1);
+  writer.Write<uint64_t>(row_cnt);
+  writer.Write<uint64_t>(1);
+
+  ByteWriter row_writer;
+  const EntityId invalid_id;
+  row_writer.Write<uint8_t>(1);
+  ByteDelta::EncodeRuns(reinterpret_cast<const uint8_t *>(&invalid_id),
+                        reinterpret_cast<const uint8_t *>(&entity_id),
+                        sizeof(EntityId), row_writer);
+  const Position zero;
+  const Position position{.x = 7.0f};
+  row_writer.Write<uint8_t>(1);
+  ByteDelta::EncodeRuns(reinterpret_cast<const uint8_t *>(&zero),
+                        reinterpret_cast<const uint8_t *>(&position),
+                        sizeof(Position), row_writer);
+  writer.Write<uint64_t>(row_writer.size());
+  writer.WriteBytes(row_writer.bytes().data(), row_writer.size());
+  writer.Write<uint32_t>(0);
+  return writer;
+}
+
+}  // namespace
+
+TEST(EntityManagerSnapshotTests, RoundTrip) {
+  EntityManager manager;
+  Array<EntityId> id_array;
+  // Enough rows to span several chunks.
+  for (int32_t i = 0; i < 2000; ++i) {
+    ComponentBundle bundle;
+    bundle.Add(Position{.x = static_cast<float>(i), .y = 1.0f});
+    id_array.Push(manager.Create(bundle));
+  }
+  ComponentBundle bundle;
+  bundle.AddMany(Name("root"), Frozen{});
+  const auto root = manager.Create(bundle);
+  bundle.AddMany(Name("child"), Relation<ChildOf>(root),
+                 Position{.x = -1.0f, .y = -2.0f});
+  const auto child = manager.Create(bundle);
+  manager.AddComponent(child, Poisoned{.damage = 3});
+  manager.Destroy(id_array[7]);
+
+  ByteWriter writer;
+  ASSERT_TRUE(manager.SaveSnapshot(writer));
+  ByteReader reader(writer.bytes().data(), writer.size());
+  EntityManager loaded;
+  ASSERT_TRUE(loaded.LoadSnapshot(reader, MakeRegistry()));
+  EXPECT_EQ(reader.remaining(), 0);
+
+  EXPECT_EQ(loaded.size(), manager.size());
+  EXPECT_FALSE(loaded.Contains(id_array[7]));
+  EXPECT_EQ(loaded.TryGetComponent<Position>(id_array[1999])->x, 1999.0f);
+  EXPECT_EQ(loaded.TryGetComponent<Name>(root)->value, "root");
+  EXPECT_TRUE(loaded.HasComponent(root, TypeId::Of<Frozen>()));
+  EXPECT_EQ(loaded.TryGetComponent<Name>(child)->value, "child");
+  EXPECT_EQ(loaded.TryGetComponent<Position>(child)->y, -2.0f);
+  EXPECT_EQ(loaded.TryGetComponent<Poisoned>(child)->damage, 3);
+  const auto *source_array = loaded.TryGetSources<ChildOf>(root);
+  ASSERT_NE(source_array, nullptr);
+  EXPECT_EQ((*source_array)[0], child);
+
+  // The free list survives, so the next id matches the original manager's.
+  ComponentBundle next_bundle;
+  next_bundle.Add(Position{});
+  const auto next = loaded.Create(next_bundle);
+  EXPECT_EQ(next.index(), id_array[7].index());
+  EXPECT_EQ(next.generation(), id_array[7].generation() + 1);
+  // Relations pointing at a loaded entity are still cleaned up.
+  loaded.Destroy(root);
+  EXPECT_FALSE(loaded.HasComponent(child, TypeId::Of<Relation<ChildOf>>()));
+}
+
+TEST(EntityManagerSnapshotTests, Unserializable) {
+  EntityManager manager;
+  ComponentBundle bundle;
+  bundle.Add(Script{.source = "print()"});
+  manager.Create(bundle);
+  ByteWriter writer;
+  EXPECT_FALSE(manager.SaveSnapshot(writer));
+  EXPECT_EQ(writer.size(), 0);
+
+  EntityManager other;
+  bundle.Add(Name("unregistered"));
+  other.Create(bundle);
+  ASSERT_TRUE(other.SaveSnapshot(writer));
+  ByteReader reader(writer.bytes().data(), writer.size());
+  EntityManager loaded;
+  EXPECT_FALSE(loaded.LoadSnapshot(reader, ComponentRegistry()));
+
+  // A truncated snapshot fails instead of reading past the end.
+  ByteReader truncated(writer.bytes().data(), writer.size() - 1);
+  EntityManager partial;
+  EXPECT_FALSE(partial.LoadSnapshot(truncated, MakeRegistry()));
+}
+
+TEST(EntityManagerSnapshotTests, DeltaSpawn) {
+  EntityManager manager;
+  Array<EntityId> id_array;
+  for (int32_t i = 0; i < 10000; ++i) {
+    ComponentBundle bundle;
+    bundle.Add(Position{.x = static_cast<float>(i)});
+    id_array.Push(manager.Create(bundle));
+  }
+  // Writes stamped at the tick of a delta are sent again by the next one, so
+  // every delta is followed by a new tick.
+  SnapshotBaseline sent;
+  SnapshotBaseline received;
+  EntityManager replica;
+  manager.set_change_tick(1);
+  Replicate(manager, sent, replica, received);
+  EXPECT_EQ(replica.size(), 10000);
+  manager.set_change_tick(2);
+  EXPECT_LT(Replicate(manager, sent, replica, received), 100);
+
+  // Only the tail chunk is sent, not every row after the new one.
+  manager.set_change_tick(3);
+  ComponentBundle bundle;
+  bundle.Add(Position{.x = -1.0f});
+  const auto spawned = manager.Create(bundle);
+  EXPECT_LT(Replicate(manager, sent, replica, received), 200);
+  EXPECT_EQ(replica.size(), 10001);
+  EXPECT_EQ(replica.TryGetComponent<Position>(spawned)->x, -1.0f);
+  for (int32_t i = 0; i < 10000; ++i) {
+    EXPECT_EQ(replica.TryGetComponent<Position>(id_array[i])->x,
+              static_cast<float>(i));
+  }
+
+  manager.set_change_tick(4);
+  manager.TryGetComponent<Position>(id_array[5000])->y = 2.0f;
+  manager.Destroy(id_array[10]);
+  EXPECT_LT(Replicate(manager, sent, replica, received), 1000);
+  EXPECT_EQ(replica.size(), 10000);
+  EXPECT_FALSE(replica.Contains(id_array[10]));
+  EXPECT_EQ(replica.TryGetComponent<Position>(id_array[5000])->y, 2.0f);
+  // The tail row moved into the hole is still found by its id.
+  EXPECT_EQ(replica.TryGetComponent<Position>(spawned)->x, -1.0f);
+
+  // The free list follows, so both managers hand out the same next id.
+  manager.set_change_tick(5);
+  bundle.Add(Position{});
+  const auto next = manager.Create(bundle);
+  Replicate(manager, sent, replica, received);
+  EXPECT_EQ(next.index(), id_array[10].index());
+  bundle.Add(Position{});
+  ComponentBundle other_bundle;
+  other_bundle.Add(Position{});
+  EXPECT_EQ(replica.Create(bundle), manager.Create(other_bundle));
+}
+
+TEST(EntityManagerSnapshotTests, DeltaMove) {
+  EntityManager manager;
+  ComponentBundle bundle;
+  bundle.AddMany(Name("root"), Frozen{});
+  const auto root = manager.Create(bundle);
+  bundle.AddMany(Name("child"), Relation<ChildOf>(root), Position{});
+  const auto child = manager.Create(bundle);
+  manager.AddComponent(child, Poisoned{.damage = 3});
+
+  SnapshotBaseline sent;
+  SnapshotBaseline received;
+  EntityManager replica;
+  Replicate(manager, sent, replica, received);
+  EXPECT_EQ(replica.TryGetComponent<Name>(child)->value, "child");
+  EXPECT_EQ(replica.TryGetComponent<Poisoned>(child)->damage, 3);
+  EXPECT_EQ((*replica.TryGetSources<ChildOf>(root))[0], child);
+
+  // Destroying the target moves the child to an archetype without the
+  // relation.
+  manager.set_change_tick(1);
+  manager.Destroy(root);
+  manager.TryGetComponent<Name>(child)->value = "orphan";
+  manager.RemoveComponent<Poisoned>(child);
+  Replicate(manager, sent, replica, received);
+  EXPECT_EQ(replica.size(), 1);
+  EXPECT_FALSE(replica.Contains(root));
+  EXPECT_EQ(replica.TryGetSources<ChildOf>(root), nullptr);
+  EXPECT_FALSE(replica.HasComponent(child, TypeId::Of<Relation<ChildOf>>()));
+  EXPECT_EQ(replica.TryGetComponent<Name>(child)->value, "orphan");
+  EXPECT_EQ(replica.TryGetComponent<Poisoned>(child), nullptr);
+
+  // Rolling back to before the first delta replaces every entity again.
+  EntityManager empty;
+  ASSERT_TRUE(empty.CloneInto(manager));
+  Replicate(manager, sent, replica, received);
+  EXPECT_EQ(replica.size(), 0);
+  EXPECT_FALSE(replica.Contains(child));
+}
+
+TEST(EntityManagerSnapshotTests, DeltaRefused) {
+  EntityManager manager;
+  ComponentBundle bundle;
+  bundle.Add(Position{});
+  manager.Create(bundle);
+  SnapshotBaseline sent;
+  ByteWriter writer;
+  ASSERT_TRUE(manager.SaveDelta(sent, writer));
+
+  SnapshotBaseline received;
+  EntityManager replica;
+  ByteReader reader(writer.bytes().data(), writer.size());
+  EXPECT_FALSE(replica.ApplyDelta(received, reader, 0, MakeRegistry()));
+  reader = ByteReader(writer.bytes().data(), writer.size() - 1);
+  EXPECT_FALSE(replica.ApplyDelta(received, reader, kMaxEntityCnt,
+                                  MakeRegistry()));
+  reader = ByteReader(writer.bytes().data(), writer.size());
+  ASSERT_TRUE(replica.ApplyDelta(received, reader, kMaxEntityCnt,
+                                 MakeRegistry()));
+  // A delta only applies to the baseline it was made against.
+  reader = ByteReader(writer.bytes().data(), writer.size());
+  EXPECT_FALSE(replica.ApplyDelta(received, reader, kMaxEntityCnt,
+                                  MakeRegistry()));
+
+  EntityManager unserializable;
+  ComponentBundle script_bundle;
+  script_bundle.Add(Script{.source = "print()"});
+  unserializable.Create(script_bundle);
+  ByteWriter script_writer;
+  EXPECT_FALSE(unserializable.SaveDelta(sent, script_writer));
+  EXPECT_EQ(script_writer.size(), 0);
+}
+
+TEST(EntityManagerSnapshotTests, DeltaRefusedKeepsEntities) {
+  EntityManager manager;
+  Array<EntityId> id_array;
+  for (int32_t i = 0; i < 2; ++i) {
+    ComponentBundle bundle;
+    bundle.Add(Position{.x = static_cast<float>(i)});
+    id_array.Push(manager.Create(bundle));
+  }
+  SnapshotBaseline sent;
+  SnapshotBaseline received;
+  EntityManager replica;
+  Replicate(manager, sent, replica, received);
+  auto expect_intact = [&] {
+    EXPECT_EQ(replica.size(), 2);
+    for (int32_t i = 0; i < 2; ++i) {
+      ASSERT_TRUE(replica.Contains(id_array[i]));
+      EXPECT_EQ(replica.TryGetComponent<Position>(id_array[i])->x,
+                static_cast<float>(i));
+    }
+  };
+
+  // The appended row claims an id that is still alive, or no id at all.
+  for (const auto &entity_id : {id_array[0], EntityId(), EntityId(3, 0)}) {
+    const auto writer = MakeAppendDelta(received.sequence(), 2, entity_id);
+    ByteReader reader(writer.bytes().data(), writer.size());
+    EXPECT_FALSE(replica.ApplyDelta(received, reader, kMaxEntityCnt,
+                                    MakeRegistry()));
+    expect_intact();
+  }
+  const auto writer = MakeAppendDelta(received.sequence(), 2, {2, 0});
+  ByteReader reader(writer.bytes().data(), writer.size());
+  ASSERT_TRUE(
+      replica.ApplyDelta(received, reader, kMaxEntityCnt, MakeRegistry()));
+  EXPECT_EQ(replica.TryGetComponent<Position>({2, 0})->x, 7.0f);
+
+  // A reset that fails keeps the entities the replica had.
+  EntityManager empty;
+  ASSERT_TRUE(empty.CloneInto(manager));
+  ByteWriter reset_writer;
+  ASSERT_TRUE(manager.SaveDelta(sent, reset_writer));
+  reader = ByteReader(reset_writer.bytes().data(), reset_writer.size() - 1);
+  EXPECT_FALSE(
+      replica.ApplyDelta(received, reader, kMaxEntityCnt, MakeRegistry()));
+  EXPECT_EQ(replica.size(), 3);
+  EXPECT_TRUE(replica.Contains(id_array[1]));
+}
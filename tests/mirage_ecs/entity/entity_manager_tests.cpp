@@ -0,0 +1,323 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+
+#include "mirage_ecs/component/relation.hpp"
+#include "mirage_ecs/entity/entity_manager.hpp"
+
+using namespace mirage::ecs;
+using namespace mirage::base;
+
+namespace {
+
+struct Int32 {
+  MIRAGE_COMPONENT;
+  int32_t value{0};
+};
+
+struct DestructCounter {
+  MIRAGE_COMPONENT;
+
+  explicit DestructCounter(size_t *counter_ptr) : counter_ptr(counter_ptr) {}
+  ~DestructCounter() {
+    if (counter_ptr) {
+      ++*counter_ptr;
+    }
+  }
+
+  DestructCounter(DestructCounter &&other) noexcept
+      : counter_ptr(other.counter_ptr) {
+    other.counter_ptr = nullptr;
+  }
+
+  size_t *counter_ptr{nullptr};
+};
+
+struct Poisoned {
+  MIRAGE_COMPONENT;
+  MIRAGE_SPARSE_SET_STORAGE;
+  int32_t damage{0};
+};
+
+struct Frozen {
+  MIRAGE_COMPONENT;
+};
+
+struct ChildOf {};
+struct Targets {};
+
+struct Label {
+  MIRAGE_COMPONENT;
+  std::string value;
+};
+
+EntityId CreateInt32(EntityManager &manager, const int32_t value) {
+  ComponentBundle bundle;
+  bundle.Add(Int32{value});
+  return manager.Create(bundle);
+}
+
+}  // namespace
+
+TEST(EntityManagerTests, CreateAndDestroy) {
+  EntityManager manager;
+  size_t counter = 0;
+
+  ComponentBundle bundle;
+  bundle.AddMany(Int32{42}, DestructCounter(&counter));
+  const auto entity_id = manager.Create(bundle);
+  EXPECT_EQ(manager.size(), 1);
+  EXPECT_TRUE(manager.Contains(entity_id));
+  EXPECT_EQ(manager.Get(entity_id).Get<Int32>().value, 42);
+
+  manager.Destroy(entity_id);
+  EXPECT_EQ(counter, 1);
+  EXPECT_EQ(manager.size(), 0);
+  EXPECT_FALSE(manager.Contains(entity_id));
+
+  // The index is reused with a new generation.
+  const auto reused_id = CreateInt32(manager, 7);
+  EXPECT_EQ(reused_id.index(), entity_id.index());
+  EXPECT_NE(reused_id.generation(), entity_id.generation());
+  EXPECT_FALSE(manager.Contains(entity_id));
+  EXPECT_EQ(manager.Get(reused_id).Get<Int32>().value, 7);
+}
+
+TEST(EntityManagerTests, RelationSources) {
+  EntityManager manager;
+  const auto parent = CreateInt32(manager, 0);
+  const auto enemy = CreateInt32(manager, 1);
+
+  Array<EntityId> children;
+  for (int32_t i = 0; i < 4; ++i) {
+    ComponentBundle bundle;
+    bundle.AddMany(Int32{i}, Relation<ChildOf>(parent));
+    if (i % 2 == 0) {
+      bundle.Add(Relation<Targets>(enemy));
+    }
+    children.Push(manager.Create(bundle));
+  }
+
+  ASSERT_NE(manager.TryGetSources<ChildOf>(parent), nullptr);
+  EXPECT_EQ(manager.TryGetSources<ChildOf>(parent)->size(), 4);
+  EXPECT_EQ(manager.TryGetSources<Targets>(enemy)->size(), 2);
+  EXPECT_EQ(manager.TryGetSources<Targets>(parent), nullptr);
+  EXPECT_EQ(manager.Get(children[1]).Get<Relation<ChildOf>>().target, parent);
+
+  manager.Destroy(children[0]);
+  EXPECT_EQ(manager.TryGetSources<ChildOf>(parent)->size(), 3);
+  EXPECT_EQ(manager.TryGetSources<Targets>(enemy)->size(), 1);
+}
+
+TEST(EntityManagerTests, DestroyTargetCleansRelations) {
+  EntityManager manager;
+  const auto enemy_a = CreateInt32(manager, 0);
+  const auto enemy_b = CreateInt32(manager, 1);
+
+  Array<EntityId> attackers;
+  for (int32_t i = 0; i < 64; ++i) {
+    ComponentBundle bundle;
+    bundle.AddMany(Int32{i}, Relation<Targets>(i % 2 ? enemy_a : enemy_b));
+    attackers.Push(manager.Create(bundle));
+  }
+
+  manager.DestroyMany({enemy_a, enemy_b});
+  EXPECT_EQ(manager.size(), 64);
+  EXPECT_EQ(manager.TryGetSources<Targets>(enemy_a), nullptr);
+  for (int32_t i = 0; i < 64; ++i) {
+    const auto view = std::as_const(manager).Get(attackers[i]);
+    EXPECT_EQ(view.TryGet<Relation<Targets>>(), nullptr);
+    EXPECT_EQ(view.Get<Int32>().value, i);
+  }
+}
+
+TEST(EntityManagerTests, StaleRelationTarget) {
+  EntityManager manager;
+  const auto stale = CreateInt32(manager, 0);
+  manager.Destroy(stale);
+  const auto reused = CreateInt32(manager, 1);
+  ASSERT_EQ(reused.index(), stale.index());
+
+  ComponentBundle bundle;
+  bundle.AddMany(Int32{2}, Relation<Targets>(stale));
+  EXPECT_FALSE(manager.Create(bundle).is_valid());
+  EXPECT_EQ(bundle.size(), 2);
+  EXPECT_EQ(manager.size(), 1);
+  EXPECT_EQ(manager.TryGetSources<Targets>(reused), nullptr);
+
+  bundle.AddMany(Relation<Targets>(reused));
+  const auto attacker = manager.Create(bundle);
+  ASSERT_TRUE(manager.Contains(attacker));
+  EXPECT_EQ(manager.TryGetSources<Targets>(stale), nullptr);
+  EXPECT_EQ(manager.TryGetSources<Targets>(reused)->size(), 1);
+}
+
+TEST(EntityManagerTests, SparseSetComponent) {
+  EntityManager manager;
+  ComponentBundle bundle;
+  bundle.AddMany(Int32{1}, Poisoned{3});
+  const auto entity_id = manager.Create(bundle);
+  const auto other_id = CreateInt32(manager, 2);
+
+  // Sparse-set components stay out of the archetype.
+  EXPECT_EQ(manager.Get(entity_id).TryGet<Poisoned>(), nullptr);
+  EXPECT_EQ(manager.TryGetComponent<Poisoned>(entity_id)->damage, 3);
+  EXPECT_EQ(manager.TryGetComponent<Int32>(entity_id)->value, 1);
+  EXPECT_EQ(manager.TryGetSparseSet(TypeId::Of<Poisoned>())->size(), 1);
+
+  const auto with = TypeSet::New<Int32, Poisoned>();
+  const auto without = TypeSet::New<Poisoned>();
+  EXPECT_TRUE(manager.Matches(entity_id, with, {}));
+  EXPECT_FALSE(manager.Matches(other_id, with, {}));
+  EXPECT_TRUE(manager.Matches(other_id, {}, without));
+
+  manager.AddComponent(other_id, Poisoned{5});
+  EXPECT_TRUE(manager.Matches(other_id, with, {}));
+  EXPECT_TRUE(manager.RemoveComponent<Poisoned>(entity_id));
+  EXPECT_FALSE(manager.RemoveComponent<Poisoned>(entity_id));
+  EXPECT_EQ(manager.TryGetComponent<Poisoned>(entity_id), nullptr);
+  EXPECT_EQ(manager.TryGetComponent<Poisoned>(other_id)->damage, 5);
+
+  manager.Destroy(other_id);
+  EXPECT_EQ(manager.TryGetSparseSet(TypeId::Of<Poisoned>())->size(), 0);
+}
+
+TEST(EntityManagerTests, ChangeTick) {
+  EntityManager source;
+  ComponentBundle bundle;
+  bundle.AddMany(Int32{1}, Poisoned{3});
+  const auto entity_id = source.Create(bundle);
+  // Chunks and sets follow the tick after the manager is moved.
+  EntityManager manager = std::move(source);
+  manager.set_change_tick(5);
+
+  const auto int32_id = ComponentId::Of<Int32>();
+  const auto *sparse_set = manager.TryGetSparseSet(TypeId::Of<Poisoned>());
+  EXPECT_EQ(std::as_const(manager).TryGetComponent<Int32>(entity_id)->value,
+            1);
+  EXPECT_FALSE(manager.Get(entity_id).TryGetTicks(int32_id)->IsChanged(4));
+
+  manager.TryGetComponent<Int32>(entity_id)->value = 2;
+  manager.TryGetComponent<Poisoned>(entity_id)->damage = 4;
+  EXPECT_TRUE(manager.Get(entity_id).TryGetTicks(int32_id)->IsChanged(4));
+  EXPECT_TRUE(sparse_set->TryGetTicks(entity_id)->IsChanged(4));
+  EXPECT_FALSE(sparse_set->TryGetTicks(entity_id)->IsAdded(4));
+}
+
+TEST(EntityManagerTests, TagComponent) {
+  EntityManager manager;
+  ComponentBundle bundle;
+  bundle.AddMany(Int32{1}, Frozen{});
+  const auto entity_id = manager.Create(bundle);
+  const auto other_id = CreateInt32(manager, 2);
+
+  EXPECT_NE(manager.TryGetComponent<Frozen>(entity_id), nullptr);
+  EXPECT_EQ(manager.TryGetComponent<Frozen>(other_id), nullptr);
+  EXPECT_TRUE(manager.Matches(entity_id, TypeSet::New<Frozen>(), {}));
+  EXPECT_TRUE(manager.Matches(other_id, {}, TypeSet::New<Frozen>()));
+
+  // A frozen entity with only the tag left still lives in an archetype.
+  ComponentBundle tag_bundle;
+  tag_bundle.Add(Frozen{});
+  const auto tag_only_id = manager.Create(tag_bundle);
+  EXPECT_TRUE(manager.HasComponent(tag_only_id, TypeId::Of<Frozen>()));
+  manager.Destroy(tag_only_id);
+  EXPECT_FALSE(manager.Contains(tag_only_id));
+}
+
+TEST(EntityManagerTests, MemoryReport) {
+  EntityManager manager;
+  Array<EntityId> entity_id_array;
+  for (int32_t i = 0; i < 100; ++i) {
+    entity_id_array.Push(CreateInt32(manager, i));
+  }
+  ComponentBundle bundle;
+  bundle.AddMany(Int32{0}, Poisoned{1});
+  manager.Create(bundle);
+  for (size_t i = 0; i < 10; ++i) {
+    manager.Destroy(entity_id_array[i]);
+  }
+
+  const auto report = manager.MemoryReport();
+  EXPECT_EQ(report.entity_cnt, 91);
+  ASSERT_EQ(report.archetype_array.size(), 1);
+  const auto &archetype = report.archetype_array[0];
+  EXPECT_EQ(archetype.entity_cnt, 91);
+  EXPECT_GE(archetype.chunk_cnt, 1);
+  EXPECT_LE(archetype.partial_chunk_cnt, archetype.chunk_cnt);
+  EXPECT_EQ(archetype.data_used_bytes, 91 * (sizeof(Int32) + sizeof(EntityId)));
+  EXPECT_GE(archetype.data_bytes, archetype.data_used_bytes);
+  // Destroyed entities leave holes in the sparse index.
+  EXPECT_GE(archetype.sparse_hole_cnt, 10);
+  EXPECT_GE(archetype.allocated_bytes(), archetype.used_bytes());
+
+  ASSERT_EQ(report.component_array.size(), 2);
+  const auto &int32 = report.component_array[0];
+  EXPECT_EQ(int32.type_id, TypeId::Of<Int32>());
+  EXPECT_EQ(int32.entity_cnt, 91);
+  EXPECT_EQ(int32.used_bytes, 91 * sizeof(Int32));
+  const auto &poisoned = report.component_array[1];
+  EXPECT_EQ(poisoned.type_id, TypeId::Of<Poisoned>());
+  EXPECT_EQ(poisoned.storage_type, StorageType::kSparseSet);
+  EXPECT_EQ(poisoned.entity_cnt, 1);
+  EXPECT_GE(poisoned.allocated_bytes, poisoned.used_bytes);
+
+  EXPECT_GT(report.bookkeeping_bytes, 0);
+  EXPECT_GE(report.allocated_bytes, report.used_bytes);
+  EXPECT_NE(report.DumpTable().find("Int32"), std::string::npos);
+}
+
+TEST(EntityManagerTests, CloneInto) {
+  EntityManager manager;
+  Array<EntityId> id_array;
+  for (int32_t i = 0; i < 1000; ++i) {
+    id_array.Push(CreateInt32(manager, i));
+  }
+  ComponentBundle bundle;
+  bundle.AddMany(Label{.value = "parent"}, Frozen{});
+  const auto parent = manager.Create(bundle);
+  bundle.AddMany(Int32{-1}, Relation<ChildOf>(parent));
+  const auto child = manager.Create(bundle);
+  manager.AddComponent(child, Poisoned{.damage = 5});
+
+  EntityManager dst;
+  ASSERT_TRUE(manager.CloneInto(dst));
+  EXPECT_EQ(dst.size(), manager.size());
+  EXPECT_EQ(dst.TryGetComponent<Int32>(id_array[999])->value, 999);
+  EXPECT_EQ(dst.TryGetComponent<Label>(parent)->value, "parent");
+  EXPECT_TRUE(dst.HasComponent(parent, TypeId::Of<Frozen>()));
+  EXPECT_EQ(dst.TryGetComponent<Poisoned>(child)->damage, 5);
+  ASSERT_NE(dst.TryGetSources<ChildOf>(parent), nullptr);
+
+  // Cloning again overwrites the chunks in place.
+  const auto *int32_ptr = dst.TryGetComponent<Int32>(id_array[0]);
+  manager.TryGetComponent<Int32>(id_array[0])->value = 42;
+  manager.Destroy(id_array[500]);
+  manager.RemoveComponent<Poisoned>(child);
+  ASSERT_TRUE(manager.CloneInto(dst));
+  EXPECT_EQ(dst.TryGetComponent<Int32>(id_array[0]), int32_ptr);
+  EXPECT_EQ(int32_ptr->value, 42);
+  EXPECT_FALSE(dst.Contains(id_array[500]));
+  EXPECT_EQ(dst.TryGetComponent<Poisoned>(child), nullptr);
+  EXPECT_EQ(dst.size(), manager.size());
+
+  // The clone is independent of its source.
+  dst.Destroy(parent);
+  EXPECT_TRUE(manager.Contains(parent));
+  EXPECT_TRUE(manager.HasComponent(child, TypeId::Of<Relation<ChildOf>>()));
+  EXPECT_FALSE(dst.HasComponent(child, TypeId::Of<Relation<ChildOf>>()));
+}
+
+TEST(EntityManagerTests, CloneIntoNotCloneable) {
+  EntityManager manager;
+  size_t counter = 0;
+  ComponentBundle bundle;
+  bundle.Add(DestructCounter(&counter));
+  manager.Create(bundle);
+
+  EntityManager dst;
+  const auto entity_id = CreateInt32(dst, 1);
+  EXPECT_FALSE(manager.CloneInto(dst));
+  EXPECT_TRUE(dst.Contains(entity_id));
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include "mirage_ecs/framework/hierarchy.hpp"
+#include "mirage_ecs/framework/world.hpp"
+
+using namespace mirage;
+using namespace mirage::ecs;
+
+namespace {
+
+struct Name {
+  MIRAGE_COMPONENT;
+  int32_t value;
+};
+
+EntityId Spawn(World& world, const Transform& local,
+               const EntityId& parent = {}) {
+  ComponentBundle bundle;
+  bundle.Add(local);
+  if (parent.is_valid()) {
+    bundle.Add(Relation<ChildOf>(parent));
+  }
+  return world.entity_manager().Create(bundle);
+}
+
+}  // namespace
+
+TEST(HierarchyTests, BreadthFirstLayout) {
+  World world;
+  world.AddPlugin<HierarchyPlugin>();
+  const auto root = Spawn(world, {});
+  const auto a = Spawn(world, {}, root);
+  const auto a_child = Spawn(world, {}, a);
+  const auto b = Spawn(world, {}, root);
+  ComponentBundle bundle;
+  bundle.Add(Name{.value = 0});
+  world.entity_manager().Create(bundle);
+  PropagateTransform(world);
+
+  const auto& hierarchy = world.GetResource<Hierarchy>();
+  EXPECT_EQ(hierarchy.size(), 4);
+  ASSERT_EQ(hierarchy.subtree_array().size(), 1);
+  EXPECT_EQ(hierarchy.subtree_array()[0].begin, 0);
+  EXPECT_EQ(hierarchy.subtree_array()[0].end, 4);
+  for (const auto& entity : {root, a, a_child, b}) {
+    EXPECT_NE(hierarchy.TryGetGlobal(entity), nullptr);
+  }
+}
+
+TEST(HierarchyTests, Propagate) {
+  World world;
+  world.AddPlugin<HierarchyPlugin>();
+  const auto root = Spawn(world, Transform::FromTranslation(1, 0, 0));
+  const auto child = Spawn(world, Transform::FromTranslation(0, 2, 0), root);
+  // In another archetype, so its chunk is never written.
+  ComponentBundle bundle;
+  bundle.AddMany(Transform::FromScale(2, 2, 2), Name{.value = 0});
+  world.entity_manager().Create(bundle);
+  PropagateTransform(world);
+
+  auto& hierarchy = world.GetResource<Hierarchy>();
+  EXPECT_EQ(*hierarchy.TryGetGlobal(child),
+            Transform::FromTranslation(1, 2, 0));
+  EXPECT_EQ(hierarchy.subtree_array().size(), 2);
+  for (const auto& subtree : hierarchy.subtree_array()) {
+    EXPECT_FALSE(subtree.is_dirty);
+  }
+
+  // The next update still sees what happened during the tick of this one.
+  world.IncreaseChangeTick();
+  PropagateTransform(world);
+  world.IncreaseChangeTick();
+  hierarchy.Update(world.entity_manager());
+  for (const auto& subtree : hierarchy.subtree_array()) {
+    EXPECT_FALSE(subtree.is_dirty);
+  }
+  *world.entity_manager().TryGetComponent<Transform>(root) =
+      Transform::FromTranslation(3, 0, 0);
+  hierarchy.Update(world.entity_manager());
+  size_t dirty_cnt = 0;
+  for (const auto& subtree : hierarchy.subtree_array()) {
+    dirty_cnt += subtree.is_dirty;
+  }
+  // Only the subtree holding the written chunk needs another pass.
+  EXPECT_EQ(dirty_cnt, 1);
+
+  PropagateTransform(world);
+  EXPECT_EQ(*hierarchy.TryGetGlobal(child),
+            Transform::FromTranslation(3, 2, 0));
+}
+
+TEST(HierarchyTests, Despawn) {
+  World world;
+  world.AddPlugin<HierarchyPlugin>();
+  const auto root = Spawn(world, Transform::FromTranslation(1, 0, 0));
+  const auto child = Spawn(world, Transform::FromTranslation(1, 0, 0), root);
+  const auto grandchild =
+      Spawn(world, Transform::FromTranslation(1, 0, 0), child);
+  PropagateTransform(world);
+  auto& hierarchy = world.GetResource<Hierarchy>();
+  EXPECT_EQ(*hierarchy.TryGetGlobal(grandchild),
+            Transform::FromTranslation(3, 0, 0));
+
+  // Orphans become roots.
+  world.IncreaseChangeTick();
+  world.entity_manager().Destroy(child);
+  PropagateTransform(world);
+  EXPECT_EQ(hierarchy.size(), 2);
+  EXPECT_EQ(hierarchy.subtree_array().size(), 2);
+  EXPECT_EQ(hierarchy.TryGetGlobal(child), nullptr);
+  EXPECT_EQ(*hierarchy.TryGetGlobal(grandchild),
+            Transform::FromTranslation(1, 0, 0));
+
+  // A reused index is another entity.
+  world.IncreaseChangeTick();
+  const auto reused = Spawn(world, Transform::FromTranslation(0, 5, 0), root);
+  ASSERT_EQ(reused.index(), child.index());
+  PropagateTransform(world);
+  EXPECT_EQ(hierarchy.TryGetGlobal(child), nullptr);
+  EXPECT_EQ(*hierarchy.TryGetGlobal(reused),
+            Transform::FromTranslation(1, 5, 0));
+
+  world.IncreaseChangeTick();
+  world.entity_manager().DestroyMany({root, reused, grandchild});
+  PropagateTransform(world);
+  EXPECT_EQ(hierarchy.size(), 0);
+  EXPECT_TRUE(hierarchy.subtree_array().empty());
+}
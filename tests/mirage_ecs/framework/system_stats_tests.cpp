@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "mirage_ecs/framework/system_stats.hpp"
+#include "mirage_ecs/framework/world.hpp"
+#include "mirage_ecs/system/system.hpp"
+
+using namespace mirage;
+using namespace mirage::ecs;
+
+namespace {
+
+// Stands in for a query iterator reporting what it visited.
+struct Visit {
+  SystemContext *context;
+};
+
+}  // namespace
+
+template <>
+struct mirage::ecs::Extract<Visit> {
+  static Visit From(World &, base::Owned<SystemContext> &context) {
+    return {context.raw_ptr()};
+  }
+};
+
+namespace {
+
+void VisitSystem(const Visit visit) {
+  visit.context->CountIteration(100, 2);
+  visit.context->CountStructuralChange();
+}
+
+void EmptySystem() {}
+
+}  // namespace
+
+TEST(SystemStatsTests, Record) {
+  World world;
+  auto visit_system = System::From(VisitSystem);
+  auto empty_system = System::From(EmptySystem);
+  EXPECT_NE(visit_system.id(), empty_system.id());
+
+  // Nothing is collected before the resource exists.
+  visit_system.Run(world);
+  auto &stats = world.InitResource<SystemStats>();
+  EXPECT_TRUE(stats.Summarize().empty());
+
+  visit_system.Run(world);
+  visit_system.Run(world);
+  empty_system.Run(world);
+
+  const auto summary_array = stats.Summarize();
+  ASSERT_EQ(summary_array.size(), 2);
+  EXPECT_STREQ(summary_array[0].name, visit_system.name());
+  EXPECT_EQ(summary_array[0].run_cnt, 2);
+  EXPECT_DOUBLE_EQ(summary_array[0].mean_entity_cnt, 100.0);
+  EXPECT_DOUBLE_EQ(summary_array[0].mean_chunk_cnt, 2.0);
+  // Counters restart with every run.
+  EXPECT_DOUBLE_EQ(summary_array[0].mean_structural_change_cnt, 1.0);
+  EXPECT_LE(summary_array[0].mean_run_ns, summary_array[0].max_run_ns);
+  EXPECT_STREQ(summary_array[1].name, empty_system.name());
+  EXPECT_DOUBLE_EQ(summary_array[1].mean_entity_cnt, 0.0);
+
+  const auto json = stats.DumpJson();
+  EXPECT_NE(json.find("\"run_cnt\":2"), std::string::npos);
+  EXPECT_NE(stats.DumpTable().find("changes"), std::string::npos);
+
+  stats.Reset();
+  EXPECT_TRUE(stats.Summarize().empty());
+}
+
+TEST(SystemStatsTests, Window) {
+  SystemStats stats;
+  EXPECT_TRUE(stats.Window(0).empty());
+  const size_t run_cnt = SystemStats::kWindowSize + 3;
+  for (size_t i = 0; i < run_cnt; ++i) {
+    stats.Record(0, "system", {.run_ns = i, .entity_cnt = i});
+  }
+
+  const auto sample_array = stats.Window(0);
+  ASSERT_EQ(sample_array.size(), SystemStats::kWindowSize);
+  // The oldest samples were overwritten.
+  EXPECT_EQ(sample_array[0].entity_cnt, 3);
+  EXPECT_EQ(sample_array.Tail().entity_cnt, run_cnt - 1);
+
+  const auto summary_array = stats.Summarize();
+  ASSERT_EQ(summary_array.size(), 1);
+  EXPECT_EQ(summary_array[0].run_cnt, run_cnt);
+  EXPECT_EQ(summary_array[0].sample_cnt, SystemStats::kWindowSize);
+  EXPECT_EQ(summary_array[0].max_run_ns, run_cnt - 1);
+  EXPECT_EQ(summary_array[0].mean_run_ns, (3 + run_cnt - 1) / 2);
+}
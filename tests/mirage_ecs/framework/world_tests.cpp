@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <utility>
+
+#include "mirage_ecs/framework/world.hpp"
+
+using namespace mirage::ecs;
+using namespace mirage::base;
+
+namespace {
+
+struct Gravity {
+  MIRAGE_RESOURCE;
+  float value{0.0f};
+};
+
+struct Seed {
+  MIRAGE_RESOURCE;
+  int32_t value{0};
+};
+
+template <size_t N>
+struct Filler {
+  MIRAGE_RESOURCE;
+  size_t value{N};
+};
+
+struct Health {
+  MIRAGE_COMPONENT;
+  int32_t value{0};
+};
+
+}  // namespace
+
+TEST(WorldTests, Resource) {
+  World world;
+  EXPECT_EQ(world.TryGetResource<Gravity>(), nullptr);
+  EXPECT_NE(ResourceIndexOf<Gravity>(), ResourceIndexOf<Seed>());
+  // A shared library without the cached index gets the same one.
+  EXPECT_EQ(AllocateResourceIndex(TypeId::Of<Seed>()),
+            ResourceIndexOf<Seed>());
+
+  EXPECT_FALSE(world.SetResource<Gravity>(9.8f).is_valid());
+  world.InitResource<Seed>(7);
+  // Initializing again keeps the existing value.
+  EXPECT_EQ(world.InitResource<Seed>(1).value, 7);
+
+  const auto version = world.resource_version();
+  auto old = world.SetResource<Gravity>(1.6f);
+  ASSERT_TRUE(old.is_valid());
+  EXPECT_EQ(old.Unwrap().value, 9.8f);
+  EXPECT_EQ(world.GetResource<Gravity>().value, 1.6f);
+  EXPECT_NE(world.resource_version(), version);
+
+  World other;
+  EXPECT_NE(world.id(), other.id());
+  EXPECT_EQ(other.TryGetResource<Seed>(), nullptr);
+}
+
+TEST(WorldTests, ResourceReferenceStable) {
+  World world;
+  auto& first = world.InitResource<Filler<0>>();
+
+  // Types used later get higher indices, growing the resource array.
+  [&]<size_t... kIs>(std::index_sequence<kIs...>) {
+    (world.InitResource<Filler<kIs + 1>>(), ...);
+  }(std::make_index_sequence<32>());
+  EXPECT_EQ(&first, world.TryGetResource<Filler<0>>());
+  first.value = 7;
+  EXPECT_EQ(world.GetResource<Filler<0>>().value, 7);
+  EXPECT_EQ(world.GetResource<Filler<32>>().value, 32);
+}
+
+TEST(WorldTests, ResourceBorrow) {
+  ResourceBorrow borrow;
+  EXPECT_TRUE(borrow.TryBorrowRead());
+  EXPECT_TRUE(borrow.TryBorrowRead());
+  EXPECT_EQ(borrow.reader_cnt(), 2);
+  EXPECT_FALSE(borrow.TryBorrowWrite());
+
+  borrow.ReleaseRead();
+  borrow.ReleaseRead();
+  EXPECT_TRUE(borrow.TryBorrowWrite());
+  EXPECT_FALSE(borrow.TryBorrowRead());
+  EXPECT_FALSE(borrow.TryBorrowWrite());
+  EXPECT_EQ(borrow.reader_cnt(), 0);
+
+  borrow.ReleaseWrite();
+  EXPECT_FALSE(borrow.is_writing());
+}
+
+TEST(WorldTests, Snapshot) {
+  const auto path = testing::TempDir() + "world_tests.snapshot";
+  World world;
+  ComponentBundle bundle;
+  bundle.Add(Health{.value = 10});
+  const auto entity_id = world.entity_manager().Create(bundle);
+  ASSERT_TRUE(world.SaveSnapshot(path.c_str()));
+
+  ComponentRegistry registry;
+  registry.Register<Health>();
+  World other;
+  other.IncreaseChangeTick();
+  ASSERT_TRUE(other.LoadSnapshot(path.c_str(), registry));
+  const auto *health =
+      other.entity_manager().TryGetComponent<Health>(entity_id);
+  ASSERT_NE(health, nullptr);
+  EXPECT_EQ(health->value, 10);
+  EXPECT_EQ(other.entity_manager().change_tick(), other.change_tick());
+
+  // A failed load keeps the entities.
+  EXPECT_FALSE(other.LoadSnapshot(path.c_str(), ComponentRegistry()));
+  EXPECT_TRUE(other.entity_manager().Contains(entity_id));
+  std::remove(path.c_str());
+}
+
+TEST(WorldTests, SnapshotDelta) {
+  constexpr size_t kMaxEntityCnt = 1 << 20;
+  World world;
+  Array<EntityId> id_array;
+  for (int32_t i = 0; i < 1000; ++i) {
+    ComponentBundle bundle;
+    bundle.Add(Health{.value = i});
+    id_array.Push(world.entity_manager().Create(bundle));
+  }
+  ComponentRegistry registry;
+  registry.Register<Health>();
+
+  SnapshotBaseline sent;
+  SnapshotBaseline received;
+  World replica;
+  auto delta = world.SaveSnapshotDelta(sent);
+  const auto full_size = delta.size();
+  ASSERT_TRUE(replica.ApplySnapshotDelta(received, delta.data(), delta.size(),
+                                         kMaxEntityCnt, registry));
+
+  world.IncreaseChangeTick();
+  world.entity_manager().TryGetComponent<Health>(id_array[10])->value = -1;
+  world.entity_manager().Destroy(id_array[20]);
+  ComponentBundle bundle;
+  bundle.Add(Health{.value = 7});
+  const auto spawned = world.entity_manager().Create(bundle);
+  delta = world.SaveSnapshotDelta(sent);
+  EXPECT_LT(delta.size() * 10, full_size);
+  ASSERT_TRUE(replica.ApplySnapshotDelta(received, delta.data(), delta.size(),
+                                         kMaxEntityCnt, registry));
+
+  const auto &entity_manager = replica.entity_manager();
+  EXPECT_EQ(entity_manager.size(), 1000);
+  EXPECT_EQ(entity_manager.TryGetComponent<Health>(id_array[10])->value, -1);
+  EXPECT_FALSE(entity_manager.Contains(id_array[20]));
+  EXPECT_EQ(entity_manager.TryGetComponent<Health>(spawned)->value, 7);
+  // A delta only applies to the baseline it was made against.
+  EXPECT_FALSE(replica.ApplySnapshotDelta(received, delta.data(),
+                                          delta.size(), kMaxEntityCnt,
+                                          registry));
+}
+
+TEST(WorldTests, CloneInto) {
+  World world;
+  ComponentBundle bundle;
+  bundle.Add(Health{.value = 3});
+  const auto entity_id = world.entity_manager().Create(bundle);
+  world.IncreaseChangeTick();
+
+  World rollback;
+  ASSERT_TRUE(world.CloneInto(rollback));
+  world.entity_manager().TryGetComponent<Health>(entity_id)->value = 0;
+  world.IncreaseChangeTick();
+
+  ASSERT_TRUE(rollback.CloneInto(world));
+  EXPECT_EQ(world.entity_manager().TryGetComponent<Health>(entity_id)->value,
+            3);
+  EXPECT_EQ(world.change_tick(), rollback.change_tick());
+}
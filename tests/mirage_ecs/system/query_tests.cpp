@@ -74,6 +74,18 @@ TEST(QueryTests, ExtractQuery) {
   EXPECT_TRUE(empty_without_checker);
 }
 
+TEST(QueryTests, ExtractChangeFilters) {
+  using ChangeQuery =
+      Query<Ref<const Position&>, Changed<Position>, Added<Velocity>>;
+  constexpr bool changed_checker =
+      std::same_as<ChangeQuery::ChangedTypeList, base::TypeList<Position>>;
+  constexpr bool added_checker =
+      std::same_as<ChangeQuery::AddedTypeList, base::TypeList<Velocity>>;
+  EXPECT_TRUE(IsExtractable<ChangeQuery>);
+  EXPECT_TRUE(changed_checker);
+  EXPECT_TRUE(added_checker);
+}
+
 TEST(QueryTests, ComponentList) {
   using TypeList = base::TypeList<Position, Velocity>;
   bool same_type = std::same_as<Position, TypeList::Get<0>::Type>;
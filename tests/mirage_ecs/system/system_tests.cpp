@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <future>
+#include <thread>
+
+#include "mirage_base/container/array.hpp"
+#include "mirage_base/profile/profiler.hpp"
 #include "mirage_ecs/system/resource.hpp"
 #include "mirage_ecs/system/system.hpp"
 
@@ -33,3 +39,185 @@ TEST(SystemTests, EditResource) {
   edit_num.Run(world);
   EXPECT_EQ(world.GetResource<GlobalNum>().num, 1);
 }
+
+TEST(SystemTests, LastRunTick) {
+  World world;
+  EXPECT_EQ(world.change_tick(), 1);
+
+  auto context = base::Owned<SystemContext>::New();
+  auto *context_ptr = context.raw_ptr();
+  auto system = System::From(EmptySystem, std::move(context));
+  EXPECT_EQ(context_ptr->last_run_tick(), kInitTick);
+
+  world.IncreaseChangeTick();
+  system.Run(world);
+  EXPECT_EQ(context_ptr->last_run_tick(), 1);
+}
+
+TEST(SystemTests, Name) {
+  const auto edit_num = System::From(EditNum);
+  const auto empty_system = System::From(EmptySystem);
+  EXPECT_STREQ(edit_num.name(),
+               base::TypeId::Of<decltype(&EditNum)>().type_name());
+  EXPECT_STRNE(edit_num.name(), empty_system.name());
+}
+
+#if defined(MIRAGE_BUILD_PROFILE)
+TEST(SystemTests, ProfileZone) {
+  auto edit_num = System::From(EditNum);
+  World world;
+  world.InitResource<GlobalNum>();
+  base::Profiler::Drain();
+  edit_num.Run(world);
+
+  const auto zone_array = base::Profiler::Drain();
+  ASSERT_FALSE(zone_array.empty());
+  EXPECT_EQ(zone_array.Tail().name, edit_num.name());
+}
+#endif
+
+TEST(SystemTests, ResourceCache) {
+  auto edit_num = System::From(EditNum);
+  World world;
+  world.InitResource<GlobalNum>();
+  edit_num.Run(world);
+
+  // Replacing the resource invalidates the pointer cached by the system.
+  world.SetResource<GlobalNum>(5);
+  edit_num.Run(world);
+  EXPECT_EQ(world.GetResource<GlobalNum>().num, 1);
+
+  World other;
+  other.InitResource<GlobalNum>();
+  edit_num.Run(other);
+  EXPECT_EQ(other.GetResource<GlobalNum>().num, 1);
+}
+
+namespace {
+
+struct Config {
+  MIRAGE_RESOURCE;
+  int32_t value{0};
+};
+
+struct Window {
+  MIRAGE_RESOURCE;
+  MIRAGE_NON_SEND;
+};
+
+std::atomic<int32_t> read_sum{0};
+
+void ReadConfig(const Res<const Config> config) {
+  read_sum.fetch_add(config->value, std::memory_order_relaxed);
+}
+
+void WriteConfig(const Res<Config> config) { ++config->value; }
+
+void UseWindow([[maybe_unused]] Res<Window> window) {}
+
+}  // namespace
+
+TEST(SystemTests, ResourceConflict) {
+  const auto read = System::From(ReadConfig);
+  const auto read_again = System::From(ReadConfig);
+  const auto write = System::From(WriteConfig);
+  const auto window = System::From(UseWindow);
+  const auto window_again = System::From(UseWindow);
+
+  EXPECT_FALSE(read.context().ConflictWith(read_again.context()));
+  EXPECT_TRUE(read.context().ConflictWith(write.context()));
+  EXPECT_FALSE(read.context().ConflictWith(window.context()));
+  EXPECT_FALSE(read.context().is_main_thread_only());
+  EXPECT_TRUE(window.context().is_main_thread_only());
+  EXPECT_TRUE(window.context().ConflictWith(window_again.context()));
+}
+
+TEST(SystemTests, ConcurrentResourceRead) {
+  constexpr int32_t kThreadCnt = 16;
+  constexpr int32_t kRunCnt = 1000;
+  World world;
+  world.InitResource<Config>(1);
+  auto write = System::From(WriteConfig);
+  write.Run(world);
+
+  read_sum = 0;
+  base::Array<std::thread> threads;
+  for (int32_t i = 0; i < kThreadCnt; ++i) {
+    threads.Emplace([&world] {
+      auto read = System::From(ReadConfig);
+      for (int32_t j = 0; j < kRunCnt; ++j) {
+        read.Run(world);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(read_sum, 2 * kThreadCnt * kRunCnt);
+}
+
+namespace {
+
+struct Progress {
+  MIRAGE_RESOURCE;
+  int32_t step{0};
+  bool is_ready{false};
+};
+
+SystemTask StepAcrossFrames(Res<Progress> progress) {
+  ++progress->step;
+  co_await NextFrame();
+  ++progress->step;
+  co_await WaitFrames(2);
+  ++progress->step;
+}
+
+SystemTask WaitForWork(Res<Progress> progress) {
+  co_await WaitUntil(
+      [](World &world) { return world.GetResource<Progress>().is_ready; });
+  progress->step = co_await WaitFuture(std::async([] { return 42; }));
+}
+
+}  // namespace
+
+TEST(SystemTests, CoroutineFrames) {
+  World world;
+  world.InitResource<Progress>();
+  auto system = System::From(StepAcrossFrames);
+
+  const int32_t expected_step_array[] = {1, 2, 2, 3, 4};
+  const bool expected_pending_array[] = {true, true, true, false, true};
+  for (size_t i = 0; i < std::size(expected_step_array); ++i) {
+    system.Run(world);
+    EXPECT_EQ(world.GetResource<Progress>().step, expected_step_array[i]);
+    EXPECT_EQ(system.is_pending(), expected_pending_array[i]);
+  }
+}
+
+TEST(SystemTests, CoroutineRebind) {
+  World world;
+  world.InitResource<Progress>();
+  auto system = System::From(StepAcrossFrames);
+  system.Run(world);
+
+  // Nothing is borrowed while the task is suspended, and the argument points
+  // at the new resource once it resumes.
+  world.SetResource<Progress>(10);
+  system.Run(world);
+  EXPECT_EQ(world.GetResource<Progress>().step, 11);
+}
+
+TEST(SystemTests, CoroutineWait) {
+  World world;
+  world.InitResource<Progress>();
+  auto system = System::From(WaitForWork);
+  system.Run(world);
+  system.Run(world);
+  EXPECT_TRUE(system.is_pending());
+
+  world.GetResource<Progress>().is_ready = true;
+  while (system.is_pending()) {
+    system.Run(world);
+  }
+  EXPECT_EQ(world.GetResource<Progress>().step, 42);
+}
@@ -59,3 +59,14 @@ TEST(TypeSetTests, QueryMatch) {
   EXPECT_FALSE(set.Without(with_set_fail_0));
   EXPECT_FALSE(set.Without(with_set_fail_1));
 }
+
+TEST(TypeSetTests, WithSortedPrefix) {
+  const auto set = TypeSet::New<int64_t, int32_t, bool, char>();
+
+  // The matched subset ends before the last type of the set.
+  TypeSet prefix;
+  prefix.AddTypeId(set.type_array()[0]);
+  prefix.AddTypeId(set.type_array()[1]);
+  EXPECT_TRUE(set.With(prefix));
+  EXPECT_FALSE(set.Without(prefix));
+}
@@ -38,11 +38,40 @@ option("mirage_split")
   end)
 option_end()
 
+option("mirage_lock_stats")
+  set_description("Collect contention statistics of named locks")
+  set_default(false)
+  add_defines("MIRAGE_BUILD_LOCK_STATS")
+option_end()
+add_options("mirage_lock_stats")
+
+option("mirage_profile")
+  set_description("Record frame profiler zones")
+  set_default(false)
+  add_defines("MIRAGE_BUILD_PROFILE")
+option_end()
+add_options("mirage_profile")
+
+option("mirage_alloc_tracking")
+  set_description("Record heap allocations of the engine containers")
+  set_default(false)
+  add_defines("MIRAGE_BUILD_ALLOC_TRACKING")
+option_end()
+add_options("mirage_alloc_tracking")
+
+option("mirage_benchmarks")
+  set_description("Build mirage engine benchmarks")
+  set_default(false)
+option_end()
+
 add_includedirs("libs")
 
 includes("libs/mirage_base")
 includes("libs/mirage_ecs")
 includes("tests")
+if has_config("mirage_benchmarks") then
+  includes("benchmarks")
+end
 
 if is_config("mirage_split", false) then
   target("mirage_engine")